@@ -95,6 +95,10 @@ class ProcessGroup {
         GetBackendName()));
   }
 
+  // Whether AllReduce with sync_op false is implemented and returns before
+  // the reduction is done, leaving it to Task::Wait.
+  virtual bool SupportsAsyncAllReduce() const { return false; }
+
   // TODO(liyurui): This API will be moved later
   virtual std::shared_ptr<ProcessGroup::Task> AllReduce(
       std::vector<phi::DenseTensor>& /* input tensors */,   // NOLINT
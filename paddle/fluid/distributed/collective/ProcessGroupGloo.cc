@@ -33,6 +33,8 @@
 #include "paddle/fluid/framework/fleet/gloo_wrapper.h"
 #include "paddle/fluid/platform/enforce.h"
 
+DECLARE_int64(gloo_allreduce_ring_min_bytes);
+
 namespace paddle {
 namespace distributed {
 
@@ -176,6 +178,46 @@ ProcessGroupGloo::GlooTask::GlooTask(
     int rank, const std::vector<phi::DenseTensor>& inputs, CommType comm_type)
     : ProcessGroup::Task(rank, inputs, comm_type) {}
 
+ProcessGroupGloo::GlooTask::GlooTask(
+    int rank,
+    const std::vector<phi::DenseTensor>& inputs,
+    CommType comm_type,
+    bool sync_op)
+    : ProcessGroup::Task(rank, inputs, comm_type, sync_op) {}
+
+void ProcessGroupGloo::GlooTask::RunAndNotify() {
+  std::exception_ptr exception;
+  try {
+    Run();
+  } catch (...) {
+    exception = std::current_exception();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exception_ = exception;
+    is_completed_ = true;
+  }
+  cv_.notify_all();
+}
+
+bool ProcessGroupGloo::GlooTask::Wait(std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (timeout == kWaitTimeout) {
+    cv_.wait(lock, [this] { return is_completed_; });
+  } else if (!cv_.wait_for(lock, timeout, [this] { return is_completed_; })) {
+    return false;
+  }
+  if (exception_) {
+    std::rethrow_exception(exception_);
+  }
+  return true;
+}
+
+bool ProcessGroupGloo::GlooTask::IsCompleted() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return is_completed_;
+}
+
 ProcessGroupGloo::ProcessGroupGloo(
     const std::shared_ptr<distributed::Store>& store,
     int rank,
@@ -190,6 +232,49 @@ ProcessGroupGloo::ProcessGroupGloo(
   auto prefix_store =
       ::gloo::rendezvous::PrefixStore(std::to_string(gid), *_store);
   _context->connectFullMesh(prefix_store, options->device);
+  _async_thread = std::thread(&ProcessGroupGloo::AsyncLoop, this);
+}
+
+ProcessGroupGloo::~ProcessGroupGloo() {
+  {
+    std::lock_guard<std::mutex> lock(_async_mutex);
+    _async_stop = true;
+  }
+  _async_cv.notify_all();
+  if (_async_thread.joinable()) {
+    _async_thread.join();
+  }
+}
+
+void ProcessGroupGloo::AsyncLoop() {
+  while (true) {
+    std::shared_ptr<GlooTask> task;
+    {
+      std::unique_lock<std::mutex> lock(_async_mutex);
+      _async_cv.wait(lock,
+                     [this] { return _async_stop || !_async_tasks.empty(); });
+      // the queue is drained before stopping, no issued task is dropped
+      if (_async_tasks.empty()) {
+        return;
+      }
+      task = std::move(_async_tasks.front());
+      _async_tasks.pop_front();
+    }
+    task->RunAndNotify();
+  }
+}
+
+std::shared_ptr<ProcessGroupGloo::GlooTask> ProcessGroupGloo::RunTask(
+    std::shared_ptr<GlooTask> task, bool sync_op) {
+  {
+    std::lock_guard<std::mutex> lock(_async_mutex);
+    _async_tasks.push_back(task);
+  }
+  _async_cv.notify_one();
+  if (sync_op) {
+    task->Wait();
+  }
+  return task;
 }
 
 class BroadcastGlooTask : public ProcessGroupGloo::GlooTask {
@@ -234,13 +319,12 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupGloo::Broadcast(
     std::vector<phi::DenseTensor>& outputs,
     const BroadcastOptions& opts) {
   auto root = opts.source_rank;
-  std::unique_ptr<BroadcastGlooTask> task;
+  std::shared_ptr<BroadcastGlooTask> task;
   auto tag = next_tag();
   auto context = get_context();
-  task = std::make_unique<BroadcastGlooTask>(
+  task = std::make_shared<BroadcastGlooTask>(
       context, inputs, outputs, rank_, root, tag);
-  task->Run();
-  return task;
+  return RunTask(task, true);
 }
 
 class AllreduceGlooTask : public ProcessGroupGloo::GlooTask {
@@ -250,8 +334,9 @@ class AllreduceGlooTask : public ProcessGroupGloo::GlooTask {
                     std::vector<phi::DenseTensor>& inputs,   // NOLINT
                     std::vector<phi::DenseTensor>& outputs,  // NOLINT
                     ReduceOp reduce_op,
-                    uint32_t tag)
-      : ProcessGroupGloo::GlooTask(rank, inputs, CommType::ALLREDUCE),
+                    uint32_t tag,
+                    bool sync_op)
+      : ProcessGroupGloo::GlooTask(rank, inputs, CommType::ALLREDUCE, sync_op),
         _context(context),
         _inputs(inputs),
         _outputs(outputs),
@@ -274,6 +359,24 @@ class AllreduceGlooTask : public ProcessGroupGloo::GlooTask {
     return fn;
   }
 
+  // Small messages are latency bound: halving-doubling (bcube with a base
+  // of 2) needs log2(n) steps where the ring needs 2 * (n - 1). Large
+  // messages are bandwidth bound and go through the ring. Bcube only splits
+  // evenly when the group size is a power of two.
+  gloo::AllreduceOptions::Algorithm _get_algorithm(
+      const std::vector<phi::DenseTensor>& ins) {
+    int64_t bytes = 0;
+    for (auto& in : ins) {
+      bytes += in.numel() * experimental::SizeOf(in.dtype());
+    }
+    const int size = _context->size;
+    const bool power_of_two = (size & (size - 1)) == 0;
+    if (power_of_two && bytes < FLAGS_gloo_allreduce_ring_min_bytes) {
+      return gloo::AllreduceOptions::Algorithm::BCUBE;
+    }
+    return gloo::AllreduceOptions::Algorithm::RING;
+  }
+
   template <typename T>
   void _get_function_impl(gloo::AllreduceOptions::Func& fn,  // NOLINT
                           const ReduceOp op) {
@@ -287,6 +390,7 @@ class AllreduceGlooTask : public ProcessGroupGloo::GlooTask {
     GENERATE_FUNC(dtype, set_inputs, opts, ins);
     GENERATE_FUNC(dtype, set_outputs, opts, outs);
     opts.setReduceFunction(_get_function(dtype, _reduce_op));
+    opts.setAlgorithm(_get_algorithm(ins));
     opts.setTag(_tag);
     gloo::allreduce(opts);
   }
@@ -308,9 +412,8 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupGloo::AllReduce(
   std::shared_ptr<GlooTask> task;
   auto context = get_context();
   task = std::make_shared<AllreduceGlooTask>(
-      rank_, context, inputs, outputs, opts.reduce_op, tag);
-  task->Run();
-  return task;
+      rank_, context, inputs, outputs, opts.reduce_op, tag, sync_op);
+  return RunTask(task, sync_op);
 }
 
 class BarrierGlooTask : public ProcessGroupGloo::GlooTask {
@@ -336,8 +439,7 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupGloo::Barrier(
   std::shared_ptr<BarrierGlooTask> task;
   auto context = get_context();
   task = std::make_shared<BarrierGlooTask>(rank_, context);
-  task->Run();
-  return task;
+  return RunTask(task, true);
 }
 
 class AllgatherGlooTask : public ProcessGroupGloo::GlooTask {
@@ -380,8 +482,7 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupGloo::AllGather(
   auto context = get_context();
   task = std::make_shared<AllgatherGlooTask>(
       rank_, context, in_tensors, out_tensors, tag);
-  task->Run();
-  return task;
+  return RunTask(task, true);
 }
 
 class ReduceGlooTask : public ProcessGroupGloo::GlooTask {
@@ -447,8 +548,7 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupGloo::Reduce(
   auto context = get_context();
   task = std::make_shared<ReduceGlooTask>(
       rank_, context, inputs, outputs, opts.reduce_op, opts.root_rank, tag);
-  task->Run();
-  return task;
+  return RunTask(task, true);
 }
 
 class ScatterGlooTask : public ProcessGroupGloo::GlooTask {
@@ -502,8 +602,7 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupGloo::Scatter(
   auto context = get_context();
   task = std::make_shared<ScatterGlooTask>(
       rank_, context, in_tensors, out_tensors, opts.root_rank, size_, tag);
-  task->Run();
-  return task;
+  return RunTask(task, true);
 }
 
 std::shared_ptr<::gloo::transport::Device>
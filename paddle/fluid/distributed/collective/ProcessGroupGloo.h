@@ -14,8 +14,12 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <future>
 #include <mutex>
+#include <thread>
 
 #include "paddle/fluid/distributed/collective/ProcessGroup.h"
 
@@ -39,16 +43,28 @@ class ProcessGroupGloo : public ProcessGroup {
     explicit GlooTask(int rank,
                       const std::vector<phi::DenseTensor>& input_tensors,
                       CommType comm_type);
+    GlooTask(int rank,
+             const std::vector<phi::DenseTensor>& input_tensors,
+             CommType comm_type,
+             bool sync_op);
 
     ~GlooTask() = default;
 
     virtual void Run() = 0;
-    bool Wait(std::chrono::milliseconds timeout) override { return true; }
-    bool IsCompleted() override { return true; }
-    void Synchronize() override {}
+    // Runs the collective and marks the task completed. An exception thrown
+    // by Run is kept and rethrown by Wait.
+    void RunAndNotify();
+    // a zero timeout waits until the task is completed
+    bool Wait(std::chrono::milliseconds timeout = kWaitTimeout) override;
+    bool IsCompleted() override;
+    void Synchronize() override { Wait(kWaitTimeout); }
 
    protected:
     friend class ProcessGroupGloo;
+
+   private:
+    std::condition_variable cv_;
+    std::exception_ptr exception_;
   };
 
   class GlooStore : public ::gloo::rendezvous::Store {
@@ -66,9 +82,7 @@ class ProcessGroupGloo : public ProcessGroup {
 
     void wait(const std::vector<std::string>& keys) override {
       VLOG(3) << "GlooStore::wait";
-      for (auto& key : keys) {
-        _store->wait(key);
-      }
+      _store->multi_wait(keys);
     }
 
     void set(const std::string& key, const std::vector<char>& value) override {
@@ -80,10 +94,7 @@ class ProcessGroupGloo : public ProcessGroup {
     void wait(const std::vector<std::string>& keys,
               const std::chrono::milliseconds& timeout) override {
       VLOG(3) << "GlooStore::wait";
-      for (auto& key : keys) {
-        _store->wait(key);
-      }
-      // wait(keys);
+      _store->multi_wait(keys);
     }
 
    protected:
@@ -108,7 +119,7 @@ class ProcessGroupGloo : public ProcessGroup {
       int gid,
       std::shared_ptr<GlooOptions> options);
 
-  ~ProcessGroupGloo() = default;
+  ~ProcessGroupGloo();
 
   std::shared_ptr<ProcessGroup::Task> Broadcast(
       std::vector<phi::DenseTensor>& inputs,
@@ -126,6 +137,8 @@ class ProcessGroupGloo : public ProcessGroup {
       const AllreduceOptions& opts,
       bool sync_op) override;
 
+  bool SupportsAsyncAllReduce() const override { return true; }
+
   std::shared_ptr<ProcessGroup::Task> Barrier(
       const BarrierOptions& = BarrierOptions()) override;
 
@@ -158,9 +171,23 @@ class ProcessGroupGloo : public ProcessGroup {
   static std::shared_ptr<::gloo::transport::Device> createDefaultDevice();
 
  protected:
+  // All collectives of the group run on one background thread in the order
+  // they are issued, so the gloo context is never used by two threads at
+  // once. A sync task is waited for before it is returned; an async task
+  // lets the caller go on, e.g. with the backward pass.
+  std::shared_ptr<GlooTask> RunTask(std::shared_ptr<GlooTask> task,
+                                    bool sync_op);
+  void AsyncLoop();
+
   uint32_t _tag;
   std::shared_ptr<gloo::rendezvous::Context> _context;
   std::shared_ptr<::gloo::rendezvous::Store> _store;
+
+  std::mutex _async_mutex;
+  std::condition_variable _async_cv;
+  std::deque<std::shared_ptr<GlooTask>> _async_tasks;
+  bool _async_stop{false};
+  std::thread _async_thread;
 };
 
 }  // namespace distributed
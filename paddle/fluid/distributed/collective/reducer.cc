@@ -952,7 +952,13 @@ void EagerReducer::FusedAllReduceSchedule(EagerGroup *group,
   for (auto &t : reduce_tensors) {
     in_out.push_back(*std::dynamic_pointer_cast<phi::DenseTensor>(t.impl()));
   }
-  group->task = process_group_->AllReduce(in_out, in_out, opts);
+  if (process_group_->SupportsAsyncAllReduce()) {
+    // e.g. gloo runs the allreduce on its own thread, so the buckets of the
+    // earlier groups are reduced while backward goes on with the next ones
+    group->task = process_group_->AllReduce(in_out, in_out, opts, false);
+  } else {
+    group->task = process_group_->AllReduce(in_out, in_out, opts);
+  }
 
   // split in FinalizeBackward()
 }
@@ -26,6 +26,16 @@
 #include "paddle/fluid/framework/scope.h"
 #include "paddle/fluid/framework/variable_helper.h"
 
+PADDLE_DEFINE_EXPORTED_int32(fleet_executor_thread_num,
+                             1,
+                             "Number of threads that run the interceptors of "
+                             "one carrier.");
+PADDLE_DEFINE_EXPORTED_bool(
+    fleet_executor_work_stealing,
+    false,
+    "Let idle carrier threads steal interceptor tasks from busy ones instead "
+    "of pinning each interceptor to one thread.");
+
 namespace paddle {
 namespace distributed {
 
@@ -40,9 +50,9 @@ void Carrier::Init(
   rank_ = rank;
   interceptor_id_to_rank_ = interceptor_id_to_rank;
 
-  // TODO(fleet_exe dev): thread pool
-  thread_num_ = 1;
+  thread_num_ = FLAGS_fleet_executor_thread_num;
   thread_pool_.SetThreadNum(thread_num_);
+  thread_pool_.SetWorkStealing(FLAGS_fleet_executor_work_stealing);
   thread_pool_.Start();
 }
 
@@ -72,9 +82,9 @@ void Carrier::Init(
     CopyParameters(i, program, inference_root_scope_vars);
   }
 
-  // TODO(fleet_exe dev): thread pool
-  thread_num_ = 1;
+  thread_num_ = FLAGS_fleet_executor_thread_num;
   thread_pool_.SetThreadNum(thread_num_);
+  thread_pool_.SetWorkStealing(FLAGS_fleet_executor_work_stealing);
   thread_pool_.Start();
 
   CreateInterceptors();
@@ -144,6 +154,18 @@ Interceptor* Carrier::GetInterceptor(int64_t interceptor_id) {
   return iter->second.get();
 }
 
+framework::Scope* Carrier::GetMicroBatchScope(int64_t microbatch_id) const {
+  PADDLE_ENFORCE_LT(
+      microbatch_id,
+      static_cast<int64_t>(microbatch_scopes_.size()),
+      platform::errors::InvalidArgument(
+          "Micro batch id %lld is out of range, the carrier has %d micro "
+          "batch scopes.",
+          microbatch_id,
+          microbatch_scopes_.size()));
+  return microbatch_scopes_[microbatch_id];
+}
+
 void Carrier::Wait() {
   std::unique_lock<std::mutex> lock(running_mutex_);
   cond_var_.wait(lock);
@@ -235,11 +257,7 @@ Interceptor* Carrier::SetInterceptor(int64_t interceptor_id,
                         interceptor_id));
   interceptor->RegisterCarrier(this);
 
-  // TODO(fleet_exe dev): get loop
-  auto* loop = thread_pool_.GetLoop(interceptor_id % thread_num_);
-  PADDLE_ENFORCE_NOT_NULL(
-      loop, platform::errors::Fatal("thread task loop must not null"));
-  interceptor->RegisterTaskLoop(loop);
+  interceptor->RegisterThreadPool(&thread_pool_);
 
   auto* ptr = interceptor.get();
   interceptor_idx_to_interceptor_.insert(
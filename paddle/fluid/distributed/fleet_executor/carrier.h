@@ -77,6 +77,9 @@ class Carrier final {
   // get interceptor based on the interceptor id
   Interceptor* GetInterceptor(int64_t interceptor_id);
 
+  // the scope the micro batch microbatch_id runs in
+  framework::Scope* GetMicroBatchScope(int64_t microbatch_id) const;
+
   // set interceptor with interceptor id
   Interceptor* SetInterceptor(int64_t interceptor_id,
                               std::unique_ptr<Interceptor>);
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <utility>
 
 #include "paddle/fluid/distributed/fleet_executor/interceptor.h"
@@ -25,6 +26,9 @@ class ComputeInterceptor : public Interceptor {
  public:
   ComputeInterceptor(int64_t interceptor_id, TaskNode* node);
 
+  // the accumulated host time spent in RunOps, can be read from any thread
+  int64_t BusyTimeUs() const { return busy_us_; }
+
  protected:
   virtual void RunOps();
   virtual void SendDataReadyToDownStream();
@@ -56,6 +60,8 @@ class ComputeInterceptor : public Interceptor {
 
   bool received_stop_{false};
   std::map<int64_t, bool> in_stops_{};
+
+  std::atomic<int64_t> busy_us_{0};
 };
 
 }  // namespace distributed
@@ -16,9 +16,14 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <chrono>  // NOLINT
+#include <sstream>
 
+#include "paddle/fluid/distributed/fleet_executor/carrier.h"
+#include "paddle/fluid/distributed/fleet_executor/compute_interceptor.h"
 #include "paddle/fluid/distributed/fleet_executor/fleet_executor.h"
+#include "paddle/fluid/distributed/fleet_executor/global.h"
 #include "paddle/fluid/distributed/fleet_executor/task_node.h"
 #include "paddle/fluid/framework/block_desc.h"
 #include "paddle/fluid/framework/feed_fetch_method.h"
@@ -507,39 +512,57 @@ bool DistModel::PrepareFeedAndFetch() {
 bool DistModel::FeedData(const std::vector<DistModelTensor> &input_data,
                          framework::Scope *scope) {
   VLOG(3) << "DistModel is feeding data.";
+  if (!PrepareFeedTensors(input_data, &feed_tensors_)) {
+    return false;
+  }
+  SetFeedTensors(feed_tensors_, scope);
+  return true;
+}
+
+bool DistModel::PrepareFeedTensors(
+    const std::vector<DistModelTensor> &input_data,
+    std::vector<framework::LoDTensor> *feed_tensors) {
   if (input_data.size() != feeds_.size()) {
     LOG(ERROR) << "Should provide " << feeds_.size() << " feeds, but got "
                << input_data.size() << " data.";
     return false;
   }
-  feed_tensors_.resize(feeds_.size());
+  feed_tensors->resize(feeds_.size());
   for (size_t i = 0; i < input_data.size(); ++i) {
-    // feed each data separately
-    framework::LoDTensor *input_tensor = &(feed_tensors_[i]);
-    if (!LoadDataFromDistModelTensor(input_data[i], input_tensor, place_)) {
-      LOG(ERROR) << "Fail to load data from tensor " << input_data[i].name;
-      return false;
-    }
     std::string target_name = input_data[i].name;
-    if (feed_names_.find(target_name) == feed_names_.end()) {
+    auto feed_iter = feed_names_.find(target_name);
+    if (feed_iter == feed_names_.end()) {
       LOG(ERROR) << "The input name [" << target_name
                  << "] cannot be found in the program."
                  << " DistModel loads data failed.";
       return false;
     }
-    if (input_data[i].dtype != feeds_to_dtype_[target_name]) {
+    DistModelDataType dtype = feeds_to_dtype_.at(target_name);
+    if (input_data[i].dtype != dtype) {
       LOG(ERROR) << "Feed var [" << target_name << "] expected dtype is: "
-                 << DistModelDTypeToString(feeds_to_dtype_[target_name])
+                 << DistModelDTypeToString(dtype)
                  << ". But received dtype is: "
                  << DistModelDTypeToString(input_data[i].dtype) << ".";
       return false;
     }
-    int feed_idx = feed_names_[target_name];
-    framework::SetFeedVariable(scope, *input_tensor, "feed", feed_idx);
+    // feed tensors are kept in the order of the feed ops' col
+    framework::LoDTensor *input_tensor = &(feed_tensors->at(feed_iter->second));
+    if (!LoadDataFromDistModelTensor(input_data[i], input_tensor, place_)) {
+      LOG(ERROR) << "Fail to load data from tensor " << input_data[i].name;
+      return false;
+    }
   }
   return true;
 }
 
+void DistModel::SetFeedTensors(
+    const std::vector<framework::LoDTensor> &feed_tensors,
+    framework::Scope *scope) {
+  for (size_t i = 0; i < feed_tensors.size(); ++i) {
+    framework::SetFeedVariable(scope, feed_tensors[i], "feed", i);
+  }
+}
+
 bool DistModel::FetchResults(std::vector<DistModelTensor> *output_data,
                              framework::Scope *scope) {
   VLOG(3) << "DistModel is fetch results.";
@@ -606,6 +629,10 @@ bool DistModel::FetchResult(const framework::LoDTensor &fetch,
 bool DistModel::Run(const std::vector<DistModelTensor> &input_data,
                     std::vector<DistModelTensor> *output_data) {
   VLOG(3) << "DistModel run for once.";
+  if (serving_) {
+    LOG(ERROR) << "DistModel is serving, use RunAsync instead of Run.";
+    return false;
+  }
 
   DistModelTimer timer;
   timer.tic();
@@ -649,5 +676,193 @@ bool DistModel::Run(const std::vector<DistModelTensor> &input_data,
   return true;
 }
 
+bool DistModel::StartServing(int max_in_flight) {
+  if (serving_) {
+    LOG(ERROR) << "DistModel is already serving.";
+    return false;
+  }
+  if (max_in_flight < 1) {
+    LOG(ERROR) << "DistModel serving needs max_in_flight >= 1, but got "
+               << max_in_flight << ".";
+    return false;
+  }
+  if (!PrepareServingCarrier(max_in_flight)) {
+    return false;
+  }
+  run_chan_ =
+      framework::MakeChannel<std::shared_ptr<ServingTask>>(max_in_flight);
+  callback_chan_ =
+      framework::MakeChannel<std::shared_ptr<ServingTask>>(max_in_flight);
+  finished_num_ = 0;
+  feed_us_ = 0;
+  run_us_ = 0;
+  callback_us_ = 0;
+  serving_busy_start_us_ = ServingBusyTimeUs();
+  serving_start_ = std::chrono::steady_clock::now();
+  serving_ = true;
+  run_thread_ = std::thread(&DistModel::ServingRunLoop, this);
+  callback_thread_ = std::thread(&DistModel::ServingCallbackLoop, this);
+  VLOG(3) << "DistModel starts serving with " << max_in_flight
+          << " requests in flight.";
+  return true;
+}
+
+bool DistModel::PrepareServingCarrier(int max_in_flight) {
+  if (serving_task_node_) {
+    if (serving_window_ != max_in_flight) {
+      LOG(ERROR) << "DistModel has served with max_in_flight "
+                 << serving_window_ << ", it can't be changed to "
+                 << max_in_flight << ".";
+      return false;
+    }
+    return true;
+  }
+  // The serving carrier runs every request as one micro batch, a carrier run
+  // takes a window of max_in_flight requests.
+  serving_task_node_.reset(new TaskNode(program_.get(),
+                                        config_.local_rank,
+                                        config_.local_rank,
+                                        max_in_flight,
+                                        max_in_flight));
+  serving_task_node_->SetType("Compute");
+  serving_carrier_id_ = carrier_id_ + "_serving";
+  std::unordered_map<int64_t, int64_t> id_to_rank;
+  for (int i = 0; i < config_.nranks; ++i) {
+    id_to_rank.insert({i, i});
+  }
+  fleet_exe->Init(serving_carrier_id_,
+                  *(program_.get()),
+                  scope_.get(),
+                  place_,
+                  max_in_flight,
+                  {serving_task_node_.get()},
+                  id_to_rank);
+  Carrier *carrier = GlobalMap<std::string, Carrier>::Get(serving_carrier_id_);
+  for (int64_t i = 0; i < max_in_flight; ++i) {
+    // feed and fetch live in the root scope, shadow them in every micro batch
+    // scope to keep the requests of one window apart
+    framework::Scope *micro_scope = carrier->GetMicroBatchScope(i);
+    micro_scope->Var("feed")->GetMutable<framework::FeedList>();
+    micro_scope->Var("fetch")->GetMutable<framework::FetchList>();
+  }
+  serving_window_ = max_in_flight;
+  return true;
+}
+
+bool DistModel::RunAsync(const std::vector<DistModelTensor> &input_data,
+                         DistModelCallback callback) {
+  if (!serving_) {
+    LOG(ERROR) << "DistModel is not serving, call StartServing first.";
+    return false;
+  }
+  DistModelTimer timer;
+  timer.tic();
+  auto task = std::make_shared<ServingTask>();
+  if (!PrepareFeedTensors(input_data, &task->feed_tensors)) {
+    LOG(ERROR) << "DistModel failed at feeding data.";
+    return false;
+  }
+  task->callback = std::move(callback);
+  feed_us_ += static_cast<int64_t>(timer.toc() * 1000);
+  // blocks while max_in_flight requests are waiting for the run stage
+  return run_chan_->Put(std::move(task));
+}
+
+void DistModel::ServingRunLoop() {
+  DistModelTimer timer;
+  Carrier *carrier = GlobalMap<std::string, Carrier>::Get(serving_carrier_id_);
+  std::vector<std::shared_ptr<ServingTask>> window;
+  while (run_chan_->ReadOnce(window, serving_window_) > 0) {
+    timer.tic();
+    // The carrier always runs serving_window_ micro batches, the spare ones
+    // of a partial window rerun the last request and their results are
+    // dropped.
+    for (int64_t i = 0; i < serving_window_; ++i) {
+      size_t idx = std::min(static_cast<size_t>(i), window.size() - 1);
+      SetFeedTensors(window[idx]->feed_tensors, carrier->GetMicroBatchScope(i));
+    }
+    fleet_exe->Run(serving_carrier_id_);
+    for (size_t i = 0; i < window.size(); ++i) {
+      auto &task = window[i];
+      task->status =
+          FetchResults(&task->output_data, carrier->GetMicroBatchScope(i));
+      task->feed_tensors.clear();
+    }
+    run_us_ += static_cast<int64_t>(timer.toc() * 1000);
+    for (auto &task : window) {
+      callback_chan_->Put(std::move(task));
+    }
+  }
+  callback_chan_->Close();
+}
+
+void DistModel::ServingCallbackLoop() {
+  DistModelTimer timer;
+  std::shared_ptr<ServingTask> task;
+  while (callback_chan_->Get(task)) {
+    timer.tic();
+    if (!task->status) {
+      LOG(ERROR) << "DistModel failed at fetching result.";
+    }
+    if (task->callback) {
+      task->callback(task->status, &task->output_data);
+    }
+    callback_us_ += static_cast<int64_t>(timer.toc() * 1000);
+    ++finished_num_;
+    task.reset();
+  }
+}
+
+void DistModel::StopServing() {
+  if (!serving_.exchange(false)) {
+    return;
+  }
+  run_chan_->Close();
+  run_thread_.join();
+  callback_thread_.join();
+  DistModelServingStats stats = GetServingStats();
+  std::stringstream ss;
+  for (auto &busy : stats.interceptor_busy_ms) {
+    ss << ", interceptor " << busy.first << " " << busy.second / stats.wall_ms;
+  }
+  LOG(INFO) << "DistModel finishes serving " << stats.finished_num
+            << " requests in " << stats.wall_ms << "ms, stage occupancy: feed "
+            << stats.feed_ms / stats.wall_ms << ", run "
+            << stats.run_ms / stats.wall_ms << ", callback "
+            << stats.callback_ms / stats.wall_ms << ss.str() << ".";
+}
+
+DistModelServingStats DistModel::GetServingStats() const {
+  DistModelServingStats stats;
+  std::chrono::duration<double, std::milli> wall =
+      std::chrono::steady_clock::now() - serving_start_;
+  stats.finished_num = finished_num_;
+  stats.wall_ms = wall.count();
+  stats.feed_ms = feed_us_ / 1000.0;
+  stats.run_ms = run_us_ / 1000.0;
+  stats.callback_ms = callback_us_ / 1000.0;
+  for (auto &busy : ServingBusyTimeUs()) {
+    auto start = serving_busy_start_us_.find(busy.first);
+    int64_t start_us =
+        start == serving_busy_start_us_.end() ? 0 : start->second;
+    stats.interceptor_busy_ms[busy.first] = (busy.second - start_us) / 1000.0;
+  }
+  return stats;
+}
+
+std::map<int64_t, int64_t> DistModel::ServingBusyTimeUs() const {
+  std::map<int64_t, int64_t> busy_us;
+  if (!serving_task_node_) {
+    return busy_us;
+  }
+  Carrier *carrier = GlobalMap<std::string, Carrier>::Get(serving_carrier_id_);
+  auto *interceptor = dynamic_cast<ComputeInterceptor *>(
+      carrier->GetInterceptor(serving_task_node_->task_id()));
+  if (interceptor) {
+    busy_us[interceptor->GetInterceptorId()] = interceptor->BusyTimeUs();
+  }
+  return busy_us;
+}
+
 }  // namespace distributed
 }  // namespace paddle
@@ -13,13 +13,18 @@
 // limitations under the License.
 
 #pragma once
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "paddle/fluid/distributed/fleet_executor/dist_model_tensor_wrapper.h"
 #include "paddle/fluid/distributed/fleet_executor/fleet_executor_desc.pb.h"
+#include "paddle/fluid/framework/channel.h"
 #include "paddle/fluid/framework/lod_tensor.h"
 #include "paddle/fluid/framework/tensor.h"
 #include "paddle/fluid/platform/macros.h"
@@ -53,17 +58,61 @@ struct DistModelConfig {
   std::map<int64_t, std::vector<int64_t>> rank_to_ring_ids_{};
 };
 
+// called with the run status and the outputs of one RunAsync request
+using DistModelCallback =
+    std::function<void(bool, std::vector<DistModelTensor>*)>;
+
+// accumulated busy time of each serving stage, divide by wall_ms to get the
+// occupancy of the stage
+struct DistModelServingStats {
+  int64_t finished_num{0};
+  double wall_ms{0};
+  double feed_ms{0};
+  double run_ms{0};
+  double callback_ms{0};
+  // interceptor id --> time the ComputeInterceptor spent running ops
+  std::map<int64_t, double> interceptor_busy_ms{};
+};
+
 class DistModel {
  public:
   explicit DistModel(const DistModelConfig& config) : config_(config) {}
   bool Init();
   bool Run(const std::vector<DistModelTensor>& input_data,
            std::vector<DistModelTensor>* output_data);
-  ~DistModel() = default;
+
+  // Serving mode: the requests flow through three stages running
+  // concurrently, converting the inputs (caller thread), running the fleet
+  // executor and fetching (run thread), and the callbacks (callback thread).
+  // The run thread takes up to max_in_flight queued requests as the micro
+  // batches of one carrier run, so the compute interceptors stream them
+  // back to back and the device is synchronized once per window instead of
+  // once per request. At most max_in_flight requests are queued between the
+  // stages, RunAsync blocks when the window is full. Every rank must start
+  // serving with the same max_in_flight, which can't change afterwards.
+  bool StartServing(int max_in_flight);
+  bool RunAsync(const std::vector<DistModelTensor>& input_data,
+                DistModelCallback callback);
+  // waits for the queued requests to finish
+  void StopServing();
+  DistModelServingStats GetServingStats() const;
+
+  ~DistModel() { StopServing(); }
 
  private:
   DISABLE_COPY_AND_ASSIGN(DistModel);
 
+  struct ServingTask {
+    std::vector<framework::LoDTensor> feed_tensors;
+    std::vector<DistModelTensor> output_data;
+    DistModelCallback callback;
+    bool status{false};
+  };
+  bool PrepareServingCarrier(int max_in_flight);
+  void ServingRunLoop();
+  void ServingCallbackLoop();
+  std::map<int64_t, int64_t> ServingBusyTimeUs() const;
+
   bool PrepareScope();
   bool PrepareProgram();
   bool LoadProgram();
@@ -80,6 +129,10 @@ class DistModel {
                     int ring_id);
   bool FeedData(const std::vector<DistModelTensor>& input_data,
                 framework::Scope* scope);
+  bool PrepareFeedTensors(const std::vector<DistModelTensor>& input_data,
+                          std::vector<framework::LoDTensor>* feed_tensors);
+  void SetFeedTensors(const std::vector<framework::LoDTensor>& feed_tensors,
+                      framework::Scope* scope);
   bool FetchResults(std::vector<DistModelTensor>* output_data,
                     framework::Scope* scope);
   template <typename T>
@@ -101,6 +154,22 @@ class DistModel {
   std::shared_ptr<framework::Scope> scope_;
   paddle::platform::Place place_;
   std::shared_ptr<framework::ProgramDesc> program_;
+
+  // serving mode
+  std::atomic<bool> serving_{false};
+  std::string serving_carrier_id_;
+  std::shared_ptr<TaskNode> serving_task_node_;
+  int64_t serving_window_{0};
+  std::map<int64_t, int64_t> serving_busy_start_us_;
+  framework::Channel<std::shared_ptr<ServingTask>> run_chan_;
+  framework::Channel<std::shared_ptr<ServingTask>> callback_chan_;
+  std::thread run_thread_;
+  std::thread callback_thread_;
+  std::chrono::steady_clock::time_point serving_start_;
+  std::atomic<int64_t> finished_num_{0};
+  std::atomic<int64_t> feed_us_{0};
+  std::atomic<int64_t> run_us_{0};
+  std::atomic<int64_t> callback_us_{0};
 };
 
 }  // namespace distributed
@@ -14,8 +14,10 @@
 
 #include "paddle/fluid/distributed/fleet_executor/interceptor.h"
 
+#include <algorithm>
+
 #include "paddle/fluid/distributed/fleet_executor/carrier.h"
-#include "paddle/fluid/distributed/fleet_executor/task_loop.h"
+#include "paddle/fluid/distributed/fleet_executor/task_loop_thread_pool.h"
 #include "paddle/fluid/distributed/fleet_executor/task_node.h"
 
 namespace paddle {
@@ -25,6 +27,8 @@ Interceptor::Interceptor(int64_t interceptor_id, TaskNode* node)
     : interceptor_id_(interceptor_id), node_(node) {}
 
 Interceptor::~Interceptor() {
+  VLOG(3) << "Interceptor " << interceptor_id_ << "'s max mailbox size is "
+          << max_mailbox_size_ << ".";
   // FIXME(wangxi): throw in stop function
   // std::lock_guard<std::mutex> lock(mutex_);
   // PADDLE_ENFORCE_EQ(messages_.empty(), true,
@@ -60,6 +64,32 @@ void Interceptor::LoopOnce() {
 
     Handle(msg);
   }
+
+  // Messages arrived while handling are run by a new task instead of looping
+  // here, so one busy interceptor can't hold a thread forever.
+  bool empty = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    empty = messages_.empty();
+    if (empty) {
+      loop_scheduled_ = false;
+    }
+  }
+  if (!empty) {
+    ScheduleLoopOnce();
+  }
+}
+
+void Interceptor::ScheduleLoopOnce() {
+  PADDLE_ENFORCE_NOT_NULL(
+      thread_pool_,
+      platform::errors::PreconditionNotMet("Thread pool is not registered."));
+  thread_pool_->AddTask(interceptor_id_, [this]() { LoopOnce(); });
+}
+
+size_t Interceptor::MaxMailboxSize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_mailbox_size_;
 }
 
 void Interceptor::StopCarrier() {
@@ -75,14 +105,16 @@ void Interceptor::EnqueueRemoteInterceptorMessage(
   VLOG(3) << "Enqueue message: " << message.message_type() << " into "
           << interceptor_id_ << "'s remote mailbox.";
 
-  bool empty = false;
+  bool need_schedule = false;
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    empty = messages_.empty();
     messages_.emplace_back(message);
+    max_mailbox_size_ = std::max(max_mailbox_size_, messages_.size());
+    need_schedule = !loop_scheduled_;
+    loop_scheduled_ = true;
   }
-  if (empty) {
-    loop_->QueueInLoop([this]() { LoopOnce(); });
+  if (need_schedule) {
+    ScheduleLoopOnce();
   }
 }
 
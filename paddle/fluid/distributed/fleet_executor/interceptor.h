@@ -38,7 +38,7 @@ namespace distributed {
 
 class TaskNode;
 class Carrier;
-class TaskLoop;
+class TaskLoopThreadPool;
 
 constexpr int64_t SOURCE_ID = -1;
 constexpr int64_t SINK_ID = -2;
@@ -79,7 +79,12 @@ class Interceptor {
     gc_ = gc;
   }
   void RegisterCarrier(Carrier* carrier) { carrier_ = carrier; }
-  void RegisterTaskLoop(TaskLoop* loop) { loop_ = loop; }
+  void RegisterThreadPool(TaskLoopThreadPool* thread_pool) {
+    thread_pool_ = thread_pool;
+  }
+
+  // the most messages ever waiting in the mailbox
+  size_t MaxMailboxSize();
 
   TaskNode* GetTaskNode() const { return node_; }
 
@@ -104,16 +109,21 @@ class Interceptor {
   std::shared_ptr<framework::GarbageCollector> gc_{nullptr};
 
   Carrier* carrier_;
-  TaskLoop* loop_;
+  TaskLoopThreadPool* thread_pool_{nullptr};
 
  private:
   void LoopOnce();
+  void ScheduleLoopOnce();
 
   // interceptor handle which process message
   MsgHandle handle_{nullptr};
 
   std::mutex mutex_;
   std::deque<InterceptorMessage> messages_;
+  // a LoopOnce is queued or running, at most one at a time so the messages
+  // are handled in order even if the pool moves us between threads
+  bool loop_scheduled_{false};
+  size_t max_mailbox_size_{0};
 
   int64_t already_run_times_{0};
   int64_t used_slot_nums_{0};
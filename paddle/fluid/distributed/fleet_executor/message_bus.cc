@@ -210,22 +210,38 @@ void MessageBus::ListenPort() {
 }
 
 #if defined(PADDLE_WITH_DISTRIBUTE) && defined(PADDLE_WITH_PSCORE)
+std::shared_ptr<brpc::Channel> MessageBus::GetChannel(int64_t dst_rank) {
+  std::lock_guard<std::mutex> lock(channel_mutex_);
+  auto& channel = rank_to_channel_[dst_rank];
+  if (channel == nullptr) {
+    const auto& dst_addr = GetAddr(dst_rank);
+    VLOG(3) << "Message bus connecting to addr: " << dst_addr;
+    brpc::ChannelOptions options;
+    options.protocol = "baidu_std";
+    options.connect_timeout_ms = 1000;
+    options.timeout_ms = 1000;
+    options.max_retry = 5;
+    auto new_channel = std::make_shared<brpc::Channel>();
+    PADDLE_ENFORCE_EQ(
+        new_channel->Init(dst_addr.c_str(), &options),
+        0,
+        platform::errors::Unavailable("Message bus: init brpc channel error."));
+    channel = std::move(new_channel);
+  }
+  return channel;
+}
+
+void MessageBus::ResetChannel(int64_t dst_rank) {
+  std::lock_guard<std::mutex> lock(channel_mutex_);
+  rank_to_channel_.erase(dst_rank);
+}
+
 bool MessageBus::SendInterRank(int64_t dst_rank,
                                const InterceptorMessage& interceptor_message) {
-  const auto& dst_addr = GetAddr(dst_rank);
-  VLOG(3) << "Message bus sending to addr: " << dst_addr;
-  const char* dst_addr_for_brpc = dst_addr.c_str();
-  brpc::Channel channel;
-  brpc::ChannelOptions options;
-  options.protocol = "baidu_std";
-  options.connect_timeout_ms = 1000;
-  options.timeout_ms = 1000;
-  options.max_retry = 5;
-  PADDLE_ENFORCE_EQ(
-      channel.Init(dst_addr_for_brpc, &options),
-      0,
-      platform::errors::Unavailable("Message bus: init brpc channel error."));
-  MessageService_Stub stub(&channel);
+  // brpc::Channel is thread safe, the channel of a rank is created once and
+  // shared by all the interceptors instead of connecting for every message
+  std::shared_ptr<brpc::Channel> channel = GetChannel(dst_rank);
+  MessageService_Stub stub(channel.get());
   InterceptorResponse response;
   brpc::Controller ctrl;
   ctrl.set_log_id(0);
@@ -246,6 +262,7 @@ bool MessageBus::SendInterRank(int64_t dst_rank,
   } else {
     VLOG(4) << "Message bus: brpc sends failed with error text: "
             << ctrl.ErrorText();
+    ResetChannel(dst_rank);
     return false;
   }
 }
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -67,6 +68,11 @@ class MessageBus final {
   // send the message inter rank (dst is different rank with src)
   bool SendInterRank(int64_t dst_rank,
                      const InterceptorMessage& interceptor_message);
+
+  // get the cached brpc channel to dst rank, connect on first use
+  std::shared_ptr<brpc::Channel> GetChannel(int64_t dst_rank);
+  // drop the cached channel after a failed send, the retry reconnects
+  void ResetChannel(int64_t dst_rank);
 #endif
 
   bool is_init_{false};
@@ -83,6 +89,9 @@ class MessageBus final {
   MessageServiceImpl message_service_;
   // brpc server
   brpc::Server server_;
+  // brpc channels to other ranks, reused by every message
+  std::mutex channel_mutex_;
+  std::unordered_map<int64_t, std::shared_ptr<brpc::Channel>> rank_to_channel_;
 #endif
 
   // for barrier
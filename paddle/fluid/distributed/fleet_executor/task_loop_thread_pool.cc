@@ -16,6 +16,7 @@
 
 #include "paddle/fluid/distributed/fleet_executor/task_loop.h"
 #include "paddle/fluid/distributed/fleet_executor/task_loop_thread.h"
+#include "paddle/fluid/framework/new_executor/workqueue/workqueue.h"
 #include "paddle/fluid/platform/enforce.h"
 #include "paddle/fluid/platform/errors.h"
 
@@ -25,9 +26,16 @@ namespace distributed {
 TaskLoopThreadPool::TaskLoopThreadPool() : TaskLoopThreadPool(1) {}
 
 TaskLoopThreadPool::TaskLoopThreadPool(int thread_num)
-    : start_(false), thread_num_(thread_num) {}
+    : start_(false), work_stealing_(false), thread_num_(thread_num) {}
 
-TaskLoopThreadPool::~TaskLoopThreadPool() = default;
+TaskLoopThreadPool::~TaskLoopThreadPool() {
+  // join the workers before the stats are read
+  work_queue_.reset();
+  threads_.clear();
+  VLOG(3) << "TaskLoopThreadPool finished " << finished_task_num_
+          << " tasks, max pending task num is " << max_pending_task_num_
+          << ".";
+}
 
 void TaskLoopThreadPool::Start() {
   PADDLE_ENFORCE_EQ(
@@ -41,17 +49,51 @@ void TaskLoopThreadPool::Start() {
           "thread num must greater than 0, but now is %d", thread_num_));
 
   start_ = true;
+  if (work_stealing_) {
+    framework::WorkQueueOptions options(/*name*/ "FleetExecutor",
+                                        /*num_threads*/ thread_num_,
+                                        /*allow_spinning*/ true,
+                                        /*track_task*/ false);
+    work_queue_ = framework::CreateMultiThreadedWorkQueue(options);
+    return;
+  }
   for (int i = 0; i < thread_num_; ++i) {
     threads_.emplace_back(new TaskLoopThread());
     loops_.push_back(threads_[i]->StartLoop());
   }
 }
 
+void TaskLoopThreadPool::AddTask(int64_t id, std::function<void()> task) {
+  PADDLE_ENFORCE_EQ(
+      start_,
+      true,
+      platform::errors::PreconditionNotMet("thread pool must start first."));
+  int64_t pending = ++pending_task_num_;
+  int64_t max_pending = max_pending_task_num_;
+  while (pending > max_pending &&
+         !max_pending_task_num_.compare_exchange_weak(max_pending, pending)) {
+  }
+  auto wrapped_task = [this, task = std::move(task)]() {
+    task();
+    --pending_task_num_;
+    ++finished_task_num_;
+  };
+  if (work_stealing_) {
+    work_queue_->AddTask(std::move(wrapped_task));
+  } else {
+    loops_[id % thread_num_]->QueueInLoop(std::move(wrapped_task));
+  }
+}
+
 TaskLoop* TaskLoopThreadPool::GetLoop(int tid) {
   PADDLE_ENFORCE_EQ(
       start_,
       true,
       platform::errors::PreconditionNotMet("thread pool must start first."));
+  PADDLE_ENFORCE_EQ(work_stealing_,
+                    false,
+                    platform::errors::PreconditionNotMet(
+                        "a work stealing thread pool has no task loop."));
   PADDLE_ENFORCE_GE(
       tid,
       0,
@@ -14,12 +14,18 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <vector>
 
 #include "paddle/fluid/platform/macros.h"
 
 namespace paddle {
+namespace framework {
+class WorkQueue;
+}  // namespace framework
+
 namespace distributed {
 
 class TaskLoop;
@@ -32,19 +38,39 @@ class TaskLoopThreadPool {
   ~TaskLoopThreadPool();
 
   void SetThreadNum(int thread_num) { thread_num_ = thread_num; }
+  // If set, tasks are not pinned to a loop thread. Each worker has its own run
+  // queue and idle workers steal from the busy ones. Must be set before Start.
+  void SetWorkStealing(bool work_stealing) { work_stealing_ = work_stealing; }
+  bool IsWorkStealing() const { return work_stealing_; }
 
   void Start();
 
   TaskLoop* GetLoop(int tid);
   std::vector<TaskLoop*> GetAllLoops();
 
+  // Runs task for the owner with the given id, on the loop of
+  // id % thread_num, or on any worker when work stealing is on. Tasks of the
+  // same owner are not ordered, the owner must serialize them by itself.
+  void AddTask(int64_t id, std::function<void()> task);
+
+  // tasks added but not finished yet
+  int64_t PendingTaskNum() const { return pending_task_num_; }
+  int64_t MaxPendingTaskNum() const { return max_pending_task_num_; }
+  int64_t FinishedTaskNum() const { return finished_task_num_; }
+
  private:
   DISABLE_COPY_AND_ASSIGN(TaskLoopThreadPool);
 
   bool start_;
+  bool work_stealing_;
   int thread_num_;
   std::vector<std::unique_ptr<TaskLoopThread>> threads_;
   std::vector<TaskLoop*> loops_;
+  std::unique_ptr<framework::WorkQueue> work_queue_;
+
+  std::atomic<int64_t> pending_task_num_{0};
+  std::atomic<int64_t> max_pending_task_num_{0};
+  std::atomic<int64_t> finished_task_num_{0};
 };
 
 }  // namespace distributed
@@ -0,0 +1,163 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/fluid/distributed/fleet_executor/dist_model.h"
+#include "paddle/fluid/framework/op_registry.h"
+#include "paddle/fluid/framework/program_desc.h"
+#include "paddle/fluid/framework/scope.h"
+#include "paddle/phi/core/kernel_registry.h"
+
+USE_OP_ITSELF(feed);
+USE_OP_ITSELF(fetch);
+USE_OP_ITSELF(scale);
+
+PD_DECLARE_KERNEL(scale, CPU, ALL_LAYOUT);
+
+namespace paddle {
+namespace distributed {
+
+// feed x -> y = 2 * x -> fetch y
+framework::ProgramDesc* GetProgram() {
+  auto* program = new framework::ProgramDesc();
+  auto* block = program->MutableBlock(0);
+
+  auto* feed_var = block->Var("feed");
+  feed_var->SetType(framework::proto::VarType::FEED_MINIBATCH);
+  feed_var->SetPersistable(true);
+  auto* fetch_var = block->Var("fetch");
+  fetch_var->SetType(framework::proto::VarType::FETCH_LIST);
+  fetch_var->SetPersistable(true);
+  for (auto name : {"x", "y"}) {
+    auto* var = block->Var(name);
+    var->SetType(framework::proto::VarType::LOD_TENSOR);
+    var->SetDataType(framework::proto::VarType::FP32);
+    var->SetShape({-1, 2});
+  }
+
+  auto* feed = block->AppendOp();
+  feed->SetType("feed");
+  feed->SetInput("X", {"feed"});
+  feed->SetOutput("Out", {"x"});
+  feed->SetAttr("col", 0);
+
+  auto* scale = block->AppendOp();
+  scale->SetType("scale");
+  scale->SetInput("X", {"x"});
+  scale->SetOutput("Out", {"y"});
+  scale->SetAttr("scale", 2.0f);
+  scale->CheckAttrs();
+
+  auto* fetch = block->AppendOp();
+  fetch->SetType("fetch");
+  fetch->SetInput("X", {"y"});
+  fetch->SetOutput("Out", {"fetch"});
+  fetch->SetAttr("col", 0);
+  return program;
+}
+
+std::vector<DistModelTensor> GetInput(float value) {
+  DistModelTensor x;
+  x.name = "x";
+  x.shape = {1, 2};
+  x.dtype = DistModelDataType::FLOAT32;
+  x.data.Resize(2 * sizeof(float));
+  static_cast<float*>(x.data.data())[0] = value;
+  static_cast<float*>(x.data.data())[1] = value + 1;
+  std::vector<DistModelTensor> inputs(1);
+  inputs[0] = std::move(x);
+  return inputs;
+}
+
+void ExpectOutput(const std::vector<DistModelTensor>& outputs, float value) {
+  ASSERT_EQ(outputs.size(), 1UL);
+  ASSERT_EQ(outputs[0].data.length(), 2 * sizeof(float));
+  const float* y = static_cast<const float*>(outputs[0].data.data());
+  EXPECT_FLOAT_EQ(y[0], 2 * value);
+  EXPECT_FLOAT_EQ(y[1], 2 * (value + 1));
+}
+
+TEST(DistModel, Serving) {
+  DistModelConfig config;
+  config.program_desc = GetProgram();
+  config.scope = new framework::Scope();
+  config.place = "CPU";
+  config.trainer_endpoints = {""};
+  DistModel dist_model(config);
+  ASSERT_TRUE(dist_model.Init());
+
+  EXPECT_FALSE(dist_model.RunAsync(GetInput(0), nullptr));
+  EXPECT_FALSE(dist_model.StartServing(0));
+  ASSERT_TRUE(dist_model.StartServing(4));
+  EXPECT_FALSE(dist_model.StartServing(4));
+
+  // more requests than the window, and a partial window at the end
+  const int request_num = 10;
+  std::mutex mutex;
+  std::map<int, std::vector<DistModelTensor>> results;
+  for (int i = 0; i < request_num; ++i) {
+    ASSERT_TRUE(dist_model.RunAsync(
+        GetInput(i),
+        [i, &mutex, &results](bool status,
+                              std::vector<DistModelTensor>* outputs) {
+          EXPECT_TRUE(status);
+          std::lock_guard<std::mutex> lock(mutex);
+          EXPECT_EQ(results.count(i), 0UL);
+          results[i] = std::move(*outputs);
+        }));
+  }
+  std::vector<DistModelTensor> outputs;
+  EXPECT_FALSE(dist_model.Run(GetInput(0), &outputs));
+  dist_model.StopServing();
+
+  // every request got its own result
+  ASSERT_EQ(results.size(), static_cast<size_t>(request_num));
+  for (auto& result : results) {
+    ExpectOutput(result.second, result.first);
+  }
+  DistModelServingStats stats = dist_model.GetServingStats();
+  EXPECT_EQ(stats.finished_num, request_num);
+  EXPECT_GT(stats.wall_ms, 0);
+  EXPECT_GE(stats.run_ms, 0);
+  ASSERT_EQ(stats.interceptor_busy_ms.size(), 1UL);
+  EXPECT_GE(stats.interceptor_busy_ms.begin()->second, 0);
+  EXPECT_LE(stats.interceptor_busy_ms.begin()->second, stats.wall_ms);
+  EXPECT_FALSE(dist_model.RunAsync(GetInput(0), nullptr));
+
+  // the window is fixed by the first StartServing
+  EXPECT_FALSE(dist_model.StartServing(2));
+  ASSERT_TRUE(dist_model.StartServing(4));
+  bool called = false;
+  ASSERT_TRUE(dist_model.RunAsync(
+      GetInput(7),
+      [&called](bool status, std::vector<DistModelTensor>* outputs) {
+        EXPECT_TRUE(status);
+        ExpectOutput(*outputs, 7);
+        called = true;
+      }));
+  dist_model.StopServing();
+  EXPECT_TRUE(called);
+  EXPECT_EQ(dist_model.GetServingStats().finished_num, 1);
+
+  // back to the synchronous mode
+  ASSERT_TRUE(dist_model.Run(GetInput(3), &outputs));
+  ExpectOutput(outputs, 3);
+}
+
+}  // namespace distributed
+}  // namespace paddle
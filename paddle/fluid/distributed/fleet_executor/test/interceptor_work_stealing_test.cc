@@ -0,0 +1,115 @@
+/* Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>  // NOLINT
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+#include "paddle/fluid/distributed/fleet_executor/carrier.h"
+#include "paddle/fluid/distributed/fleet_executor/global.h"
+#include "paddle/fluid/distributed/fleet_executor/interceptor.h"
+#include "paddle/fluid/distributed/fleet_executor/message_bus.h"
+
+DECLARE_int32(fleet_executor_thread_num);
+DECLARE_bool(fleet_executor_work_stealing);
+
+namespace paddle {
+namespace distributed {
+
+constexpr int64_t kMsgNum = 2000;
+constexpr int64_t kReceiverNum = 8;
+
+std::atomic<int64_t> finished_receivers{0};
+std::promise<void> all_finished;
+
+// Checks that messages are handled one at a time and in the order they were
+// sent, although the handling task may run on any thread of the pool.
+class OrderedInterceptor : public Interceptor {
+ public:
+  OrderedInterceptor(int64_t interceptor_id, TaskNode* node)
+      : Interceptor(interceptor_id, node) {
+    RegisterMsgHandle([this](const InterceptorMessage& msg) { Check(msg); });
+  }
+
+  void Check(const InterceptorMessage& msg) {
+    EXPECT_FALSE(handling_.exchange(true));
+    EXPECT_EQ(msg.scope_idx(), expected_idx_);
+    ++expected_idx_;
+    // imbalanced stages, the odd receivers are much slower
+    if (GetInterceptorId() % 2 == 1) {
+      std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+    handling_ = false;
+    if (expected_idx_ == kMsgNum && ++finished_receivers == kReceiverNum) {
+      all_finished.set_value();
+    }
+  }
+
+ private:
+  std::atomic<bool> handling_{false};
+  int64_t expected_idx_{0};
+};
+
+TEST(InterceptorTest, WorkStealing) {
+  FLAGS_fleet_executor_thread_num = 4;
+  FLAGS_fleet_executor_work_stealing = true;
+
+  std::string carrier_id = "0";
+  std::unordered_map<int64_t, int64_t> interceptor_id_to_rank;
+  for (int64_t i = 0; i <= kReceiverNum; ++i) {
+    interceptor_id_to_rank[i] = 0;
+  }
+  Carrier* carrier =
+      GlobalMap<std::string, Carrier>::Create(carrier_id, carrier_id);
+  carrier->Init(0, interceptor_id_to_rank);
+  MessageBus* msg_bus = GlobalVal<MessageBus>::Create();
+  msg_bus->Init(0, {{0, "127.0.0.0:0"}}, "");
+
+  std::vector<Interceptor*> receivers;
+  for (int64_t i = 1; i <= kReceiverNum; ++i) {
+    receivers.push_back(carrier->SetInterceptor(
+        i, std::make_unique<OrderedInterceptor>(i, nullptr)));
+  }
+  // interceptor 0 is only used as the sender
+  Interceptor* sender = carrier->SetInterceptor(
+      0, std::make_unique<OrderedInterceptor>(0, nullptr));
+
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t idx = 0; idx < kMsgNum; ++idx) {
+    for (int64_t i = 1; i <= kReceiverNum; ++i) {
+      InterceptorMessage msg;
+      msg.set_message_type(DATA_IS_READY);
+      msg.set_scope_idx(idx);
+      sender->Send(i, msg);
+    }
+  }
+  all_finished.get_future().wait();
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  std::cout << "handled " << kMsgNum * kReceiverNum << " messages in "
+            << seconds << "s" << std::endl;
+  for (auto* receiver : receivers) {
+    std::cout << "interceptor " << receiver->GetInterceptorId()
+              << " max mailbox size " << receiver->MaxMailboxSize()
+              << std::endl;
+  }
+}
+
+}  // namespace distributed
+}  // namespace paddle
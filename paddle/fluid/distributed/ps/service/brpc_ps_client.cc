@@ -1728,9 +1728,9 @@ void BrpcPsClient::PushSparseTaskConsume() {
   }
 }
 
-void sparse_local_merge(ValueAccessor *accessor,
-                        float *merge_data,
-                        const float *another_data) {
+void BrpcPsClient::SparseLocalMerge(ValueAccessor *accessor,
+                                    float *merge_data,
+                                    const float *another_data) {
   size_t col_num = accessor->GetAccessorInfo().update_dim;
   float *merge_data_shell[col_num];
   const float *another_data_shell[col_num];
@@ -1808,7 +1808,7 @@ int BrpcPsClient::PushSparseAsyncShardMerge(
         last_merge_data = reinterpret_cast<float *>(merger_buffer.get());
         memcpy(last_merge_data, last_value_data, value_size);
       }
-      sparse_local_merge(
+      SparseLocalMerge(
           accessor, last_merge_data, sorted_kv_list[kv_idx].second);
       ++kv_idx;
     }
@@ -310,6 +310,12 @@ class BrpcPsClient : public PSClient {
   void PrintQueueSize();
   void PrintQueueSizeThread();
 
+  // Merges the push value another_data of a sparse key into merge_data
+  // with the table accessor, as the async push does for duplicate keys.
+  static void SparseLocalMerge(ValueAccessor *accessor,
+                               float *merge_data,
+                               const float *another_data);
+
  protected:
   virtual size_t GetServerNums() { return _server_channels.size(); }
   inline brpc::Channel *GetSparseChannel(size_t server_id) {
@@ -673,10 +673,21 @@ void AsyncCommunicator::PushSparseFromTensorAsync(
   CHECK(clk_size == batch_size || clk_size == 1);
 
   CHECK(outputs->size() == inputs->size());
+  // push values are packed row by row into one contiguous buffer,
+  // each row is: slot show clk grad... consistent with CtrCommonPushValue
+  // defined in ctr_accessor.h
+  size_t value_dim = fea_dim + 1;
   std::vector<uint64_t> push_keys;
   push_keys.reserve(MAX_FEASIGN_NUM / 100);
-  std::vector<std::vector<float>> push_values;
-  push_values.reserve(MAX_FEASIGN_NUM / 100);
+  std::vector<float> push_values;
+  push_values.reserve(MAX_FEASIGN_NUM / 100 * value_dim);
+  // key -> row in push_values, used to merge duplicate keys before sending
+  std::unordered_map<uint64_t, size_t> key_to_row;
+  auto *accessor = _worker_ptr->GetTableAccessor(table_id);
+  bool merge_grad = FLAGS_communicator_merge_sparse_grad && accessor != nullptr;
+  if (merge_grad) {
+    key_to_row.reserve(MAX_FEASIGN_NUM / 100);
+  }
   size_t output_len = 0;
   size_t input_idx = 0;
 
@@ -687,6 +698,28 @@ void AsyncCommunicator::PushSparseFromTensorAsync(
   // const long int* show_tensor = shows->data<int64_t>();
   // const long int* clk_tensor = clks->data<int64_t>();
 
+  auto push_one = [&](uint64_t real_id, const float *grad) {
+    ++input_idx;
+    push_values.resize(push_values.size() + value_dim);
+    float *row = push_values.data() + push_values.size() - value_dim;
+    row[0] = 2;  // TODO(zhaocaibei123): slot
+    // row[1] =
+    //    (i >= show_size ? 1 : static_cast<float>(show_tensor[i]));
+    // row[2] =
+    //    (i >= clk_size ? 0 : static_cast<float>(clk_tensor[i]));
+    memcpy(row + 1, grad, sizeof(float) * fea_dim);  // hard code here
+    if (merge_grad) {
+      auto iter = key_to_row.emplace(real_id, push_keys.size());
+      if (!iter.second) {
+        BrpcPsClient::SparseLocalMerge(
+            accessor, push_values.data() + iter.first->second * value_dim, row);
+        push_values.resize(push_values.size() - value_dim);
+        return;
+      }
+    }
+    push_keys.emplace_back(real_id);
+  };
+
   for (size_t index = 0; index < inputs->size(); ++index) {
     framework::LoDTensor *g_tensor = outputs->at(index);
     float *g = g_tensor->data<float>();
@@ -713,21 +746,7 @@ void AsyncCommunicator::PushSparseFromTensorAsync(
           if (real_id == padding_id) {
             continue;
           }
-          push_keys.emplace_back(real_id);
-          push_values.emplace_back(fea_dim + 1);
-          // slot show clk grad... consistent with CtrCommonPushValue defined in
-          // ctr_accessor.h
-          push_values.back()[0] = 2;  // TODO(zhaocaibei123): slot
-          // push_values.back()[1] =
-          //    (i >= show_size ? 1 : static_cast<float>(show_tensor[i]));
-          // push_values.back()[2] =
-          //    (i >= clk_size ? 0 : static_cast<float>(clk_tensor[i]));
-
-          float *data = push_values.back().data() + 1;  // hard code here
-
-          memcpy(data, g + output_len, sizeof(float) * fea_dim);
-
-          ++input_idx;
+          push_one(real_id, g + output_len);
         }
       }
     } else {
@@ -736,30 +755,20 @@ void AsyncCommunicator::PushSparseFromTensorAsync(
         if (real_id == padding_id) {
           continue;
         }
-        push_keys.emplace_back(real_id);
-        push_values.emplace_back(fea_dim + 1);
-        // slot show clk grad... consistent with CtrCommonPushValue defined in
-        // ctr_accessor.h
-        push_values.back()[0] = 2;  // TODO(zhaocaibei123): slot
-        // push_values.back()[1] =
-        //    (i >= show_size ? 1 : static_cast<float>(show_tensor[i]));
-        // push_values.back()[2] =
-        //    (i >= clk_size ? 0 : static_cast<float>(clk_tensor[i]));
-
-        float *data = push_values.back().data() + 1;
-
-        memcpy(data, g + output_len, sizeof(float) * fea_dim);
-
-        ++input_idx;
+        push_one(real_id, g + output_len);
       }
     }
     CHECK(static_cast<int64_t>(output_len) == g_tensor->numel());
   }
 
-  std::vector<float *> push_g_vec(input_idx, nullptr);
+  VLOG(3) << "PushSparseFromTensorAsync table: " << table_id
+          << " input keys: " << input_idx
+          << " keys after merge: " << push_keys.size();
+
+  std::vector<float *> push_g_vec(push_keys.size(), nullptr);
 
   for (auto i = 0u; i < push_keys.size(); ++i) {
-    push_g_vec[i] = push_values.at(i).data();
+    push_g_vec[i] = push_values.data() + i * value_dim;
   }
 
   PADDLE_ENFORCE_EQ(
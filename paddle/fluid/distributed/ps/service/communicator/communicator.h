@@ -53,6 +53,7 @@ struct CommContext;
 }  // namespace paddle
 
 DECLARE_bool(communicator_is_sgd_optimizer);
+DECLARE_bool(communicator_merge_sparse_grad);
 
 namespace paddle {
 namespace distributed {
@@ -14,12 +14,14 @@
 
 #include "paddle/fluid/distributed/ps/table/common_graph_table.h"
 
+#include <sys/stat.h>
 #include <time.h>
 
 #include <algorithm>
 #include <chrono>
 #include <set>
 #include <sstream>
+#include <tuple>
 
 #include "gflags/gflags.h"
 #include "paddle/fluid/distributed/common/utils.h"
@@ -31,6 +33,7 @@
 #include "paddle/fluid/string/string_helper.h"
 
 DECLARE_bool(graph_load_in_parallel);
+DECLARE_bool(graph_load_by_range);
 
 namespace paddle {
 namespace distributed {
@@ -470,6 +473,9 @@ void GraphTable::clear_graph(int idx) {
   for (size_t i = 0; i < shard_num_per_server; i++) {
     edge_shards[idx].push_back(new GraphShard());
   }
+  if (idx < (int)csr_shards.size()) {
+    csr_shards[idx].clear();
+  }
 }
 int32_t GraphTable::load_next_partition(int idx) {
   if (next_partition >= (int)partitions[idx].size()) {
@@ -1326,11 +1332,17 @@ int32_t GraphTable::load_nodes(const std::string &path, std::string node_type) {
       }
       idx = feature_to_id[node_type];
     }
-    for (auto path : paths) {
-      VLOG(2) << "Begin GraphTable::load_nodes(), path[" << path << "]";
-      auto res = parse_node_file(path, node_type, idx);
+    if (FLAGS_graph_load_by_range) {
+      auto res = load_nodes_by_range(paths, node_type, idx);
       count += res.first;
       valid_count += res.second;
+    } else {
+      for (auto path : paths) {
+        VLOG(2) << "Begin GraphTable::load_nodes(), path[" << path << "]";
+        auto res = parse_node_file(path, node_type, idx);
+        count += res.first;
+        valid_count += res.second;
+      }
     }
   }
 
@@ -1432,6 +1444,8 @@ int32_t GraphTable::load_edges(const std::string &path,
   uint64_t valid_count = 0;
 
   VLOG(0) << "Begin GraphTable::load_edges() edge_type[" << edge_type << "]";
+  paddle::platform::Timer timer;
+  timer.Start();
   if (FLAGS_graph_load_in_parallel) {
     std::vector<std::future<std::pair<uint64_t, uint64_t>>> tasks;
     for (int i = 0; i < paths.size(); i++) {
@@ -1445,6 +1459,10 @@ int32_t GraphTable::load_edges(const std::string &path,
       count += res.first;
       valid_count += res.second;
     }
+  } else if (FLAGS_graph_load_by_range) {
+    auto res = load_edges_by_range(paths, idx, reverse_edge);
+    count += res.first;
+    valid_count += res.second;
   } else {
     for (auto path : paths) {
       auto res = parse_edge_file(path, idx, reverse_edge);
@@ -1452,8 +1470,11 @@ int32_t GraphTable::load_edges(const std::string &path,
       valid_count += res.second;
     }
   }
+  timer.Pause();
   VLOG(0) << valid_count << "/" << count << " edge_type[" << edge_type
-          << "] edges are loaded successfully";
+          << "] edges are loaded successfully in " << timer.ElapsedSec()
+          << "s, " << count / std::max(timer.ElapsedSec(), 1e-6)
+          << " edges/s";
 
 #ifdef PADDLE_WITH_HETERPS
   if (search_level == 2) {
@@ -1486,6 +1507,340 @@ int32_t GraphTable::load_edges(const std::string &path,
   return 0;
 }
 
+namespace {
+struct GraphEdgeRecord {
+  uint64_t src_id;
+  uint64_t dst_id;
+  float weight;
+  bool has_weight;
+};
+
+struct GraphNodeRecord {
+  int idx;
+  uint64_t id;
+  const char *feat;
+  size_t feat_len;
+};
+
+inline uint64_t parse_uint64(const char *&p, const char *end) {
+  uint64_t x = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    x = x * 10 + (*p - '0');
+    ++p;
+  }
+  return x;
+}
+
+// Splits the files into byte ranges of about the same size, about
+// range_num ranges in total.
+std::vector<std::tuple<int, size_t, size_t>> split_file_ranges(
+    const std::vector<std::string> &paths, size_t range_num) {
+  const size_t min_range_size = 4 << 20;
+  std::vector<size_t> file_sizes(paths.size(), 0);
+  size_t total_size = 0;
+  for (size_t i = 0; i < paths.size(); i++) {
+    struct stat st;
+    if (stat(paths[i].c_str(), &st) == 0) {
+      file_sizes[i] = st.st_size;
+      total_size += st.st_size;
+    }
+  }
+  size_t range_size = std::max(total_size / std::max<size_t>(range_num, 1),
+                               min_range_size);
+  std::vector<std::tuple<int, size_t, size_t>> ranges;
+  for (size_t i = 0; i < paths.size(); i++) {
+    for (size_t begin = 0; begin < file_sizes[i]; begin += range_size) {
+      ranges.emplace_back(
+          i, begin, std::min(begin + range_size, file_sizes[i]));
+    }
+  }
+  return ranges;
+}
+
+// Reads the lines starting in [begin, end) of path into buffer, returns the
+// offset of the first owned line in buffer.
+size_t read_file_range(const std::string &path,
+                       size_t begin,
+                       size_t end,
+                       std::string *buffer) {
+  std::ifstream file(path, std::ios::binary);
+  // read one byte before begin to know whether a line starts at begin
+  size_t read_begin = begin > 0 ? begin - 1 : 0;
+  file.seekg(read_begin);
+  buffer->resize(end - read_begin);
+  file.read(&(*buffer)[0], buffer->size());
+  buffer->resize(file.gcount());
+  if (!buffer->empty() && buffer->back() != '\n' && file) {
+    // the last line crosses end, it belongs to this range
+    std::string tail;
+    std::getline(file, tail);
+    buffer->append(tail);
+  }
+  if (begin == 0) {
+    return 0;
+  }
+  size_t pos = buffer->find('\n');
+  return pos == std::string::npos ? buffer->size() : pos + 1;
+}
+}  // namespace
+
+std::pair<uint64_t, uint64_t> GraphTable::load_edges_by_range(
+    const std::vector<std::string> &paths, int idx, bool reverse) {
+  auto ranges = split_file_ranges(paths, load_thread_num);
+  // edges parsed from range i into local shard j are in range_edges[i][j]
+  std::vector<std::vector<std::vector<GraphEdgeRecord>>> range_edges(
+      ranges.size());
+  std::vector<std::pair<uint64_t, uint64_t>> range_counts(ranges.size());
+  std::vector<std::future<int>> tasks;
+  for (size_t i = 0; i < ranges.size(); i++) {
+    tasks.push_back(load_node_edge_task_pool->enqueue([&, i, this]() -> int {
+      auto &shard_edges = range_edges[i];
+      shard_edges.resize(shard_num_per_server);
+      std::string buffer;
+      size_t pos = read_file_range(paths[std::get<0>(ranges[i])],
+                                   std::get<1>(ranges[i]),
+                                   std::get<2>(ranges[i]),
+                                   &buffer);
+      uint64_t local_count = 0;
+      uint64_t local_valid_count = 0;
+      const char *p = buffer.data() + pos;
+      const char *end = buffer.data() + buffer.size();
+      while (p < end) {
+        const char *line_end =
+            static_cast<const char *>(memchr(p, '\n', end - p));
+        if (line_end == nullptr) line_end = end;
+        const char *tab =
+            static_cast<const char *>(memchr(p, '\t', line_end - p));
+        if (tab == nullptr) {
+          p = line_end + 1;
+          continue;
+        }
+        local_count++;
+        uint64_t src_id = parse_uint64(p, tab);
+        p = tab + 1;
+        uint64_t dst_id = parse_uint64(p, line_end);
+        float weight = 1;
+        bool has_weight = p < line_end && *p == '\t';
+        if (has_weight) {
+          weight = std::strtof(p + 1, NULL);
+        }
+        p = line_end + 1;
+        if (reverse) {
+          std::swap(src_id, dst_id);
+        }
+        size_t src_shard_id = src_id % shard_num;
+        if (src_shard_id >= shard_end || src_shard_id < shard_start) {
+          VLOG(4) << "will not load " << src_id << " from "
+                  << paths[std::get<0>(ranges[i])]
+                  << ", please check id distribution";
+          continue;
+        }
+        shard_edges[src_shard_id - shard_start].push_back(
+            {src_id, dst_id, weight, has_weight});
+        local_valid_count++;
+      }
+      range_counts[i] = {local_count, local_valid_count};
+      return 0;
+    }));
+  }
+  for (auto &t : tasks) t.get();
+  tasks.clear();
+
+  auto &shards = edge_shards[idx];
+  for (size_t j = 0; j < shards.size(); j++) {
+    tasks.push_back(load_node_edge_task_pool->enqueue([&, j, this]() -> int {
+      // a node gets weighted edges when one of its lines has a weight
+      std::unordered_set<uint64_t> weighted_ids;
+      for (auto &shard_edges : range_edges) {
+        for (auto &edge : shard_edges[j]) {
+          if (edge.has_weight) {
+            weighted_ids.insert(edge.src_id);
+          }
+        }
+      }
+      for (auto &shard_edges : range_edges) {
+        for (auto &edge : shard_edges[j]) {
+          auto node = shards[j]->add_graph_node(edge.src_id);
+          node->build_edges(weighted_ids.count(edge.src_id) > 0);
+          node->add_edge(edge.dst_id, edge.weight);
+        }
+        std::vector<GraphEdgeRecord>().swap(shard_edges[j]);
+      }
+      return 0;
+    }));
+  }
+  for (auto &t : tasks) t.get();
+
+  std::pair<uint64_t, uint64_t> res(0, 0);
+  for (auto &count : range_counts) {
+    res.first += count.first;
+    res.second += count.second;
+  }
+  return res;
+}
+
+std::pair<uint64_t, uint64_t> GraphTable::load_nodes_by_range(
+    const std::vector<std::string> &paths,
+    const std::string &node_type,
+    int idx) {
+  auto ranges = split_file_ranges(paths, load_thread_num);
+  // the parsed records point into the range buffers, they are kept until
+  // all the shards are filled.
+  std::vector<std::string> range_buffers(ranges.size());
+  std::vector<std::vector<std::vector<GraphNodeRecord>>> range_nodes(
+      ranges.size());
+  std::vector<std::pair<uint64_t, uint64_t>> range_counts(ranges.size());
+  size_t type_len = node_type.length();
+  std::vector<std::future<int>> tasks;
+  for (size_t i = 0; i < ranges.size(); i++) {
+    tasks.push_back(load_node_edge_task_pool->enqueue([&, i, this]() -> int {
+      auto &shard_nodes = range_nodes[i];
+      shard_nodes.resize(shard_num_per_server);
+      auto &buffer = range_buffers[i];
+      size_t pos = read_file_range(paths[std::get<0>(ranges[i])],
+                                   std::get<1>(ranges[i]),
+                                   std::get<2>(ranges[i]),
+                                   &buffer);
+      uint64_t local_count = 0;
+      uint64_t local_valid_count = 0;
+      const char *p = buffer.data() + pos;
+      const char *end = buffer.data() + buffer.size();
+      while (p < end) {
+        const char *line_end =
+            static_cast<const char *>(memchr(p, '\n', end - p));
+        if (line_end == nullptr) line_end = end;
+        const char *line = p;
+        p = line_end + 1;
+        const char *tab =
+            static_cast<const char *>(memchr(line, '\t', line_end - line));
+        if (tab == nullptr) {
+          continue;
+        }
+        int node_idx = idx;
+        if (type_len > 0) {
+          if ((size_t)(tab - line) != type_len ||
+              strncmp(line, node_type.c_str(), type_len) != 0) {
+            continue;
+          }
+        } else {
+          auto it = feature_to_id.find(std::string(line, tab - line));
+          if (it == feature_to_id.end()) {
+            VLOG(0) << std::string(line, tab - line)
+                    << "type error, please check";
+            continue;
+          }
+          node_idx = it->second;
+        }
+        const char *id_str = tab + 1;
+        uint64_t id = parse_uint64(id_str, line_end);
+        size_t shard_id = id % shard_num;
+        if (shard_id >= shard_end || shard_id < shard_start) {
+          VLOG(4) << "will not load " << id << " from "
+                  << paths[std::get<0>(ranges[i])]
+                  << ", please check id distribution";
+          continue;
+        }
+        local_count++;
+        const char *feat = id_str < line_end ? id_str + 1 : line_end;
+        shard_nodes[shard_id - shard_start].push_back(
+            {node_idx, id, feat, (size_t)(line_end - feat)});
+        local_valid_count++;
+      }
+      range_counts[i] = {local_count, local_valid_count};
+      return 0;
+    }));
+  }
+  for (auto &t : tasks) t.get();
+  tasks.clear();
+
+  for (size_t j = 0; j < shard_num_per_server; j++) {
+    tasks.push_back(load_node_edge_task_pool->enqueue([&, j, this]() -> int {
+      std::vector<paddle::string::str_ptr> vals;
+      for (auto &shard_nodes : range_nodes) {
+        for (auto &record : shard_nodes[j]) {
+          auto node =
+              feature_shards[record.idx][j]->add_feature_node(record.id, false);
+          if (node == NULL) {
+            continue;
+          }
+          if (type_len > 0) {
+            node->set_feature_size(feat_name[record.idx].size());
+          }
+          vals.clear();
+          paddle::string::split_string_ptr(
+              record.feat, record.feat_len, '\t', &vals);
+          for (auto &v : vals) {
+            parse_feature(record.idx, v.ptr, v.len, node);
+          }
+        }
+      }
+      return 0;
+    }));
+  }
+  for (auto &t : tasks) t.get();
+
+  std::pair<uint64_t, uint64_t> res(0, 0);
+  for (auto &count : range_counts) {
+    res.first += count.first;
+    res.second += count.second;
+  }
+  return res;
+}
+
+int32_t GraphTable::save_edges_snapshot(int idx, const std::string &path) {
+  if (build_csr(idx) != 0) {
+    return -1;
+  }
+  return save_csr(idx, path);
+}
+
+int32_t GraphTable::load_edges_snapshot(int idx, const std::string &path) {
+  paddle::platform::Timer timer;
+  timer.Start();
+  if (load_csr(idx, path) != 0) {
+    return -1;
+  }
+  auto &csr = csr_shards[idx];
+  auto &shards = edge_shards[idx];
+  std::vector<std::future<int>> tasks;
+  for (size_t j = 0; j < shards.size(); j++) {
+    tasks.push_back(load_node_edge_task_pool->enqueue([&, j, this]() -> int {
+      auto &shard = csr[j];
+      for (size_t row = 0; row < shard->node_size(); row++) {
+        auto node = shards[j]->add_graph_node(shard->get_key(row));
+        size_t begin = shard->row_begin(row);
+        size_t end = begin + shard->degree(row);
+        // the snapshot keeps no weights for a shard without one, so a row
+        // is weighted when one of its weights is not 1
+        bool weighted = false;
+        for (size_t edge = begin; shard->is_weighted() && edge < end; edge++) {
+          weighted = weighted || shard->get_neighbor_weight(edge) != 1.0;
+        }
+        node->build_edges(weighted);
+        for (size_t edge = begin; edge < end; edge++) {
+          node->add_edge(shard->get_neighbor_id(edge),
+                         shard->get_neighbor_weight(edge));
+        }
+        if (build_sampler_on_cpu) {
+          node->build_sampler(weighted ? "weighted" : "random");
+        }
+      }
+      return 0;
+    }));
+  }
+  size_t edge_num = 0;
+  for (auto &shard : csr) {
+    edge_num += shard->edge_size();
+  }
+  for (auto &t : tasks) t.get();
+  timer.Pause();
+  VLOG(0) << "load " << edge_num << " edges of edge idx " << idx
+          << " from snapshot " << path << " in " << timer.ElapsedSec()
+          << "s, " << edge_num / std::max(timer.ElapsedSec(), 1e-6)
+          << " edges/s";
+  return 0;
+}
+
 Node *GraphTable::find_node(int type_id, uint64_t id) {
   size_t shard_id = id % shard_num;
   if (shard_id >= shard_end || shard_id < shard_start) {
@@ -1675,7 +2030,10 @@ int32_t GraphTable::random_sample_neighbors(
           uint64_t id;
           float weight;
           char *buffer_addr = new char[actual_size];
-          if (response == LRUResponse::ok) {
+          if (response == LRUResponse::ok &&
+              (int)node->get_neighbor_size() >= cache_min_degree &&
+              cache_freq_sketch[i].increment(node_id) >=
+                  cache_admit_frequency) {
             sample_keys.emplace_back(idx, node_id, sample_size, need_weight);
             sample_res.emplace_back(actual_size, buffer_addr);
             buffer = sample_res.back().buffer;
@@ -1707,6 +2065,147 @@ int32_t GraphTable::random_sample_neighbors(
   return 0;
 }
 
+int32_t GraphTable::build_csr(int idx, bool build_alias) {
+  if (idx >= (int)edge_shards.size()) {
+    VLOG(0) << "build_csr got an invalid edge idx " << idx;
+    return -1;
+  }
+  csr_shards.resize(edge_shards.size());
+  auto &shards = edge_shards[idx];
+  std::vector<std::shared_ptr<GraphCSRShard>> res(shards.size());
+  std::vector<std::future<int>> tasks;
+  for (size_t i = 0; i < shards.size(); i++) {
+    tasks.push_back(
+        _shards_task_pool[i % task_pool_size_]->enqueue([&, i]() -> int {
+          res[i] = std::make_shared<GraphCSRShard>();
+          res[i]->build(shards[i]->get_bucket(), build_alias);
+          return 0;
+        }));
+  }
+  for (auto &t : tasks) {
+    t.get();
+  }
+  size_t edge_num = 0;
+  for (auto &shard : res) {
+    edge_num += shard->edge_size();
+  }
+  csr_shards[idx] = std::move(res);
+  VLOG(0) << "build csr for edge idx " << idx << " edges " << edge_num;
+  return 0;
+}
+
+int32_t GraphTable::save_csr(int idx, const std::string &path) {
+  if (idx >= (int)csr_shards.size() || csr_shards[idx].empty()) {
+    VLOG(0) << "save_csr called before build_csr for edge idx " << idx;
+    return -1;
+  }
+  paddle::framework::localfs_mkdir(path);
+  auto &shards = csr_shards[idx];
+  std::vector<std::future<int>> tasks;
+  for (size_t i = 0; i < shards.size(); i++) {
+    tasks.push_back(
+        _shards_task_pool[i % task_pool_size_]->enqueue([&, i]() -> int {
+          return shards[i]->save(paddle::string::Sprintf(
+              "%s/part-%05d", path, shard_start + i));
+        }));
+  }
+  int ret = 0;
+  for (auto &t : tasks) {
+    if (t.get() != 0) ret = -1;
+  }
+  return ret;
+}
+
+int32_t GraphTable::load_csr(int idx, const std::string &path) {
+  if (idx >= (int)edge_shards.size()) {
+    VLOG(0) << "load_csr got an invalid edge idx " << idx;
+    return -1;
+  }
+  csr_shards.resize(edge_shards.size());
+  std::vector<std::shared_ptr<GraphCSRShard>> res(shard_num_per_server);
+  std::vector<std::future<int>> tasks;
+  for (size_t i = 0; i < res.size(); i++) {
+    tasks.push_back(
+        _shards_task_pool[i % task_pool_size_]->enqueue([&, i]() -> int {
+          res[i] = std::make_shared<GraphCSRShard>();
+          return res[i]->load(paddle::string::Sprintf(
+              "%s/part-%05d", path, shard_start + i));
+        }));
+  }
+  int ret = 0;
+  for (auto &t : tasks) {
+    if (t.get() != 0) ret = -1;
+  }
+  if (ret == 0) {
+    csr_shards[idx] = std::move(res);
+  }
+  return ret;
+}
+
+int32_t GraphTable::batch_sample_neighbors(int idx,
+                                           const uint64_t *node_ids,
+                                           size_t node_num,
+                                           int sample_size,
+                                           bool need_weight,
+                                           std::vector<char> *buffer,
+                                           std::vector<int> *actual_sizes) {
+  if (idx >= (int)csr_shards.size() || csr_shards[idx].empty()) {
+    VLOG(0) << "batch_sample_neighbors called before build_csr for edge idx "
+            << idx;
+    return -1;
+  }
+  auto &shards = csr_shards[idx];
+  int stride = need_weight ? (Node::id_size + Node::weight_size) : Node::id_size;
+  size_t slot_size = (size_t)sample_size * stride;
+  // every node first writes into its own fixed slot, then the slots are
+  // compacted in place, so the whole batch needs one allocation.
+  buffer->resize(node_num * slot_size);
+  actual_sizes->assign(node_num, 0);
+  std::vector<std::vector<uint32_t>> seq_id(task_pool_size_);
+  for (size_t idy = 0; idy < node_num; ++idy) {
+    seq_id[get_thread_pool_index(node_ids[idy])].push_back(idy);
+  }
+  std::vector<std::future<int>> tasks;
+  for (int i = 0; i < (int)seq_id.size(); i++) {
+    if (seq_id[i].size() == 0) continue;
+    tasks.push_back(_shards_task_pool[i]->enqueue([&, i]() -> int {
+      auto &rng = _shards_task_rng_pool[i];
+      for (auto idy : seq_id[i]) {
+        uint64_t node_id = node_ids[idy];
+        size_t shard_id = node_id % shard_num;
+        if (shard_id >= shard_end || shard_id < shard_start) {
+          continue;
+        }
+        auto &shard = shards[shard_id - shard_start];
+        int64_t row = shard->find_row(node_id);
+        if (row < 0) {
+          continue;
+        }
+        int num = shard->sample(row,
+                                sample_size,
+                                need_weight,
+                                rng.get(),
+                                buffer->data() + idy * slot_size);
+        (*actual_sizes)[idy] = num * stride;
+      }
+      return 0;
+    }));
+  }
+  for (auto &t : tasks) {
+    t.get();
+  }
+  size_t offset = 0;
+  for (size_t idy = 0; idy < node_num; ++idy) {
+    int size = (*actual_sizes)[idy];
+    if (size > 0 && offset != idy * slot_size) {
+      memmove(buffer->data() + offset, buffer->data() + idy * slot_size, size);
+    }
+    offset += size;
+  }
+  buffer->resize(offset);
+  return 0;
+}
+
 int32_t GraphTable::get_node_feat(int idx,
                                   const std::vector<uint64_t> &node_ids,
                                   const std::vector<std::string> &feature_names,
@@ -2135,10 +2634,12 @@ int32_t GraphTable::Initialize(const GraphParameter &graph) {
     _shard_idx = 0;
     shard_num = graph.shard_num();
   }
-  use_cache = graph.use_cache();
-  if (use_cache) {
+  if (graph.use_cache()) {
     cache_size_limit = graph.cache_size_limit();
     cache_ttl = graph.cache_ttl();
+    cache_byte_limit = graph.cache_byte_limit();
+    cache_min_degree = graph.cache_min_degree();
+    cache_admit_frequency = graph.cache_admit_frequency();
     make_neighbor_sample_cache((size_t)cache_size_limit, (size_t)cache_ttl);
   }
   _shards_task_pool.resize(task_pool_size_);
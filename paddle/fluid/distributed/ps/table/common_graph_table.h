@@ -41,6 +41,7 @@
 #include "paddle/fluid/distributed/ps/table/accessor.h"
 #include "paddle/fluid/distributed/ps/table/common_table.h"
 #include "paddle/fluid/distributed/ps/table/graph/class_macro.h"
+#include "paddle/fluid/distributed/ps/table/graph/graph_csr.h"
 #include "paddle/fluid/distributed/ps/table/graph/graph_node.h"
 #include "paddle/fluid/string/string_helper.h"
 #include "paddle/phi/core/utils/rw_lock.h"
@@ -169,6 +170,39 @@ class SampleResult {
   ~SampleResult() {}
 };
 
+// bytes a cached value takes, used by the byte limit of ScaledLRU
+template <typename V>
+inline size_t lru_value_bytes(const V &value) {
+  return sizeof(V);
+}
+inline size_t lru_value_bytes(const SampleResult &value) {
+  return sizeof(SampleResult) + value.actual_size;
+}
+
+// Approximate per-key query counter, used to admit only frequently queried
+// nodes into the sample cache. Counters saturate at 255 and are halved every
+// reset_period updates so that old hot keys fade out. Not thread safe, one
+// sketch is used per task pool.
+class SampleFrequencySketch {
+ public:
+  explicit SampleFrequencySketch(size_t size = 1 << 16)
+      : counters(size, 0), additions(0), reset_period(size * 8) {}
+  uint8_t increment(uint64_t key) {
+    size_t pos = (key * 0x9E3779B97F4A7C15ULL) % counters.size();
+    uint8_t &counter = counters[pos];
+    if (counter < 255) counter++;
+    if (++additions >= reset_period) {
+      for (auto &c : counters) c >>= 1;
+      additions = 0;
+    }
+    return counter;
+  }
+
+ private:
+  std::vector<uint8_t> counters;
+  size_t additions, reset_period;
+};
+
 template <typename K, typename V>
 class LRUNode {
  public:
@@ -194,6 +228,8 @@ class RandomSampleLRU {
     node_head = node_end = NULL;
     global_ttl = father->ttl;
     total_diff = 0;
+    node_bytes = 0;
+    bytes_diff = 0;
   }
 
   ~RandomSampleLRU() {
@@ -209,6 +245,8 @@ class RandomSampleLRU {
       return LRUResponse::blocked;
     // pthread_rwlock_rdlock(&father->rwlock);
     int init_size = node_size - remove_count;
+    int64_t init_bytes = node_bytes;
+    size_t init_res_size = res.size();
     process_redundant(length * 3);
 
     for (size_t i = 0; i < length; i++) {
@@ -224,11 +262,11 @@ class RandomSampleLRU {
         }
       }
     }
+    __sync_fetch_and_add(&father->total, length);
+    __sync_fetch_and_add(&father->hit, res.size() - init_res_size);
     total_diff += node_size - remove_count - init_size;
-    if (total_diff >= 500 || total_diff < -500) {
-      father->handle_size_diff(total_diff);
-      total_diff = 0;
-    }
+    bytes_diff += node_bytes - init_bytes;
+    handle_diff();
     pthread_rwlock_unlock(&father->rwlock);
     return LRUResponse::ok;
   }
@@ -237,12 +275,15 @@ class RandomSampleLRU {
       return LRUResponse::blocked;
     // pthread_rwlock_rdlock(&father->rwlock);
     int init_size = node_size - remove_count;
+    int64_t init_bytes = node_bytes;
     process_redundant(length * 3);
     for (size_t i = 0; i < length; i++) {
       auto iter = key_map.find(keys[i]);
       if (iter != key_map.end()) {
         move_to_tail(iter->second);
         iter->second->ttl = global_ttl;
+        node_bytes += lru_value_bytes(data[i]);
+        node_bytes -= lru_value_bytes(iter->second->data);
         iter->second->data = data[i];
       } else {
         LRUNode<K, V> *temp = new LRUNode<K, V>(keys[i], data[i], global_ttl);
@@ -250,17 +291,26 @@ class RandomSampleLRU {
       }
     }
     total_diff += node_size - remove_count - init_size;
+    bytes_diff += node_bytes - init_bytes;
+    handle_diff();
+
+    pthread_rwlock_unlock(&father->rwlock);
+    return LRUResponse::ok;
+  }
+  void handle_diff() {
     if (total_diff >= 500 || total_diff < -500) {
       father->handle_size_diff(total_diff);
       total_diff = 0;
     }
-
-    pthread_rwlock_unlock(&father->rwlock);
-    return LRUResponse::ok;
+    if (bytes_diff >= (1 << 20) || bytes_diff < -(1 << 20)) {
+      father->handle_bytes_diff(bytes_diff);
+      bytes_diff = 0;
+    }
   }
   void remove(LRUNode<K, V> *node) {
     fetch(node);
     node_size--;
+    node_bytes -= lru_value_bytes(node->data);
     key_map.erase(node->key);
     delete node;
   }
@@ -283,6 +333,7 @@ class RandomSampleLRU {
     node->ttl = global_ttl;
     place_at_tail(node);
     node_size++;
+    node_bytes += lru_value_bytes(node->data);
     key_map[node->key] = node;
   }
   void place_at_tail(LRUNode<K, V> *node) {
@@ -315,6 +366,8 @@ class RandomSampleLRU {
   ScaledLRU<K, V> *father;
   size_t global_ttl, size_limit;
   int node_size, total_diff;
+  // bytes of the cached values, including the ones waiting to be removed
+  int64_t node_bytes, bytes_diff;
   LRUNode<K, V> *node_head, *node_end;
   friend class ScaledLRU<K, V>;
   int remove_count;
@@ -323,13 +376,19 @@ class RandomSampleLRU {
 template <typename K, typename V>
 class ScaledLRU {
  public:
-  ScaledLRU(size_t _shard_num, size_t size_limit, size_t _ttl)
-      : size_limit(size_limit), ttl(_ttl) {
+  // byte_limit bounds the bytes of the cached values, 0 means no bound
+  ScaledLRU(size_t _shard_num,
+            size_t size_limit,
+            size_t _ttl,
+            int64_t byte_limit = 0)
+      : size_limit(size_limit), byte_limit(byte_limit), ttl(_ttl) {
     shard_num = _shard_num;
     pthread_rwlock_init(&rwlock, NULL);
     stop = false;
     thread_pool.reset(new ::ThreadPool(1));
     global_count = 0;
+    global_bytes = 0;
+    total = hit = 0;
     lru_pool = std::vector<RandomSampleLRU<K, V>>(shard_num,
                                                   RandomSampleLRU<K, V>(this));
     shrink_job = std::thread([this]() -> void {
@@ -364,23 +423,41 @@ class ScaledLRU {
   }
   int Shrink() {
     int node_size = 0;
+    int64_t node_bytes = 0;
     for (size_t i = 0; i < lru_pool.size(); i++) {
       node_size += lru_pool[i].node_size - lru_pool[i].remove_count;
+      node_bytes += lru_pool[i].node_bytes;
     }
+    VLOG(1) << "sample cache nodes " << node_size << " bytes " << node_bytes
+            << " hit " << hit << "/" << total;
 
-    if ((size_t)node_size <= size_t(1.1 * size_limit) + 1) return 0;
+    bool over_size = (size_t)node_size > size_t(1.1 * size_limit) + 1;
+    bool over_bytes =
+        byte_limit > 0 && node_bytes > int64_t(1.1 * byte_limit) + 1;
+    if (!over_size && !over_bytes) return 0;
     if (pthread_rwlock_wrlock(&rwlock) == 0) {
       global_count = 0;
+      global_bytes = 0;
       for (size_t i = 0; i < lru_pool.size(); i++) {
         global_count += lru_pool[i].node_size - lru_pool[i].remove_count;
+        global_bytes += lru_pool[i].node_bytes;
       }
+      // fraction of the live nodes to remove from every shard
+      double remove_ratio = 0;
       if ((size_t)global_count > size_limit) {
-        size_t remove = global_count - size_limit;
+        remove_ratio = 1.0 * (global_count - size_limit) / global_count;
+      }
+      if (byte_limit > 0 && global_bytes > byte_limit) {
+        remove_ratio = std::max(
+            remove_ratio, 1.0 * (global_bytes - byte_limit) / global_bytes);
+      }
+      if (remove_ratio > 0) {
         for (size_t i = 0; i < lru_pool.size(); i++) {
           lru_pool[i].total_diff = 0;
+          lru_pool[i].bytes_diff = 0;
           lru_pool[i].remove_count +=
-              1.0 * (lru_pool[i].node_size - lru_pool[i].remove_count) /
-              global_count * remove;
+              remove_ratio *
+              (lru_pool[i].node_size - lru_pool[i].remove_count);
         }
       }
       pthread_rwlock_unlock(&rwlock);
@@ -398,13 +475,28 @@ class ScaledLRU {
     }
   }
 
+  void handle_bytes_diff(int64_t diff) {
+    if (diff != 0) {
+      __sync_fetch_and_add(&global_bytes, diff);
+      if (byte_limit > 0 && global_bytes > int64_t(1.25 * byte_limit)) {
+        thread_pool->enqueue([this]() -> int { return Shrink(); });
+      }
+    }
+  }
+
   size_t get_ttl() { return ttl; }
+  // number of queried keys and of the keys found in the cache
+  size_t get_query_count() { return total; }
+  size_t get_hit_count() { return hit; }
+  int64_t get_bytes() { return global_bytes; }
 
  private:
   pthread_rwlock_t rwlock;
   size_t shard_num;
   int global_count;
+  int64_t global_bytes;
   size_t size_limit, total, hit;
+  int64_t byte_limit;
   size_t ttl;
   bool stop;
   std::thread shrink_job;
@@ -520,6 +612,23 @@ class GraphTable : public Table {
       std::vector<int> &actual_sizes,
       bool need_weight);
 
+  // Samples the neighbors of node_num nodes from the csr shards built by
+  // build_csr/load_csr. The results of all nodes are packed one after another
+  // into buffer, actual_sizes[i] is the byte size of the i-th node's result.
+  int32_t batch_sample_neighbors(int idx,
+                                 const uint64_t *node_ids,
+                                 size_t node_num,
+                                 int sample_size,
+                                 bool need_weight,
+                                 std::vector<char> *buffer,
+                                 std::vector<int> *actual_sizes);
+
+  // Builds a read-only csr copy of the edge shards of idx.
+  int32_t build_csr(int idx, bool build_alias = true);
+  // Saves / loads the csr shards of idx as path/part-<shard_id>.
+  int32_t save_csr(int idx, const std::string &path);
+  int32_t load_csr(int idx, const std::string &path);
+
   int32_t random_sample_nodes(int type_id,
                               int idx,
                               int sample_size,
@@ -577,6 +686,19 @@ class GraphTable : public Table {
                                                 const std::string &node_type,
                                                 int idx);
   std::pair<uint64_t, uint64_t> parse_node_file(const std::string &path);
+  // Splits the files into byte ranges parsed by load_node_edge_task_pool,
+  // then inserts the parsed edges/nodes with one task per shard, so no lock
+  // is taken on the shards. Used when FLAGS_graph_load_by_range is set.
+  std::pair<uint64_t, uint64_t> load_edges_by_range(
+      const std::vector<std::string> &paths, int idx, bool reverse);
+  std::pair<uint64_t, uint64_t> load_nodes_by_range(
+      const std::vector<std::string> &paths,
+      const std::string &node_type,
+      int idx);
+  // Binary snapshot of the edges of idx in the csr file format, loading it
+  // back skips text parsing on restart.
+  int32_t save_edges_snapshot(int idx, const std::string &path);
+  int32_t load_edges_snapshot(int idx, const std::string &path);
   int32_t add_graph_node(int idx,
                          std::vector<uint64_t> &id_list,
                          std::vector<bool> &is_weight_list);
@@ -635,7 +757,8 @@ class GraphTable : public Table {
       std::unique_lock<std::mutex> lock(mutex_);
       if (use_cache == false) {
         scaled_lru.reset(new ScaledLRU<SampleKey, SampleResult>(
-            task_pool_size_, size_limit, ttl));
+            task_pool_size_, size_limit, ttl, cache_byte_limit));
+        cache_freq_sketch.assign(task_pool_size_, SampleFrequencySketch());
         use_cache = true;
       }
     }
@@ -693,6 +816,7 @@ class GraphTable : public Table {
   virtual int32_t build_sampler(int idx, std::string sample_type = "random");
   void set_feature_separator(const std::string &ch);
   std::vector<std::vector<GraphShard *>> edge_shards, feature_shards;
+  std::vector<std::vector<std::shared_ptr<GraphCSRShard>>> csr_shards;
   size_t shard_start, shard_end, server_num, shard_num_per_server, shard_num;
   int task_pool_size_ = 24;
   int load_thread_num = 160;
@@ -718,6 +842,13 @@ class GraphTable : public Table {
   bool use_cache, use_duplicate_nodes;
   int cache_size_limit;
   int cache_ttl;
+  // only the sample results of nodes with at least cache_min_degree
+  // neighbors that were queried at least cache_admit_frequency times
+  // recently are cached
+  int64_t cache_byte_limit = 0;
+  int cache_min_degree = 0;
+  int cache_admit_frequency = 0;
+  std::vector<SampleFrequencySketch> cache_freq_sketch;
   mutable std::mutex mutex_;
   bool build_sampler_on_cpu;
   std::shared_ptr<pthread_rwlock_t> rw_lock;
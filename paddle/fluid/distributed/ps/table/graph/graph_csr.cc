@@ -0,0 +1,380 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/table/graph/graph_csr.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <unordered_map>
+
+namespace paddle {
+namespace distributed {
+
+namespace {
+const uint64_t kGraphCSRMagic = 0x5253434850415247ULL;  // "GRAPHCSR"
+
+struct GraphCSRHeader {
+  uint64_t magic;
+  uint64_t node_num;
+  uint64_t edge_num;
+  uint32_t has_weight;
+  uint32_t has_alias;
+};
+
+// every array in the file starts at a multiple of 8 bytes
+inline size_t align8(size_t len) { return (len + 7) & ~size_t(7); }
+}  // namespace
+
+GraphCSRShard::~GraphCSRShard() {
+  if (mmap_addr_ != nullptr) {
+    munmap(mmap_addr_, mmap_len_);
+    mmap_addr_ = nullptr;
+  }
+}
+
+void GraphCSRShard::reset_pointers() {
+  keys_ = key_arr_.data();
+  offsets_ = offset_arr_.data();
+  neighbors_ = neighbor_arr_.data();
+  weights_ = weight_arr_.empty() ? nullptr : weight_arr_.data();
+  alias_prob_ = alias_prob_arr_.empty() ? nullptr : alias_prob_arr_.data();
+  alias_idx_ = alias_idx_arr_.empty() ? nullptr : alias_idx_arr_.data();
+}
+
+void GraphCSRShard::build(const std::vector<Node *> &nodes,
+                          bool build_alias) {
+  std::vector<Node *> sorted_nodes(nodes);
+  std::sort(sorted_nodes.begin(), sorted_nodes.end(), [](Node *a, Node *b) {
+    return a->get_id() < b->get_id();
+  });
+  node_num_ = sorted_nodes.size();
+  key_arr_.resize(node_num_);
+  offset_arr_.resize(node_num_ + 1);
+  offset_arr_[0] = 0;
+  for (size_t i = 0; i < node_num_; i++) {
+    key_arr_[i] = sorted_nodes[i]->get_id();
+    offset_arr_[i + 1] = offset_arr_[i] + sorted_nodes[i]->get_neighbor_size();
+  }
+  edge_num_ = offset_arr_[node_num_];
+  neighbor_arr_.resize(edge_num_);
+  weight_arr_.resize(edge_num_);
+  bool is_weighted = false;
+  for (size_t i = 0; i < node_num_; i++) {
+    Node *node = sorted_nodes[i];
+    size_t start = offset_arr_[i];
+    size_t degree = offset_arr_[i + 1] - start;
+    for (size_t j = 0; j < degree; j++) {
+      neighbor_arr_[start + j] = node->get_neighbor_id(j);
+      weight_arr_[start + j] = node->get_neighbor_weight(j);
+      is_weighted = is_weighted || weight_arr_[start + j] != 1.0;
+    }
+  }
+  if (!is_weighted) {
+    std::vector<float>().swap(weight_arr_);
+  }
+  alias_prob_arr_.clear();
+  alias_idx_arr_.clear();
+  if (is_weighted && build_alias) {
+    alias_prob_arr_.resize(edge_num_);
+    alias_idx_arr_.resize(edge_num_);
+    for (size_t i = 0; i < node_num_; i++) {
+      build_alias_table(offset_arr_[i], offset_arr_[i + 1]);
+    }
+  }
+  reset_pointers();
+}
+
+// Vose's alias method over the weights of one row.
+void GraphCSRShard::build_alias_table(size_t begin, size_t end) {
+  size_t n = end - begin;
+  if (n == 0) return;
+  double sum = 0;
+  for (size_t i = begin; i < end; i++) {
+    sum += weight_arr_[i] > 0 ? weight_arr_[i] : 0;
+  }
+  std::vector<double> scaled(n);
+  std::vector<uint32_t> small, large;
+  for (size_t i = 0; i < n; i++) {
+    double w = weight_arr_[begin + i] > 0 ? weight_arr_[begin + i] : 0;
+    scaled[i] = sum > 0 ? w * n / sum : 1.0;
+    if (scaled[i] < 1.0) {
+      small.push_back(i);
+    } else {
+      large.push_back(i);
+    }
+  }
+  while (!small.empty() && !large.empty()) {
+    uint32_t s = small.back();
+    uint32_t l = large.back();
+    small.pop_back();
+    alias_prob_arr_[begin + s] = scaled[s];
+    alias_idx_arr_[begin + s] = l;
+    scaled[l] = scaled[l] + scaled[s] - 1.0;
+    if (scaled[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  for (auto i : large) {
+    alias_prob_arr_[begin + i] = 1.0;
+    alias_idx_arr_[begin + i] = i;
+  }
+  for (auto i : small) {
+    alias_prob_arr_[begin + i] = 1.0;
+    alias_idx_arr_[begin + i] = i;
+  }
+}
+
+int32_t GraphCSRShard::save(const std::string &path) const {
+  std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open()) {
+    LOG(WARNING) << "GraphCSRShard save failed to open " << path;
+    return -1;
+  }
+  GraphCSRHeader header;
+  header.magic = kGraphCSRMagic;
+  header.node_num = node_num_;
+  header.edge_num = edge_num_;
+  header.has_weight = weights_ != nullptr;
+  header.has_alias = alias_prob_ != nullptr;
+  const char padding[8] = {0};
+  auto write_array = [&](const void *data, size_t len) {
+    ofs.write(reinterpret_cast<const char *>(data), len);
+    ofs.write(padding, align8(len) - len);
+  };
+  write_array(&header, sizeof(header));
+  write_array(keys_, node_num_ * sizeof(uint64_t));
+  write_array(offsets_, (node_num_ + 1) * sizeof(uint64_t));
+  write_array(neighbors_, edge_num_ * sizeof(uint64_t));
+  if (header.has_weight) {
+    write_array(weights_, edge_num_ * sizeof(float));
+  }
+  if (header.has_alias) {
+    write_array(alias_prob_, edge_num_ * sizeof(float));
+    write_array(alias_idx_, edge_num_ * sizeof(uint32_t));
+  }
+  ofs.close();
+  return ofs.good() ? 0 : -1;
+}
+
+int32_t GraphCSRShard::load(const std::string &path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG(WARNING) << "GraphCSRShard load failed to open " << path;
+    return -1;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(GraphCSRHeader)) {
+    LOG(WARNING) << "GraphCSRShard load got a bad file " << path;
+    close(fd);
+    return -1;
+  }
+  void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    LOG(WARNING) << "GraphCSRShard load failed to mmap " << path;
+    return -1;
+  }
+  const char *base = reinterpret_cast<const char *>(addr);
+  GraphCSRHeader header;
+  memcpy(&header, base, sizeof(header));
+  size_t expect_len = align8(sizeof(header)) +
+                      align8(header.node_num * sizeof(uint64_t)) +
+                      align8((header.node_num + 1) * sizeof(uint64_t)) +
+                      align8(header.edge_num * sizeof(uint64_t));
+  if (header.has_weight) {
+    expect_len += align8(header.edge_num * sizeof(float));
+  }
+  if (header.has_alias) {
+    expect_len += align8(header.edge_num * sizeof(float)) +
+                  align8(header.edge_num * sizeof(uint32_t));
+  }
+  if (header.magic != kGraphCSRMagic || expect_len != (size_t)st.st_size) {
+    LOG(WARNING) << "GraphCSRShard load got a corrupted file " << path;
+    munmap(addr, st.st_size);
+    return -1;
+  }
+
+  if (mmap_addr_ != nullptr) {
+    munmap(mmap_addr_, mmap_len_);
+  }
+  key_arr_.clear();
+  offset_arr_.clear();
+  neighbor_arr_.clear();
+  weight_arr_.clear();
+  alias_prob_arr_.clear();
+  alias_idx_arr_.clear();
+  mmap_addr_ = addr;
+  mmap_len_ = st.st_size;
+  node_num_ = header.node_num;
+  edge_num_ = header.edge_num;
+
+  size_t pos = align8(sizeof(header));
+  auto next_array = [&](size_t len) {
+    const char *p = base + pos;
+    pos += align8(len);
+    return p;
+  };
+  keys_ = reinterpret_cast<const uint64_t *>(
+      next_array(node_num_ * sizeof(uint64_t)));
+  offsets_ = reinterpret_cast<const uint64_t *>(
+      next_array((node_num_ + 1) * sizeof(uint64_t)));
+  neighbors_ = reinterpret_cast<const uint64_t *>(
+      next_array(edge_num_ * sizeof(uint64_t)));
+  weights_ = header.has_weight ? reinterpret_cast<const float *>(
+                                     next_array(edge_num_ * sizeof(float)))
+                               : nullptr;
+  alias_prob_ = nullptr;
+  alias_idx_ = nullptr;
+  if (header.has_alias) {
+    alias_prob_ =
+        reinterpret_cast<const float *>(next_array(edge_num_ * sizeof(float)));
+    alias_idx_ = reinterpret_cast<const uint32_t *>(
+        next_array(edge_num_ * sizeof(uint32_t)));
+  }
+  return 0;
+}
+
+int64_t GraphCSRShard::find_row(uint64_t id) const {
+  const uint64_t *end = keys_ + node_num_;
+  const uint64_t *iter = std::lower_bound(keys_, end, id);
+  if (iter == end || *iter != id) {
+    return -1;
+  }
+  return iter - keys_;
+}
+
+void GraphCSRShard::write_neighbor(size_t edge,
+                                   bool need_weight,
+                                   char *&out) const {
+  memcpy(out, neighbors_ + edge, Node::id_size);
+  out += Node::id_size;
+  if (need_weight) {
+    float weight = weights_ != nullptr ? weights_[edge] : 1.0;
+    memcpy(out, &weight, Node::weight_size);
+    out += Node::weight_size;
+  }
+}
+
+// Every draw picks one of the edges not drawn yet with probability
+// proportional to its weight, the same distribution as WeightedSampler. A
+// draw from the alias table that hits a drawn edge is retried, the accepted
+// edge still follows that distribution. Rows where the retries keep failing
+// (a few heavy edges already drawn) fall back to a scan over the remaining
+// weights.
+void GraphCSRShard::sample_weighted(size_t begin,
+                                    int n,
+                                    int k,
+                                    std::mt19937_64 *rng,
+                                    std::vector<int> *picked) const {
+  const int max_try = 8;
+  std::uniform_int_distribution<int> col_distrib(0, n - 1);
+  std::uniform_real_distribution<double> prob_distrib(0, 1);
+  thread_local std::vector<int> sorted_picked;
+  sorted_picked.clear();
+  while ((int)picked->size() < k) {
+    int x = -1;
+    for (int i = 0; alias_prob_ != nullptr && x < 0 && i < max_try; i++) {
+      int col = col_distrib(*rng);
+      int y = prob_distrib(*rng) < alias_prob_[begin + col]
+                  ? col
+                  : alias_idx_[begin + col];
+      if (std::find(picked->begin(), picked->end(), y) == picked->end()) {
+        x = y;
+      }
+    }
+    if (x < 0) {
+      // walk the edges not drawn yet, sorted_picked is kept in order so it
+      // is merged in one pass
+      double remain = 0;
+      int remain_num = 0;
+      auto iter = sorted_picked.begin();
+      for (int i = 0; i < n; i++) {
+        if (iter != sorted_picked.end() && *iter == i) {
+          ++iter;
+          continue;
+        }
+        remain += std::max(weights_[begin + i], 0.0f);
+        remain_num++;
+      }
+      // only zero weights are left, pick one of them uniformly
+      bool uniform = remain <= 0;
+      double query = uniform ? std::uniform_int_distribution<int>(
+                                   0, remain_num - 1)(*rng)
+                             : prob_distrib(*rng) * remain;
+      iter = sorted_picked.begin();
+      for (int i = 0; i < n; i++) {
+        if (iter != sorted_picked.end() && *iter == i) {
+          ++iter;
+          continue;
+        }
+        x = i;
+        query -= uniform ? 1 : std::max(weights_[begin + i], 0.0f);
+        if (query < 0) break;
+      }
+    }
+    picked->push_back(x);
+    sorted_picked.insert(
+        std::upper_bound(sorted_picked.begin(), sorted_picked.end(), x), x);
+  }
+}
+
+int GraphCSRShard::sample(int64_t row,
+                          int k,
+                          bool need_weight,
+                          std::mt19937_64 *rng,
+                          char *out) const {
+  size_t begin = offsets_[row];
+  int n = offsets_[row + 1] - begin;
+  if (k >= n) {
+    for (int i = 0; i < n; i++) {
+      write_neighbor(begin + i, need_weight, out);
+    }
+    return n;
+  }
+  thread_local std::vector<int> picked;
+  picked.clear();
+  if (weights_ != nullptr) {
+    sample_weighted(begin, n, k, rng, &picked);
+  } else {
+    // partial Fisher-Yates shuffle, same as RandomSampler
+    thread_local std::unordered_map<int, int> replace_map;
+    replace_map.clear();
+    int remain = n;
+    for (int i = 0; i < k; i++) {
+      std::uniform_int_distribution<int> distrib(0, remain - 1);
+      int rand_int = distrib(*rng);
+      auto iter = replace_map.find(rand_int);
+      picked.push_back(iter == replace_map.end() ? rand_int : iter->second);
+      iter = replace_map.find(remain - 1);
+      replace_map[rand_int] =
+          iter == replace_map.end() ? remain - 1 : iter->second;
+      --remain;
+    }
+  }
+  for (int x : picked) {
+    write_neighbor(begin + x, need_weight, out);
+  }
+  return picked.size();
+}
+
+}  // namespace distributed
+}  // namespace paddle
@@ -0,0 +1,108 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "paddle/fluid/distributed/ps/table/graph/graph_node.h"
+namespace paddle {
+namespace distributed {
+
+/*
+ * Read-only columnar (CSR) copy of the edges of one graph shard.
+ *
+ * keys:       sorted source node ids, one row per node
+ * offsets:    row i owns neighbors [offsets[i], offsets[i + 1])
+ * neighbors:  destination node ids
+ * weights:    edge weights, empty when the shard is unweighted
+ * alias_prob / alias_idx: per-row alias tables over the edge weights,
+ *             used by weighted sampling
+ *
+ * A shard is either built from the in-memory nodes or loaded from a binary
+ * file written by save(). A loaded shard mmaps the file and points into it,
+ * so no copy of the arrays is made.
+ */
+class GraphCSRShard {
+ public:
+  GraphCSRShard() {}
+  ~GraphCSRShard();
+  GraphCSRShard(const GraphCSRShard &) = delete;
+  GraphCSRShard &operator=(const GraphCSRShard &) = delete;
+
+  // weights are kept only when some edge has a weight other than 1
+  void build(const std::vector<Node *> &nodes, bool build_alias);
+  int32_t save(const std::string &path) const;
+  int32_t load(const std::string &path);
+
+  size_t node_size() const { return node_num_; }
+  size_t edge_size() const { return edge_num_; }
+  bool is_weighted() const { return weights_ != nullptr; }
+  // row of id in keys, -1 if id has no edges in this shard
+  int64_t find_row(uint64_t id) const;
+  size_t degree(int64_t row) const {
+    return offsets_[row + 1] - offsets_[row];
+  }
+  uint64_t get_key(int64_t row) const { return keys_[row]; }
+  // edges of row are [row_begin(row), row_begin(row) + degree(row))
+  size_t row_begin(int64_t row) const { return offsets_[row]; }
+  uint64_t get_neighbor_id(size_t edge) const { return neighbors_[edge]; }
+  float get_neighbor_weight(size_t edge) const {
+    return weights_ != nullptr ? weights_[edge] : 1.0;
+  }
+
+  // Samples at most k distinct neighbors of row and writes them to out as
+  // [id (Node::id_size bytes), weight (Node::weight_size bytes)]*, the same
+  // layout GraphTable::random_sample_neighbors returns. Returns the number
+  // of neighbors written.
+  int sample(int64_t row,
+             int k,
+             bool need_weight,
+             std::mt19937_64 *rng,
+             char *out) const;
+
+ private:
+  void reset_pointers();
+  void build_alias_table(size_t begin, size_t end);
+  void write_neighbor(size_t edge, bool need_weight, char *&out) const;
+  void sample_weighted(size_t begin,
+                       int n,
+                       int k,
+                       std::mt19937_64 *rng,
+                       std::vector<int> *picked) const;
+
+  size_t node_num_ = 0;
+  size_t edge_num_ = 0;
+  const uint64_t *keys_ = nullptr;
+  const uint64_t *offsets_ = nullptr;
+  const uint64_t *neighbors_ = nullptr;
+  const float *weights_ = nullptr;
+  const float *alias_prob_ = nullptr;
+  const uint32_t *alias_idx_ = nullptr;
+
+  // storage for a shard built in memory
+  std::vector<uint64_t> key_arr_, offset_arr_, neighbor_arr_;
+  std::vector<float> weight_arr_, alias_prob_arr_;
+  std::vector<uint32_t> alias_idx_arr_;
+
+  // mapping for a shard loaded from file
+  void *mmap_addr_ = nullptr;
+  size_t mmap_len_ = 0;
+};
+}  // namespace distributed
+}  // namespace paddle
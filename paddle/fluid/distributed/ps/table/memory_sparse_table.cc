@@ -74,6 +74,11 @@ int32_t MemorySparseTable::InitializeValue() {
           << " _task_pool_size:" << _task_pool_size;
 
   _local_shards.reset(new shard_type[_real_local_shard_num]);
+  if (_config.enable_delta_track()) {
+    _local_dirty_keys.reset(
+        new std::unordered_set<uint64_t>[_real_local_shard_num]);
+    _dirty_keys_valid = true;
+  }
 
   if (_config.enable_revert()) {
     // calculate merged shard number based on config param;
@@ -194,6 +199,8 @@ int32_t MemorySparseTable::Load(const std::string& path,
       }
     } while (is_read_failed);
   }
+  // loaded keys may carry delta scores that are not tracked as dirty
+  _dirty_keys_valid = false;
   LOG(INFO) << "MemorySparseTable load success, path from "
             << file_list[file_start_idx] << " to "
             << file_list[file_start_idx + _real_local_shard_num - 1];
@@ -329,6 +336,10 @@ int32_t MemorySparseTable::Save(const std::string& dirname,
     return 0;
   }
 
+  // delta model, only visit the keys pushed since the last delta save
+  bool save_dirty_only =
+      _config.enable_delta_track() && save_param == 1 && _dirty_keys_valid;
+
   // cache model
   int64_t tk_size = LocalSize() * _config.sparse_table_cache_rate();
   TopkCalculator tk(_real_local_shard_num, tk_size);
@@ -375,28 +386,41 @@ int32_t MemorySparseTable::Save(const std::string& dirname,
       is_write_failed = false;
       auto write_channel =
           _afs_client.open_w(channel_config, 1024 * 1024 * 40, &err_no);
-      for (auto it = shard.begin(); it != shard.end(); ++it) {
-        if (_config.enable_sparse_table_cache() &&
+      // return false if write failed
+      auto save_value = [&](uint64_t key, FixedFeatureValue& value) -> bool {
+        if (!save_dirty_only && _config.enable_sparse_table_cache() &&
             (save_param == 1 || save_param == 2) &&
-            _value_accesor->Save(it.value().data(), 4)) {
+            _value_accesor->Save(value.data(), 4)) {
           CostTimer timer10("sprase table top push");
-          tk.push(i, _value_accesor->GetField(it.value().data(), "show"));
+          tk.push(i, _value_accesor->GetField(value.data(), "show"));
         }
 
-        if (_value_accesor->Save(it.value().data(), save_param)) {
-          std::string format_value = _value_accesor->ParseToString(
-              it.value().data(), it.value().size());
+        if (_value_accesor->Save(value.data(), save_param)) {
+          std::string format_value =
+              _value_accesor->ParseToString(value.data(), value.size());
           if (0 != write_channel->write_line(paddle::string::format_string(
-                       "%lu %s", it.key(), format_value.c_str()))) {
+                       "%lu %s", key, format_value.c_str()))) {
             ++retry_num;
             is_write_failed = true;
             LOG(ERROR)
                 << "MemorySparseTable save prefix failed, retry it! path:"
                 << channel_config.path << " , retry_num=" << retry_num;
-            break;
+            return false;
           }
           ++feasign_size;
         }
+        return true;
+      };
+      if (save_dirty_only) {
+        for (auto key : _local_dirty_keys[i]) {
+          auto it = shard.find(key);
+          if (it == shard.end()) continue;
+          if (!save_value(key, it.value())) break;
+        }
+      } else {
+        for (auto it = shard.begin(); it != shard.end(); ++it) {
+          if (!save_value(it.key(), it.value())) break;
+        }
       }
       write_channel->close();
       if (err_no == -1) {
@@ -415,13 +439,31 @@ int32_t MemorySparseTable::Save(const std::string& dirname,
       }
     } while (is_write_failed);
     feasign_size_all += feasign_size;
-    for (auto it = shard.begin(); it != shard.end(); ++it) {
-      _value_accesor->UpdateStatAfterSave(it.value().data(), save_param);
+    if (save_dirty_only) {
+      for (auto key : _local_dirty_keys[i]) {
+        auto it = shard.find(key);
+        if (it == shard.end()) continue;
+        _value_accesor->UpdateStatAfterSave(it.value().data(), save_param);
+      }
+    } else {
+      for (auto it = shard.begin(); it != shard.end(); ++it) {
+        _value_accesor->UpdateStatAfterSave(it.value().data(), save_param);
+      }
+    }
+    if (_config.enable_delta_track() && save_param == 1) {
+      _local_dirty_keys[i].clear();
     }
     LOG(INFO) << "MemorySparseTable save prefix success, path: "
-              << channel_config.path << " feasign_size: " << feasign_size;
+              << channel_config.path << " feasign_size: " << feasign_size
+              << " dirty_only: " << save_dirty_only;
+  }
+  if (_config.enable_delta_track() && save_param == 1) {
+    _dirty_keys_valid = true;
+  }
+  // a dirty only save does not see all the keys, keep the last threshold
+  if (!save_dirty_only) {
+    _local_show_threshold = tk.top();
   }
-  _local_show_threshold = tk.top();
   // int32 may overflow need to change return value
   return 0;
 }
@@ -796,6 +838,11 @@ int32_t MemorySparseTable::PullSparse(float* pull_values,
                     _value_accesor->Create(&data_buffer_ptr, 1);
                     memcpy(
                         data_ptr, data_buffer_ptr, data_size * sizeof(float));
+                    // a created key is saved by a full scan, even if it is
+                    // never pushed
+                    if (_config.enable_delta_track()) {
+                      _local_dirty_keys[shard_id].insert(key);
+                    }
                   }
                 } else {
                   data_size = itr.value().size();
@@ -867,6 +914,10 @@ int32_t MemorySparseTable::PullSparsePtr(char** pull_values,
                 } else {
                   ret = itr.value_ptr();
                 }
+                // the caller may update the value through the pointer
+                if (_config.enable_delta_track()) {
+                  _local_dirty_keys[shard_id].insert(key);
+                }
                 int pull_data_idx = keys[i].second;
                 pull_values[pull_data_idx] = reinterpret_cast<char*>(ret);
               }
@@ -951,6 +1002,9 @@ int32_t MemorySparseTable::PushSparse(const uint64_t* keys,
               }
               memcpy(value_data, data_buffer_ptr, value_size * sizeof(float));
             }
+            if (_config.enable_delta_track()) {
+              _local_dirty_keys[shard_id].insert(key);
+            }
             if (_config.enable_revert()) {
               FixedFeatureValue* feature_value_new = &(local_shard_new[key]);
               auto new_size = feature_value.size();
@@ -1035,6 +1089,9 @@ int32_t MemorySparseTable::PushSparse(const uint64_t* keys,
               }
               memcpy(value_data, data_buffer_ptr, value_size * sizeof(float));
             }
+            if (_config.enable_delta_track()) {
+              _local_dirty_keys[shard_id].insert(key);
+            }
           }
           return 0;
         });
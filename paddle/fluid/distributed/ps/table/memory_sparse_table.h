@@ -22,6 +22,7 @@
 #include <mutex>  // NOLINT
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -129,6 +130,12 @@ class MemorySparseTable : public Table {
   std::unique_ptr<shard_type[]> _local_shards_new;
   std::unique_ptr<shard_type[]> _local_shards_patch_model;
   std::thread _save_patch_model_thread;
+
+  // for delta model, keys pushed or created since the last xbox delta save
+  // per shard. They are not valid after Load, the next delta save scans all
+  // keys.
+  std::unique_ptr<std::unordered_set<uint64_t>[]> _local_dirty_keys;
+  bool _dirty_keys_valid{false};
 };
 
 }  // namespace distributed
@@ -46,6 +46,45 @@ class Store {
         "Implement the add method in the subclass."));
   }
 
+  // Fails if a key is not set, call multi_wait first to block until all the
+  // keys are set.
+  virtual std::vector<std::vector<uint8_t>> multi_get(
+      const std::vector<std::string>& keys) {
+    std::vector<std::vector<uint8_t>> values;
+    for (auto& key : keys) {
+      values.emplace_back(get(key));
+    }
+    return values;
+  }
+  virtual void multi_set(const std::vector<std::string>& keys,
+                         const std::vector<std::vector<uint8_t>>& values) {
+    PADDLE_ENFORCE_EQ(keys.size(),
+                      values.size(),
+                      platform::errors::InvalidArgument(
+                          "The number of keys (%d) and values (%d) of "
+                          "multi_set must be equal.",
+                          keys.size(),
+                          values.size()));
+    for (size_t i = 0; i < keys.size(); ++i) {
+      set(keys[i], values[i]);
+    }
+  }
+  virtual void multi_wait(const std::vector<std::string>& keys) {
+    for (auto& key : keys) {
+      wait(key);
+    }
+  }
+  // Sets key to desired if its value is expected. An empty expected matches
+  // both a key that is absent and a key that holds an empty value. Returns
+  // the value of key after the call, empty if the key is still absent.
+  virtual std::vector<uint8_t> compare_set(
+      const std::string& key,
+      const std::vector<uint8_t>& expected,
+      const std::vector<uint8_t>& desired) {
+    PADDLE_THROW(platform::errors::InvalidArgument(
+        "Implement the compare_set method in the subclass."));
+  }
+
   virtual int timeout() { return _timeout; }
 
  protected:
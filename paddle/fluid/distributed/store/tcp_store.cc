@@ -14,10 +14,15 @@
 
 #include "paddle/fluid/distributed/store/tcp_store.h"
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <thread>
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
 #include "paddle/fluid/distributed/store/tcp_utils.h"
 #include "paddle/fluid/platform/enforce.h"
 #include "paddle/fluid/platform/flags.h"
@@ -28,6 +33,10 @@ namespace distributed {
 namespace detail {
 
 constexpr int INFTIME = 10000;  // 10 seconds
+#ifdef __linux__
+constexpr int kMaxEventNum = 64;
+constexpr unsigned kMaxMasterThreadNum = 8;
+#endif
 
 std::unique_ptr<MasterDaemon> MasterDaemon::start(SocketType socket,
                                                   int nranks,
@@ -39,38 +48,95 @@ std::unique_ptr<MasterDaemon> MasterDaemon::start(SocketType socket,
 MasterDaemon::MasterDaemon(SocketType socket, int nranks, int timeout)
     : _listen_socket(socket), _nranks(nranks), _timeout(timeout) {
   InitControlFd();
-  _background_thread = std::thread{&MasterDaemon::run, this};
+#ifdef __linux__
+  _epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+  PADDLE_ENFORCE_NE(
+      _epoll_fd,
+      -1,
+      platform::errors::Fatal("failed to create epoll fd errno:%d", errno));
+  // the control pipe is level triggered so that it stops every thread
+  struct epoll_event event {};
+  event.events = EPOLLIN;
+  event.data.fd = _control_fd[0];
+  PADDLE_ENFORCE_NE(
+      ::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _control_fd[0], &event),
+      -1,
+      platform::errors::Fatal("failed to watch control pipe errno:%d", errno));
+  WatchSocket(_listen_socket, true);
+  unsigned thread_num = std::max(
+      1u, std::min(std::thread::hardware_concurrency(), kMaxMasterThreadNum));
+#else
+  unsigned thread_num = 1;
+#endif
+  for (unsigned i = 0; i < thread_num; ++i) {
+    _background_threads.emplace_back(&MasterDaemon::run, this);
+  }
 }
 
 MasterDaemon::~MasterDaemon() {
   VLOG(4) << ("begin to destruct MasterDaemon");
   StopByControlFd();
-  _background_thread.join();
+  for (auto& thread : _background_threads) {
+    thread.join();
+  }
   tcputils::close_socket(_listen_socket);
   for (SocketType socket : _sockets) {
     tcputils::close_socket(socket);
   }
+#ifdef __linux__
+  ::close(_epoll_fd);
+#endif
   CloseControlFd();
 }
 
+void MasterDaemon::_set_value(const std::string& key,
+                              std::vector<uint8_t> value,
+                              std::vector<SocketType>* ready) {
+  _store[key] = std::move(value);
+  auto iter = _waiting_sockets.find(key);
+  if (iter != _waiting_sockets.end()) {
+    ready->insert(ready->end(), iter->second.begin(), iter->second.end());
+    _waiting_sockets.erase(iter);
+  }
+}
+
+void MasterDaemon::_wake_up(const std::vector<SocketType>& ready) {
+#ifdef __linux__
+  for (SocketType socket : ready) {
+    try {
+      tcputils::send_value<ReplyType>(socket, ReplyType::STOP_WAIT);
+    } catch (const std::exception& ex) {
+      VLOG(3) << "Meet some exceptions during wake up:" << ex.what();
+      CloseSocket(socket);
+      continue;
+    }
+    WatchSocket(socket, false);
+  }
+#endif
+}
+
 void MasterDaemon::_do_add(SocketType socket) {
   int64_t new_value{};
   std::string key = tcputils::receive_string(socket);
   new_value = tcputils::receive_value<int64_t>(socket);
-  std::vector<uint8_t> old_value;
-  auto it = _store.find(key);
-  if (it != _store.end()) {
-    old_value = it->second;
-    char* buffer = reinterpret_cast<char*>(it->second.data());
-    size_t len = old_value.size();
-    new_value += std::stoll(std::string(buffer, len));
-  }
+  std::vector<SocketType> ready;
+  {
+    std::lock_guard<std::mutex> lock(_store_mutex);
+    auto it = _store.find(key);
+    if (it != _store.end()) {
+      char* buffer = reinterpret_cast<char*>(it->second.data());
+      size_t len = it->second.size();
+      new_value += std::stoll(std::string(buffer, len));
+    }
 
-  std::string new_value_str = std::to_string(new_value);
-  _store[key] =
-      std::vector<uint8_t>(new_value_str.begin(), new_value_str.end());
+    std::string new_value_str = std::to_string(new_value);
+    _set_value(key,
+               std::vector<uint8_t>(new_value_str.begin(), new_value_str.end()),
+               &ready);
+  }
   VLOG(4) << "TCPStore: new value (" << new_value << ") for key (" << key
           << ") " << GetSockName(socket);
+  _wake_up(ready);
   tcputils::send_value<int64_t>(socket, new_value);
 }
 
@@ -79,33 +145,117 @@ void MasterDaemon::_do_set(SocketType socket) {
   VLOG(4) << "MasterDaemon::_do_set key(" << key << ") " << GetSockName(socket);
 
   auto value = tcputils::receive_vector<uint8_t>(socket);
-  _store[key] = value;
+  std::vector<SocketType> ready;
+  {
+    std::lock_guard<std::mutex> lock(_store_mutex);
+    _set_value(key, std::move(value), &ready);
+  }
+  _wake_up(ready);
 }
 
 void MasterDaemon::_do_get(SocketType socket) {
   std::string key = tcputils::receive_string(socket);
   VLOG(4) << "MasterDaemon::_do_get key(" << key << ") " << GetSockName(socket);
 
-  auto iter = _store.find(key);
-  PADDLE_ENFORCE_NE(
-      iter,
-      _store.end(),
-      platform::errors::InvalidArgument("Key %s not found in TCPStore.", key));
-  std::vector<uint8_t> value = iter->second;
+  std::vector<uint8_t> value;
+  {
+    std::lock_guard<std::mutex> lock(_store_mutex);
+    auto iter = _store.find(key);
+    PADDLE_ENFORCE_NE(
+        iter,
+        _store.end(),
+        platform::errors::InvalidArgument("Key %s not found in TCPStore.",
+                                          key));
+    value = iter->second;
+  }
   tcputils::send_vector<uint8_t>(socket, value);
 }
 
+void MasterDaemon::_do_multi_get(SocketType socket) {
+  size_t num = tcputils::receive_value<size_t>(socket);
+  std::vector<std::string> keys(num);
+  for (auto& key : keys) {
+    key = tcputils::receive_string(socket);
+  }
+  VLOG(4) << "MasterDaemon::_do_multi_get " << num << " keys "
+          << GetSockName(socket);
+
+  // every value follows a found flag, missing keys are reported by the client
+  tcputils::SendBuffer buffer;
+  {
+    std::lock_guard<std::mutex> lock(_store_mutex);
+    for (auto& key : keys) {
+      auto iter = _store.find(key);
+      bool found = iter != _store.end();
+      buffer.append_value<bool>(found);
+      if (found) {
+        buffer.append_vector<uint8_t>(iter->second);
+      }
+    }
+  }
+  buffer.flush(socket);
+}
+
+void MasterDaemon::_do_multi_set(SocketType socket) {
+  size_t num = tcputils::receive_value<size_t>(socket);
+  std::vector<std::string> keys(num);
+  std::vector<std::vector<uint8_t>> values(num);
+  for (size_t i = 0; i < num; ++i) {
+    keys[i] = tcputils::receive_string(socket);
+    values[i] = tcputils::receive_vector<uint8_t>(socket);
+  }
+  VLOG(4) << "MasterDaemon::_do_multi_set " << num << " keys "
+          << GetSockName(socket);
+
+  std::vector<SocketType> ready;
+  {
+    std::lock_guard<std::mutex> lock(_store_mutex);
+    for (size_t i = 0; i < num; ++i) {
+      _set_value(keys[i], std::move(values[i]), &ready);
+    }
+  }
+  _wake_up(ready);
+}
+
+void MasterDaemon::_do_compare_set(SocketType socket) {
+  std::string key = tcputils::receive_string(socket);
+  auto expected = tcputils::receive_vector<uint8_t>(socket);
+  auto desired = tcputils::receive_vector<uint8_t>(socket);
+  VLOG(4) << "MasterDaemon::_do_compare_set key(" << key << ") "
+          << GetSockName(socket);
+
+  std::vector<uint8_t> current;
+  std::vector<SocketType> ready;
+  {
+    std::lock_guard<std::mutex> lock(_store_mutex);
+    auto iter = _store.find(key);
+    bool matched =
+        iter == _store.end() ? expected.empty() : iter->second == expected;
+    if (matched) {
+      current = desired;
+      _set_value(key, std::move(desired), &ready);
+    } else if (iter != _store.end()) {
+      current = iter->second;
+    }
+  }
+  _wake_up(ready);
+  tcputils::send_vector<uint8_t>(socket, current);
+}
+
 void MasterDaemon::_do_stop(SocketType socket) {
   VLOG(4) << "MasterDaemon::_do_stop " << GetSockName(socket);
-  if (!_has_stop) {
-    _stop_time = std::chrono::system_clock::now();
+  {
+    std::lock_guard<std::mutex> lock(_store_mutex);
+    if (!_has_stop) {
+      _stop_time = std::chrono::system_clock::now();
+    }
+    _has_stop = true;
+    if (--_nranks == 0) {
+      _stop = true;
+    }
   }
-  _has_stop = true;
   ReplyType value = ReplyType::STOP_WAIT;
   tcputils::send_value<ReplyType>(socket, value);
-  if (--_nranks == 0) {
-    _stop = true;
-  }
 }
 
 #ifndef _WIN32
@@ -140,100 +290,168 @@ void MasterDaemon::CloseControlFd() {}
 void MasterDaemon::StopByControlFd() {}
 #endif
 
-void MasterDaemon::_do_wait(SocketType socket) {
+bool MasterDaemon::_do_wait(SocketType socket) {
   std::string key = tcputils::receive_string(socket);
   VLOG(4) << "MasterDaemon::_do_wait key(" << key << ") "
           << GetSockName(socket);
 
-  auto iter = _store.find(key);
   auto reply = ReplyType::STOP_WAIT;
-  if (iter == _store.end()) {
-    reply = ReplyType::WAITING;
+  {
+    std::lock_guard<std::mutex> lock(_store_mutex);
+    if (_store.find(key) == _store.end()) {
+#ifdef __linux__
+      // the socket is parked, _wake_up answers it when key is set
+      _waiting_sockets[key].push_back(socket);
+      return false;
+#else
+      reply = ReplyType::WAITING;
+#endif
+    }
   }
   VLOG(3) << "TCPStore: wait reply (" << static_cast<int>(reply)
           << ") for key (" << key << ").";
   tcputils::send_value<ReplyType>(socket, reply);
+  return true;
 }
 
-void MasterDaemon::ProcessCommands(std::vector<struct pollfd>* p_fds) {
-  std::vector<struct pollfd>& fds = *p_fds;
-  // FIXME(gongwb): Don't loop all fds of set just the fds who have event.
-#ifdef _WIN32
-  // 0: listen socket, so loop from 1.
-  for (size_t i = 1; i < fds.size(); i++) {
-#else
-  // 0: listen socket, 1:controller pipe, so loop from 2.
-  for (size_t i = 2; i < fds.size(); i++) {
-#endif
-    try {
-      if (fds[i].revents == 0) {
-        continue;
-      }
+bool MasterDaemon::ProcessCommand(SocketType socket) {
+  try {
+    Command command = tcputils::receive_value<Command>(socket);
+    VLOG(3) << "TCPStore: recv command: " << static_cast<int>(command) << ".";
+
+    switch (command) {
+      case Command::ADD:
+        _do_add(socket);
+        break;
+      case Command::GET:
+        _do_get(socket);
+        break;
+      case Command::SET:
+        _do_set(socket);
+        break;
+      case Command::WAIT:
+        return _do_wait(socket);
+      case Command::STOP:
+        _do_stop(socket);
+        break;
+      case Command::MULTI_GET:
+        _do_multi_get(socket);
+        break;
+      case Command::MULTI_SET:
+        _do_multi_set(socket);
+        break;
+      case Command::COMPARE_SET:
+        _do_compare_set(socket);
+        break;
+      default:
+        LOG(WARNING) << "Unknown command: " << static_cast<int>(command)
+                     << " from addr info:" << GetSockName(socket);
+    }
+  } catch (const std::exception& ex) {
+    CloseSocket(socket);
+    VLOG(3) << "Meet some exceptions during run:" << ex.what();
+    return false;
+  }
+  return true;
+}
 
-      Command command = tcputils::receive_value<Command>(fds[i].fd);
-      VLOG(3) << "TCPStore: recv command: " << static_cast<int>(command) << ".";
-
-      switch (command) {
-        case Command::ADD:
-          _do_add(fds[i].fd);
-          break;
-        case Command::GET:
-          _do_get(fds[i].fd);
-          break;
-        case Command::SET:
-          _do_set(fds[i].fd);
-          break;
-        case Command::WAIT:
-          _do_wait(fds[i].fd);
-          break;
-        case Command::STOP:
-          _do_stop(fds[i].fd);
-          break;
-        default:
-          LOG(WARNING) << "Unknown command: " << static_cast<int>(command)
-                       << " from addr info:" << GetSockName(fds[i].fd);
-      }
-    } catch (const std::exception& ex) {
-      tcputils::close_socket(fds[i].fd);
-      fds.erase(fds.begin() + i);
-#ifdef _WIN32
-      _sockets.erase(_sockets.begin() + i - 1);
-#else
-      _sockets.erase(_sockets.begin() + i - 2);
-#endif
+void MasterDaemon::CloseSocket(SocketType socket) {
+  {
+    std::lock_guard<std::mutex> lock(_store_mutex);
+    _sockets.erase(std::remove(_sockets.begin(), _sockets.end(), socket),
+                   _sockets.end());
+  }
+  tcputils::close_socket(socket);
+}
 
-      VLOG(3) << "Meet some exceptions during run:" << ex.what();
+void MasterDaemon::CheckStopTimeout() {
+  int elapsed_seconds = 0;
+  {
+    std::lock_guard<std::mutex> lock(_store_mutex);
+    if (!_has_stop) {
+      return;
     }
+    std::chrono::duration<double> diff =
+        std::chrono::system_clock::now() - _stop_time;
+    elapsed_seconds = static_cast<int>(diff.count());
   }
+  PADDLE_ENFORCE_LT(
+      elapsed_seconds,
+      _timeout,
+      platform::errors::Fatal(
+          "%d seconds elapsed after the first worker "
+          "stopped, so we think there may be something wrong and will "
+          "stop the master worker. You can use "
+          "'export FLAGS_stop_check_timeout=3600'"
+          " to change the timeout value in seconds. The default one is 900",
+          elapsed_seconds));
+}
+
+#ifdef __linux__
+void MasterDaemon::WatchSocket(SocketType socket, bool is_new) {
+  // one shot, so only one thread serves a socket until it is watched again
+  struct epoll_event event {};
+  event.events = EPOLLIN | EPOLLONESHOT;
+  event.data.fd = socket;
+  PADDLE_ENFORCE_NE(
+      ::epoll_ctl(
+          _epoll_fd, is_new ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, socket, &event),
+      -1,
+      platform::errors::Fatal(
+          "failed to watch socket %d errno:%d", socket, errno));
 }
 
+void MasterDaemon::run() {
+  VLOG(4) << "begin to run run _stop:" << _stop << " _has_stop:" << _has_stop;
+  std::array<struct epoll_event, kMaxEventNum> events;
+  while (!_stop) {
+    CheckStopTimeout();
+
+    int num = ::epoll_wait(_epoll_fd, events.data(), events.size(), INFTIME);
+    for (int i = 0; i < num; ++i) {
+      int fd = events[i].data.fd;
+      // The control pipe receive shutdown event, and begin to close it.
+      if (fd == _control_fd[0]) {
+        VLOG(0)
+            << "receive shutdown event and so quit from MasterDaemon run loop";
+        _stop = true;
+        break;
+      }
+      // accept connect request.
+      if (fd == _listen_socket) {
+        auto socket = tcputils::tcp_accept(_listen_socket);
+        {
+          std::lock_guard<std::mutex> lock(_store_mutex);
+          _sockets.emplace_back(socket);
+        }
+        WatchSocket(socket, true);
+        WatchSocket(_listen_socket, false);
+        continue;
+      }
+      if (ProcessCommand(fd)) {
+        WatchSocket(fd, false);
+      }
+    }
+  }
+}
+#else
 void MasterDaemon::run() {
   VLOG(4) << "begin to run run _stop:" << _stop << " _has_stop:" << _has_stop;
   std::vector<struct pollfd> fds;
 #ifdef _WIN32
   fds.push_back({_listen_socket, POLLIN});
+  // 0: listen socket, so loop from 1.
+  const size_t first_socket = 1;
 #else
   fds.push_back({.fd = _listen_socket, .events = POLLIN, .revents = 0});
   fds.push_back(
       {.fd = _control_fd[0], .events = POLLIN | POLLHUP, .revents = 0});
+  // 0: listen socket, 1:controller pipe, so loop from 2.
+  const size_t first_socket = 2;
 #endif
 
   while (!_stop) {
-    auto end_time = std::chrono::system_clock::now();
-    if (_has_stop) {
-      std::chrono::duration<double> diff = end_time - _stop_time;
-      int elapsed_seconds = static_cast<int>(diff.count());
-      PADDLE_ENFORCE_LT(
-          elapsed_seconds,
-          _timeout,
-          platform::errors::Fatal(
-              "%d seconds elapsed after the first worker "
-              "stopped, so we think there may be something wrong and will "
-              "stop the master worker. You can use "
-              "'export FLAGS_stop_check_timeout=3600'"
-              " to change the timeout value in seconds. The default one is 900",
-              elapsed_seconds));
-    }
+    CheckStopTimeout();
 
     for (size_t i = 0; i < fds.size(); i++) {
       fds[i].revents = 0;
@@ -264,7 +482,10 @@ void MasterDaemon::run() {
     // accept connect request.
     if (fds[0].revents != 0) {
       auto socket = tcputils::tcp_accept(_listen_socket);
-      _sockets.emplace_back(socket);
+      {
+        std::lock_guard<std::mutex> lock(_store_mutex);
+        _sockets.emplace_back(socket);
+      }
 #ifdef _WIN32
       fds.push_back({socket, POLLIN});
 #else
@@ -272,9 +493,16 @@ void MasterDaemon::run() {
 #endif
     }
 
-    ProcessCommands(&fds);
+    for (size_t i = first_socket; i < fds.size();) {
+      if (fds[i].revents != 0 && !ProcessCommand(fds[i].fd)) {
+        fds.erase(fds.begin() + i);
+        continue;
+      }
+      ++i;
+    }
   }
 }
+#endif
 
 std::unique_ptr<TCPServer> TCPServer::create(uint16_t port,
                                              int nranks,
@@ -293,20 +521,25 @@ std::unique_ptr<TCPClient> TCPClient::connect(const std::string host,
 }
 
 void TCPClient::send_command_for_key(Command type, const std::string& key) {
-  tcputils::send_value<Command>(_socket, type);
+  _buffer.append_value<Command>(type);
   if (key.empty()) {
     return;
   }
-  tcputils::send_string(_socket, key);
+  _buffer.append_string(key);
+}
+
+void TCPClient::send_string(const std::string& value) {
+  _buffer.append_string(value);
 }
 
 template <typename T>
 void TCPClient::send_value(const T& value) {
-  tcputils::send_bytes<T>(_socket, &value, 1);
+  _buffer.append_value<T>(value);
 }
 
 template <typename T>
 T TCPClient::receive_value() {
+  flush();
   T res;
   tcputils::receive_bytes<T>(_socket, &res, 1);
   return res;
@@ -314,16 +547,27 @@ T TCPClient::receive_value() {
 
 template <typename T>
 void TCPClient::send_vector(const std::vector<T>& value) {
-  tcputils::send_vector<T>(_socket, value);
+  _buffer.append_vector<T>(value);
 }
 
 template <typename T>
 std::vector<T> TCPClient::receive_vector() {
+  flush();
   return tcputils::receive_vector<T>(_socket);
 }
 
+void TCPClient::flush() {
+  if (!_buffer.empty()) {
+    _buffer.flush(_socket);
+  }
+}
+
 }  // namespace detail
 
+// backoff between WAITs for a master that doesn't block on missing keys
+constexpr std::chrono::milliseconds kMinWaitBackoff{1};
+constexpr std::chrono::milliseconds kMaxWaitBackoff{500};
+
 TCPStore::TCPStore(std::string host,
                    uint16_t port,
                    bool is_master,
@@ -393,6 +637,7 @@ void TCPStore::set(const std::string& key, const std::vector<uint8_t>& value) {
   VLOG(3) << "TCPStore set.";
   _client->send_command_for_key(Command::SET, _key_prefix + key);
   _client->send_vector<uint8_t>(value);
+  _client->flush();
 }
 
 std::vector<uint8_t> TCPStore::get(const std::string& key) {
@@ -402,17 +647,85 @@ std::vector<uint8_t> TCPStore::get(const std::string& key) {
   return _client->receive_vector<uint8_t>();
 }
 
-void TCPStore::wait(const std::string& key) {
-  ReplyType reply;
+void TCPStore::wait(const std::string& key) { multi_wait({key}); }
+
+void TCPStore::multi_wait(const std::vector<std::string>& keys) {
   VLOG(3) << "TCPStore wait.";
-  _client->send_command_for_key(Command::WAIT, _key_prefix + key);
-  reply = _client->receive_value<ReplyType>();
-  while (reply != ReplyType::STOP_WAIT) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  // All WAITs go out in one request. A master that can't block on a missing
+  // key answers WAITING, those keys are asked again after a backoff.
+  std::vector<std::string> pending = keys;
+  auto backoff = kMinWaitBackoff;
+  while (true) {
+    for (auto& key : pending) {
+      _client->send_command_for_key(Command::WAIT, _key_prefix + key);
+    }
+    std::vector<std::string> waiting;
+    for (auto& key : pending) {
+      if (_client->receive_value<ReplyType>() != ReplyType::STOP_WAIT) {
+        waiting.emplace_back(key);
+      }
+    }
+    if (waiting.empty()) {
+      break;
+    }
+    pending.swap(waiting);
+    std::this_thread::sleep_for(backoff);
+    backoff = std::min(backoff * 2, kMaxWaitBackoff);
+  }
+}
 
-    _client->send_command_for_key(Command::WAIT, _key_prefix + key);
-    reply = _client->receive_value<ReplyType>();
+std::vector<std::vector<uint8_t>> TCPStore::multi_get(
+    const std::vector<std::string>& keys) {
+  VLOG(3) << "TCPStore multi_get.";
+  _client->send_command_for_key(Command::MULTI_GET, "");
+  _client->send_value<size_t>(keys.size());
+  for (auto& key : keys) {
+    _client->send_string(_key_prefix + key);
   }
+  std::vector<std::vector<uint8_t>> values(keys.size());
+  std::string missing;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (_client->receive_value<bool>()) {
+      values[i] = _client->receive_vector<uint8_t>();
+    } else {
+      missing += (missing.empty() ? "" : ", ") + keys[i];
+    }
+  }
+  PADDLE_ENFORCE_EQ(
+      missing.empty(),
+      true,
+      platform::errors::NotFound("Keys %s not found in TCPStore.", missing));
+  return values;
+}
+
+void TCPStore::multi_set(const std::vector<std::string>& keys,
+                         const std::vector<std::vector<uint8_t>>& values) {
+  PADDLE_ENFORCE_EQ(keys.size(),
+                    values.size(),
+                    platform::errors::InvalidArgument(
+                        "The number of keys (%d) and values (%d) of "
+                        "multi_set must be equal.",
+                        keys.size(),
+                        values.size()));
+  VLOG(3) << "TCPStore multi_set.";
+  _client->send_command_for_key(Command::MULTI_SET, "");
+  _client->send_value<size_t>(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    _client->send_string(_key_prefix + keys[i]);
+    _client->send_vector<uint8_t>(values[i]);
+  }
+  _client->flush();
+}
+
+std::vector<uint8_t> TCPStore::compare_set(
+    const std::string& key,
+    const std::vector<uint8_t>& expected,
+    const std::vector<uint8_t>& desired) {
+  VLOG(3) << "TCPStore compare_set.";
+  _client->send_command_for_key(Command::COMPARE_SET, _key_prefix + key);
+  _client->send_vector<uint8_t>(expected);
+  _client->send_vector<uint8_t>(desired);
+  return _client->receive_vector<uint8_t>();
 }
 
 TCPStore::~TCPStore() { VLOG(3) << "TCPStore destructure"; }
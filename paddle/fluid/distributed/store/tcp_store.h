@@ -24,6 +24,8 @@
 #endif
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -38,10 +40,22 @@ namespace paddle {
 namespace distributed {
 
 enum class ReplyType { WAITING, STOP_WAIT };
-enum class Command { ADD, GET, SET, WAIT, STOP };
+enum class Command {
+  ADD,
+  GET,
+  SET,
+  WAIT,
+  STOP,
+  MULTI_GET,
+  MULTI_SET,
+  COMPARE_SET
+};
 
 namespace detail {
 
+// On Linux the daemon serves the sockets from a few threads sharing one
+// epoll set, and a WAIT on a missing key is answered once the key is set.
+// Elsewhere one thread polls all sockets and a WAIT is answered at once.
 class MasterDaemon {
  public:
   static std::unique_ptr<MasterDaemon> start(SocketType listen_socket,
@@ -55,19 +69,37 @@ class MasterDaemon {
 
  private:
   void run();
-  void ProcessCommands(std::vector<struct pollfd>* p_fds);
+  // Serves one command from socket. Returns false if the socket is closed or
+  // parked until a waited key is set, then it must not be watched anymore.
+  bool ProcessCommand(SocketType socket);
   void _do_add(SocketType socket);
-  void _do_wait(SocketType socket);
+  bool _do_wait(SocketType socket);
   void _do_get(SocketType socket);
   void _do_set(SocketType socket);
   void _do_stop(SocketType socket);
+  void _do_multi_get(SocketType socket);
+  void _do_multi_set(SocketType socket);
+  void _do_compare_set(SocketType socket);
+  // must hold _store_mutex, the sockets waiting for key are moved to ready
+  void _set_value(const std::string& key,
+                  std::vector<uint8_t> value,
+                  std::vector<SocketType>* ready);
+  void _wake_up(const std::vector<SocketType>& ready);
+  void CheckStopTimeout();
+  void CloseSocket(SocketType socket);
+#ifdef __linux__
+  void WatchSocket(SocketType socket, bool is_new);
+#endif
   SocketType _listen_socket;
   std::vector<SocketType> _sockets;
   std::unordered_map<std::string, std::vector<uint8_t>> _store;
-  std::thread _background_thread{};
+  std::unordered_map<std::string, std::vector<SocketType>> _waiting_sockets;
+  // guards _store, _waiting_sockets, _sockets and the stop status
+  std::mutex _store_mutex;
+  std::vector<std::thread> _background_threads;
   int _nranks = -1;
   int _timeout = 0;
-  bool _stop = false;  // all workers stopped
+  std::atomic<bool> _stop{false};  // all workers stopped
   std::chrono::time_point<std::chrono::system_clock> _stop_time;
   bool _has_stop = false;  // at least one worker stopped
 
@@ -78,6 +110,9 @@ class MasterDaemon {
 #else
   std::array<int, 2> _control_fd{{-1, -1}};
 #endif
+#ifdef __linux__
+  int _epoll_fd = -1;
+#endif
 };
 
 class TCPServer {
@@ -91,6 +126,8 @@ class TCPServer {
   std::unique_ptr<MasterDaemon> _master_daemon;
 };
 
+// Requests are buffered and go out in one send when a reply is received or
+// flush is called, so the requests sent back to back are pipelined.
 class TCPClient {
  public:
   explicit TCPClient(SocketType socket) : _socket{socket} {}
@@ -98,6 +135,7 @@ class TCPClient {
                                             uint16_t port);
   ~TCPClient() { tcputils::close_socket(_socket); }
   void send_command_for_key(Command type, const std::string& key);
+  void send_string(const std::string& value);
 
   template <typename T>
   void send_value(const T& value);
@@ -110,8 +148,11 @@ class TCPClient {
   template <typename T>
   T receive_value();
 
+  void flush();
+
  private:
   SocketType _socket;
+  tcputils::SendBuffer _buffer;
 };
 
 }  // namespace detail
@@ -133,6 +174,15 @@ class TCPStore : public Store {
   void wait(const std::string& key) override;
   void set(const std::string& key, const std::vector<uint8_t>& value) override;
 
+  std::vector<std::vector<uint8_t>> multi_get(
+      const std::vector<std::string>& keys) override;
+  void multi_set(const std::vector<std::string>& keys,
+                 const std::vector<std::vector<uint8_t>>& values) override;
+  void multi_wait(const std::vector<std::string>& keys) override;
+  std::vector<uint8_t> compare_set(const std::string& key,
+                                   const std::vector<uint8_t>& expected,
+                                   const std::vector<uint8_t>& desired) override;
+
  private:
   void waitWorkers();
   std::unique_ptr<detail::TCPServer> _server;
@@ -28,6 +28,7 @@
 #endif
 #include <chrono>
 #include <iostream>
+#include <string>
 #include <vector>
 
 #include "paddle/fluid/platform/enforce.h"
@@ -48,6 +49,12 @@ constexpr int LISTENQ = 2048;
 constexpr std::chrono::seconds kDelay = std::chrono::seconds(3);
 constexpr std::chrono::seconds kNoTimeout = std::chrono::seconds::zero();
 constexpr std::chrono::seconds kDefaultTimeout = std::chrono::seconds(360);
+#ifdef __linux__
+// a peer that went away makes send fail instead of raising SIGPIPE
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
 
 std::error_code socket_error();
 void close_socket(SocketType socket);
@@ -78,7 +85,7 @@ void send_bytes(SocketType socket, const T* buffer, size_t len) {
   auto ptr = reinterpret_cast<const char*>(buffer);
 
   while (to_send > 0) {
-    auto byte_sent = ::send(socket, ptr, to_send, 0);
+    auto byte_sent = ::send(socket, ptr, to_send, kSendFlags);
     PADDLE_ENFORCE_GT(
         byte_sent,
         0,
@@ -131,6 +138,46 @@ void send_value(SocketType socket, const T& v) {
   send_bytes<T>(socket, &v, 1);
 }
 
+// Collects the pieces of one or more messages so that they go out with a
+// single send. The bytes are laid out the same as send_value, send_string
+// and send_vector would write them.
+class SendBuffer {
+ public:
+  template <typename T>
+  void append_bytes(const T* buffer, size_t len) {
+    auto ptr = reinterpret_cast<const char*>(buffer);
+    _buffer.insert(_buffer.end(), ptr, ptr + len * sizeof(T));
+  }
+
+  template <typename T>
+  void append_value(const T& v) {
+    append_bytes<T>(&v, 1);
+  }
+
+  void append_string(const std::string& s) {
+    std::string::size_type size = s.size();
+    append_value<std::string::size_type>(size);
+    append_bytes<char>(s.data(), size);
+  }
+
+  template <typename T>
+  void append_vector(const std::vector<T>& v) {
+    size_t size = v.size();
+    append_value<size_t>(size);
+    append_bytes<T>(v.data(), size);
+  }
+
+  bool empty() const { return _buffer.empty(); }
+
+  void flush(SocketType socket) {
+    send_bytes<char>(socket, _buffer.data(), _buffer.size());
+    _buffer.clear();
+  }
+
+ private:
+  std::vector<char> _buffer;
+};
+
 template <typename T>
 T receive_value(SocketType socket) {
   T v;
@@ -12,12 +12,21 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "paddle/fluid/distributed/store/tcp_store.h"
 #include "paddle/fluid/distributed/store/tcp_utils.h"
 
 #ifdef _WIN32
 #include <windows.h>
+#else
+#include <netinet/in.h>
+#include <sys/socket.h>
 #endif
 
 namespace paddle {
@@ -37,6 +46,80 @@ TEST(MasterDaemon, init) {
   d.reset();
 }
 
+#ifdef __linux__
+// a port picked by the OS that nothing listens on
+uint16_t GetFreePort() {
+  int socket = tcputils::tcp_listen("", std::to_string(0), AF_INET);
+  struct sockaddr_in addr;
+  socklen_t len = sizeof(addr);
+  getsockname(socket, reinterpret_cast<struct sockaddr*>(&addr), &len);
+  tcputils::close_socket(socket);
+  return ntohs(addr.sin_port);
+}
+
+TEST(TCPStore, MultiGetMissingKey) {
+  TCPStore store("127.0.0.1", GetFreePort(), true, 1, 100);
+  store.set("a", {1});
+  EXPECT_THROW(store.multi_get({"a", "b"}), platform::EnforceNotMet);
+  auto values = store.multi_get({"a"});
+  ASSERT_EQ(values.size(), 1UL);
+  EXPECT_EQ(values[0], std::vector<uint8_t>({1}));
+}
+
+// Many local ranks rendezvous through one loopback master.
+TEST(TCPStore, ScaleRendezvous) {
+  const int kRanks = 256;
+  const uint16_t port = GetFreePort();
+  std::vector<std::unique_ptr<TCPStore>> stores(kRanks);
+  std::atomic<int> leaders{0};
+  std::vector<std::thread> threads;
+  for (int rank = 0; rank < kRanks; ++rank) {
+    threads.emplace_back([&, rank]() {
+      stores[rank] = std::make_unique<TCPStore>(
+          "127.0.0.1", port, rank == 0, kRanks, 100);
+      auto& store = stores[rank];
+      std::string id = std::to_string(rank);
+      store->multi_set({"id/" + id, "addr/" + id},
+                       {std::vector<uint8_t>(id.begin(), id.end()),
+                        std::vector<uint8_t>(4, rank % 256)});
+
+      std::vector<std::string> keys;
+      for (int peer = 0; peer < kRanks; ++peer) {
+        keys.emplace_back("id/" + std::to_string(peer));
+      }
+      store->multi_wait(keys);
+      auto values = store->multi_get(keys);
+      for (int peer = 0; peer < kRanks; ++peer) {
+        EXPECT_EQ(std::string(values[peer].begin(), values[peer].end()),
+                  std::to_string(peer));
+      }
+
+      std::vector<uint8_t> desired(id.begin(), id.end());
+      auto leader = store->compare_set("leader", {}, desired);
+      if (leader == desired) {
+        ++leaders;
+      }
+      store->add("barrier", 1);
+      store->wait("addr/" + std::to_string((rank + 1) % kRanks));
+    });
+    if (rank == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(leaders, 1);
+  auto barrier = stores[0]->get("barrier");
+  EXPECT_EQ(std::string(barrier.begin(), barrier.end()),
+            std::to_string(kRanks));
+  // the master goes last
+  for (int rank = kRanks - 1; rank >= 0; --rank) {
+    stores[rank].reset();
+  }
+}
+#endif
+
 /* now for only c compile test
 TEST(TCPStore, init) {
   TCPStore store("127.0.0.1", 6170, true, 1);
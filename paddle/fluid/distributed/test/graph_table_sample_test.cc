@@ -23,10 +23,15 @@
 #include <unordered_set>
 #include <vector>
 
+#include "gflags/gflags.h"
 #include "google/protobuf/text_format.h"
 #include "gtest/gtest.h"
 #include "paddle/fluid/distributed/ps/table/common_graph_table.h"
 #include "paddle/fluid/distributed/the_one_ps.pb.h"
+#include "paddle/fluid/framework/io/fs.h"
+
+DECLARE_bool(graph_load_by_range);
+
 namespace framework = paddle::framework;
 namespace platform = paddle::platform;
 namespace operators = paddle::operators;
@@ -67,7 +72,8 @@ std::vector<std::string> nodes = {
     std::string("item\t113\ta 0.21")};
 char node_file_name[] = "nodes.txt";
 
-void prepare_file(char file_name[], std::vector<std::string> data) {
+void prepare_file(const std::string &file_name,
+                  std::vector<std::string> data) {
   std::ofstream ofile;
   ofile.open(file_name);
   for (auto x : data) {
@@ -77,6 +83,26 @@ void prepare_file(char file_name[], std::vector<std::string> data) {
   ofile.close();
 }
 
+// a fresh directory under /tmp, removed with its files when the test ends
+class ScopedTempDir {
+ public:
+  ScopedTempDir() {
+    char path[] = "/tmp/graph_table_sample_test_XXXXXX";
+    if (mkdtemp(path) != nullptr) {
+      path_ = path;
+    }
+  }
+  ~ScopedTempDir() {
+    if (!path_.empty()) {
+      paddle::framework::localfs_remove(path_);
+    }
+  }
+  const std::string &path() const { return path_; }
+
+ private:
+  std::string path_;
+};
+
 void testGraphSample() {
   ::paddle::distributed::GraphParameter table_proto;
   // table_proto.set_gpu_num(2);
@@ -86,3 +112,244 @@ void testGraphSample() {
 }
 
 TEST(testGraphSample, Run) { testGraphSample(); }
+
+void testGraphCSRSample() {
+  ::paddle::distributed::GraphParameter table_proto;
+  table_proto.set_task_pool_size(4);
+  table_proto.set_shard_num(8);
+  table_proto.add_edge_types("u2u");
+
+  distributed::GraphTable graph_table;
+  graph_table.Initialize(table_proto);
+  // node i links to i * 100 + 0 ... i * 100 + i - 1
+  std::vector<uint64_t> node_ids;
+  for (uint64_t i = 1; i <= 20; i++) {
+    node_ids.push_back(i);
+    for (uint64_t j = 0; j < i; j++) {
+      graph_table.add_comm_edge(0, i, i * 100 + j);
+    }
+  }
+  node_ids.push_back(1000);  // not in graph
+  ASSERT_EQ(graph_table.build_csr(0), 0);
+
+  auto check = [&](distributed::GraphTable &table) {
+    std::vector<char> buffer;
+    std::vector<int> actual_sizes;
+    int sample_size = 5;
+    ASSERT_EQ(table.batch_sample_neighbors(0,
+                                           node_ids.data(),
+                                           node_ids.size(),
+                                           sample_size,
+                                           false,
+                                           &buffer,
+                                           &actual_sizes),
+              0);
+    ASSERT_EQ(actual_sizes.size(), node_ids.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < node_ids.size(); i++) {
+      uint64_t id = node_ids[i];
+      size_t expect = id == 1000 ? 0 : std::min<uint64_t>(id, sample_size);
+      ASSERT_EQ(actual_sizes[i], (int)(expect * sizeof(uint64_t)));
+      std::unordered_set<uint64_t> neighbors;
+      for (size_t k = 0; k < expect; k++) {
+        uint64_t nid;
+        memcpy(&nid, buffer.data() + offset, sizeof(uint64_t));
+        offset += sizeof(uint64_t);
+        ASSERT_EQ(nid / 100, id);
+        neighbors.insert(nid);
+      }
+      ASSERT_EQ(neighbors.size(), expect);
+    }
+    ASSERT_EQ(offset, buffer.size());
+  };
+  check(graph_table);
+
+  ScopedTempDir dir;
+  ASSERT_FALSE(dir.path().empty());
+  std::string csr_path = dir.path() + "/graph_csr_test";
+  ASSERT_EQ(graph_table.save_csr(0, csr_path), 0);
+  distributed::GraphTable loaded_table;
+  loaded_table.Initialize(table_proto);
+  ASSERT_EQ(loaded_table.load_csr(0, csr_path), 0);
+  check(loaded_table);
+}
+
+TEST(testGraphCSRSample, Run) { testGraphCSRSample(); }
+
+void testGraphLoadByRange() {
+  ScopedTempDir dir;
+  ASSERT_FALSE(dir.path().empty());
+  std::string edge_path = dir.path() + "/" + edge_file_name;
+  prepare_file(edge_path, edges);
+  ::paddle::distributed::GraphParameter table_proto;
+  table_proto.set_task_pool_size(4);
+  table_proto.set_shard_num(8);
+  table_proto.add_edge_types("u2i");
+
+  FLAGS_graph_load_by_range = true;
+  distributed::GraphTable graph_table;
+  graph_table.Initialize(table_proto);
+  ASSERT_EQ(graph_table.load_edges(edge_path, false, "u2i"), 0);
+  FLAGS_graph_load_by_range = false;
+
+  std::vector<uint64_t> src_ids = {37, 96, 59, 97};
+  for (auto id : src_ids) {
+    auto node = graph_table.find_node(0, 0, id);
+    ASSERT_TRUE(node != nullptr);
+    ASSERT_EQ(node->get_neighbor_size(), 3UL);
+  }
+
+  std::string snapshot_path = dir.path() + "/graph_edges_snapshot";
+  ASSERT_EQ(graph_table.save_edges_snapshot(0, snapshot_path), 0);
+  distributed::GraphTable loaded_table;
+  loaded_table.Initialize(table_proto);
+  ASSERT_EQ(loaded_table.load_edges_snapshot(0, snapshot_path), 0);
+  for (auto id : src_ids) {
+    auto node = graph_table.find_node(0, 0, id);
+    auto loaded_node = loaded_table.find_node(0, 0, id);
+    ASSERT_TRUE(loaded_node != nullptr);
+    ASSERT_EQ(loaded_node->get_neighbor_size(), node->get_neighbor_size());
+    std::unordered_set<uint64_t> neighbors;
+    for (size_t i = 0; i < node->get_neighbor_size(); i++) {
+      neighbors.insert(node->get_neighbor_id(i));
+    }
+    for (size_t i = 0; i < loaded_node->get_neighbor_size(); i++) {
+      ASSERT_EQ(neighbors.count(loaded_node->get_neighbor_id(i)), 1UL);
+    }
+  }
+}
+
+TEST(testGraphLoadByRange, Run) { testGraphLoadByRange(); }
+
+// adds to res[i] the probability that edge i is among k draws without
+// replacement, every draw proportional to the weights left
+void inclusion_probs(const std::vector<double> &weights,
+                     int k,
+                     double prob,
+                     std::vector<bool> *taken,
+                     std::vector<double> *res) {
+  if (k == 0) return;
+  double remain = 0;
+  for (size_t i = 0; i < weights.size(); i++) {
+    if (!(*taken)[i]) remain += weights[i];
+  }
+  for (size_t i = 0; i < weights.size(); i++) {
+    if ((*taken)[i]) continue;
+    double p = prob * weights[i] / remain;
+    (*res)[i] += p;
+    (*taken)[i] = true;
+    inclusion_probs(weights, k - 1, p, taken, res);
+    (*taken)[i] = false;
+  }
+}
+
+void testGraphWeightedSample() {
+  ScopedTempDir dir;
+  ASSERT_FALSE(dir.path().empty());
+  // node 1 has edges 11..14 weighted 1..4, node 2 has one heavy edge that
+  // makes most alias draws hit an edge already picked
+  std::vector<std::string> weighted_edges = {std::string("1\t11\t1"),
+                                             std::string("1\t12\t2"),
+                                             std::string("1\t13\t3"),
+                                             std::string("1\t14\t4"),
+                                             std::string("2\t21\t1000"),
+                                             std::string("2\t22\t1"),
+                                             std::string("2\t23\t1"),
+                                             std::string("2\t24\t1")};
+  std::string edge_path = dir.path() + "/weighted_edges.txt";
+  prepare_file(edge_path, weighted_edges);
+  ::paddle::distributed::GraphParameter table_proto;
+  table_proto.set_task_pool_size(4);
+  table_proto.set_shard_num(8);
+  table_proto.add_edge_types("u2i");
+  distributed::GraphTable graph_table;
+  graph_table.Initialize(table_proto);
+  ASSERT_EQ(graph_table.load_edges(edge_path, false, "u2i"), 0);
+  ASSERT_EQ(graph_table.build_csr(0), 0);
+  std::string snapshot_path = dir.path() + "/graph_edges_snapshot";
+  ASSERT_EQ(graph_table.save_edges_snapshot(0, snapshot_path), 0);
+  distributed::GraphTable loaded_table;
+  loaded_table.Initialize(table_proto);
+  ASSERT_EQ(loaded_table.load_edges_snapshot(0, snapshot_path), 0);
+
+  const int trials = 20000;
+  auto check = [&](uint64_t id,
+                   int sample_size,
+                   const std::vector<double> &weights) {
+    std::vector<double> expect(weights.size(), 0);
+    std::vector<bool> taken(weights.size(), false);
+    inclusion_probs(weights, sample_size, 1.0, &taken, &expect);
+    std::vector<uint64_t> node_ids(trials, id);
+
+    // csr shards
+    std::vector<char> buffer;
+    std::vector<int> actual_sizes;
+    ASSERT_EQ(graph_table.batch_sample_neighbors(0,
+                                                 node_ids.data(),
+                                                 node_ids.size(),
+                                                 sample_size,
+                                                 false,
+                                                 &buffer,
+                                                 &actual_sizes),
+              0);
+    ASSERT_EQ(buffer.size(), trials * sample_size * sizeof(uint64_t));
+    std::vector<int> csr_count(weights.size(), 0);
+    for (size_t i = 0; i < buffer.size(); i += sizeof(uint64_t)) {
+      uint64_t nid;
+      memcpy(&nid, buffer.data() + i, sizeof(uint64_t));
+      csr_count[nid - id * 10 - 1]++;
+    }
+
+    // samplers rebuilt from the snapshot
+    std::vector<std::shared_ptr<char>> buffers(trials);
+    std::vector<int> sizes;
+    ASSERT_EQ(loaded_table.random_sample_neighbors(
+                  0, node_ids.data(), sample_size, buffers, sizes, false),
+              0);
+    std::vector<int> sampler_count(weights.size(), 0);
+    for (int i = 0; i < trials; i++) {
+      ASSERT_EQ(sizes[i], (int)(sample_size * sizeof(uint64_t)));
+      for (int j = 0; j < sample_size; j++) {
+        uint64_t nid;
+        memcpy(&nid, buffers[i].get() + j * sizeof(uint64_t), sizeof(uint64_t));
+        sampler_count[nid - id * 10 - 1]++;
+      }
+    }
+
+    for (size_t i = 0; i < weights.size(); i++) {
+      EXPECT_NEAR((double)csr_count[i] / trials, expect[i], 0.02)
+          << "csr node " << id << " edge " << i;
+      EXPECT_NEAR((double)sampler_count[i] / trials, expect[i], 0.02)
+          << "sampler node " << id << " edge " << i;
+    }
+  };
+  check(1, 1, {1, 2, 3, 4});
+  check(1, 2, {1, 2, 3, 4});
+  check(2, 3, {1000, 1, 1, 1});
+}
+
+TEST(testGraphWeightedSample, Run) { testGraphWeightedSample(); }
+
+void testSampleCacheByteLimit() {
+  // 100 results of 100 bytes each against a 1000 bytes budget
+  distributed::ScaledLRU<distributed::SampleKey, distributed::SampleResult>
+      lru(1, 100000, 100, 1000);
+  std::vector<distributed::SampleKey> keys;
+  std::vector<distributed::SampleResult> results;
+  for (int i = 0; i < 100; i++) {
+    keys.emplace_back(0, i, 10, false);
+    results.emplace_back(100, new char[100]);
+  }
+  ASSERT_EQ(lru.insert(0, keys.data(), results.data(), keys.size()),
+            distributed::LRUResponse::ok);
+  lru.Shrink();
+  std::vector<std::pair<distributed::SampleKey, distributed::SampleResult>> r;
+  ASSERT_EQ(lru.query(0, keys.data(), keys.size(), r),
+            distributed::LRUResponse::ok);
+  ASSERT_GT(r.size(), 0UL);
+  ASSERT_LT(r.size(), keys.size());
+  ASSERT_EQ(lru.get_query_count(), keys.size());
+  ASSERT_EQ(lru.get_hit_count(), r.size());
+}
+
+TEST(testSampleCacheByteLimit, Run) { testSampleCacheByteLimit(); }
@@ -17,6 +17,9 @@ limitations under the License. */
 #include <ThreadPool.h>
 #include <unistd.h>
 
+#include <fstream>
+#include <memory>
+#include <set>
 #include <string>
 #include <thread>  // NOLINT
 
@@ -24,6 +27,9 @@ limitations under the License. */
 #include "gtest/gtest.h"
 #include "paddle/fluid/distributed/ps/table/table.h"
 #include "paddle/fluid/distributed/the_one_ps.pb.h"
+#include "paddle/fluid/framework/io/fs.h"
+
+DECLARE_bool(pserver_create_value_when_push);
 
 namespace paddle {
 namespace distributed {
@@ -152,5 +158,168 @@ TEST(MemorySparseTable, SGD) {
   }
 }
 
+std::unique_ptr<Table> CreateDeltaTrackTable(bool enable_delta_track,
+                                             float base_threshold = 0.5,
+                                             float delta_threshold = 0.2) {
+  TableParameter table_config;
+  table_config.set_table_class("MemorySparseTable");
+  table_config.set_shard_num(10);
+  table_config.set_enable_delta_track(enable_delta_track);
+  FsClientParameter fs_config;
+  std::unique_ptr<Table> table(new MemorySparseTable());
+  table->SetShard(0, 1);
+
+  TableAccessorParameter *accessor_config = table_config.mutable_accessor();
+  accessor_config->set_accessor_class("CtrCommonAccessor");
+  accessor_config->set_fea_dim(11);
+  accessor_config->set_embedx_dim(8);
+  accessor_config->set_embedx_threshold(5);
+  accessor_config->mutable_ctr_accessor_param()->set_nonclk_coeff(0.2);
+  accessor_config->mutable_ctr_accessor_param()->set_click_coeff(1);
+  accessor_config->mutable_ctr_accessor_param()->set_base_threshold(
+      base_threshold);
+  accessor_config->mutable_ctr_accessor_param()->set_delta_threshold(
+      delta_threshold);
+  accessor_config->mutable_ctr_accessor_param()->set_delta_keep_days(16);
+  accessor_config->mutable_ctr_accessor_param()->set_show_click_decay_rate(
+      0.99);
+
+  accessor_config->mutable_embed_sgd_param()->set_name("SparseNaiveSGDRule");
+  auto *naive_param =
+      accessor_config->mutable_embed_sgd_param()->mutable_naive();
+  naive_param->set_learning_rate(0.1);
+  naive_param->set_initial_range(0.3);
+  naive_param->add_weight_bounds(-10.0);
+  naive_param->add_weight_bounds(10.0);
+
+  accessor_config->mutable_embedx_sgd_param()->set_name("SparseNaiveSGDRule");
+  naive_param = accessor_config->mutable_embedx_sgd_param()->mutable_naive();
+  naive_param->set_learning_rate(0.1);
+  naive_param->set_initial_range(0.3);
+  naive_param->add_weight_bounds(-10.0);
+  naive_param->add_weight_bounds(10.0);
+
+  EXPECT_EQ(table->Initialize(table_config, fs_config), 0);
+  return table;
+}
+
+// push one show and one click for every key, enough to pass the delta
+// threshold of the accessor
+void PushShowClick(Table *table, const std::vector<uint64_t> &keys) {
+  int emb_dim = 8;
+  std::vector<float> push_values;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    push_values.push_back(0.0);  // slot
+    push_values.push_back(1.0);  // show
+    push_values.push_back(1.0);  // click
+    for (int k = 0; k < emb_dim + 1; ++k) {
+      push_values.push_back(0.1);
+    }
+  }
+  TableContext table_context;
+  table_context.value_type = Sparse;
+  table_context.push_context.keys = keys.data();
+  table_context.push_context.values = push_values.data();
+  table_context.num = keys.size();
+  ASSERT_EQ(table->Push(table_context), 0);
+}
+
+std::set<uint64_t> SavedKeys(Table *table,
+                             const std::string &dirname,
+                             const std::string &param) {
+  EXPECT_EQ(table->Save(dirname, param), 0);
+  std::set<uint64_t> keys;
+  for (auto &file : paddle::framework::localfs_list(dirname + "/000/")) {
+    std::ifstream fin(file);
+    std::string line;
+    while (std::getline(fin, line)) {
+      if (line.size() > 1) {
+        keys.insert(std::stoull(line));
+      }
+    }
+  }
+  return keys;
+}
+
+TEST(MemorySparseTable, DeltaTrack) {
+  std::string root = "./memory_sparse_table_delta_track";
+  paddle::framework::localfs_remove(root);
+  std::unique_ptr<Table> tracked = CreateDeltaTrackTable(true);
+  std::unique_ptr<Table> scanned = CreateDeltaTrackTable(false);
+
+  // every key was pushed
+  std::vector<uint64_t> keys = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  PushShowClick(tracked.get(), keys);
+  PushShowClick(scanned.get(), keys);
+  auto tracked_keys = SavedKeys(tracked.get(), root + "/tracked_1", "1");
+  auto scanned_keys = SavedKeys(scanned.get(), root + "/scanned_1", "1");
+  EXPECT_EQ(tracked_keys, std::set<uint64_t>(keys.begin(), keys.end()));
+  EXPECT_EQ(tracked_keys, scanned_keys);
+
+  // only the keys pushed since the last delta save
+  PushShowClick(tracked.get(), {0, 1, 2});
+  PushShowClick(scanned.get(), {0, 1, 2});
+  tracked_keys = SavedKeys(tracked.get(), root + "/tracked_2", "1");
+  scanned_keys = SavedKeys(scanned.get(), root + "/scanned_2", "1");
+  EXPECT_EQ(tracked_keys, std::set<uint64_t>({0, 1, 2}));
+  EXPECT_EQ(tracked_keys, scanned_keys);
+
+  // the loaded keys 3 and 4 carry delta scores that were never pushed to
+  // the new tables, the first delta save after Load must still write them
+  PushShowClick(tracked.get(), {3, 4});
+  ASSERT_EQ(tracked->Save(root + "/checkpoint", "0"), 0);
+  std::unique_ptr<Table> loaded_tracked = CreateDeltaTrackTable(true);
+  std::unique_ptr<Table> loaded_scanned = CreateDeltaTrackTable(false);
+  ASSERT_EQ(loaded_tracked->Load(root + "/checkpoint", "0"), 0);
+  ASSERT_EQ(loaded_scanned->Load(root + "/checkpoint", "0"), 0);
+  tracked_keys = SavedKeys(loaded_tracked.get(), root + "/tracked_3", "1");
+  scanned_keys = SavedKeys(loaded_scanned.get(), root + "/scanned_3", "1");
+  EXPECT_EQ(tracked_keys, std::set<uint64_t>({3, 4}));
+  EXPECT_EQ(tracked_keys, scanned_keys);
+
+  // tracking is used again after the first delta save
+  PushShowClick(loaded_tracked.get(), {5});
+  PushShowClick(loaded_scanned.get(), {5});
+  tracked_keys = SavedKeys(loaded_tracked.get(), root + "/tracked_4", "1");
+  scanned_keys = SavedKeys(loaded_scanned.get(), root + "/scanned_4", "1");
+  EXPECT_EQ(tracked_keys, std::set<uint64_t>({5}));
+  EXPECT_EQ(tracked_keys, scanned_keys);
+
+  paddle::framework::localfs_remove(root);
+}
+
+// With zero thresholds a full scan saves the keys that a pull created and
+// nobody pushed, so the tracked save has to save them too.
+TEST(MemorySparseTable, DeltaTrackPulledKeys) {
+  std::string root = "./memory_sparse_table_delta_track_pull";
+  paddle::framework::localfs_remove(root);
+  FLAGS_pserver_create_value_when_push = false;
+  std::unique_ptr<Table> tracked = CreateDeltaTrackTable(true, 0, 0);
+  std::unique_ptr<Table> scanned = CreateDeltaTrackTable(false, 0, 0);
+
+  int emb_dim = 8;
+  std::vector<uint64_t> keys = {10, 11, 12};
+  std::vector<uint32_t> fres = {1, 1, 1};
+  std::vector<float> pull_values(keys.size() * (emb_dim + 3));
+  auto value = PullSparseValue(keys, fres, emb_dim);
+  for (auto *table : {tracked.get(), scanned.get()}) {
+    TableContext table_context;
+    table_context.value_type = Sparse;
+    table_context.pull_context.pull_value = value;
+    table_context.pull_context.values = pull_values.data();
+    ASSERT_EQ(table->Pull(table_context), 0);
+  }
+  PushShowClick(tracked.get(), {0});
+  PushShowClick(scanned.get(), {0});
+
+  auto tracked_keys = SavedKeys(tracked.get(), root + "/tracked", "1");
+  auto scanned_keys = SavedKeys(scanned.get(), root + "/scanned", "1");
+  EXPECT_EQ(scanned_keys, std::set<uint64_t>({0, 10, 11, 12}));
+  EXPECT_EQ(tracked_keys, scanned_keys);
+
+  FLAGS_pserver_create_value_when_push = true;
+  paddle::framework::localfs_remove(root);
+}
+
 }  // namespace distributed
 }  // namespace paddle
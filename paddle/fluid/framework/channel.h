@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <condition_variable>  // NOLINT
 #include <deque>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <mutex>  // NOLINT
@@ -264,10 +265,11 @@ class ChannelObject {
     reading_count_ += n;
     while (finished < n && WaitForRead(lock)) {
       size_t m = (std::min)(n - finished, data_.size());
-      for (size_t i = 0; i < m; i++) {
-        p[finished++] = std::move(data_.front());
-        data_.pop_front();
-      }
+      // move and erase the block at once, it keeps the time under the lock
+      // short when many readers share the channel
+      std::move(data_.begin(), data_.begin() + m, p + finished);
+      data_.erase(data_.begin(), data_.begin() + m);
+      finished += m;
       reading_count_ -= m;
       if (once && m > 0) {
         break;
@@ -284,9 +286,8 @@ class ChannelObject {
     while (finished < n && WaitForWrite(lock)) {
       size_t m =
           std::min(n - finished, capacity_ + reading_count_ - data_.size());
-      for (size_t i = 0; i < m; i++) {
-        data_.push_back(p[finished++]);
-      }
+      data_.insert(data_.end(), p + finished, p + finished + m);
+      finished += m;
     }
     return finished;
   }
@@ -298,9 +299,10 @@ class ChannelObject {
     while (finished < n && WaitForWrite(lock)) {
       size_t m =
           (std::min)(n - finished, capacity_ + reading_count_ - data_.size());
-      for (size_t i = 0; i < m; i++) {
-        data_.push_back(std::move(p[finished++]));
-      }
+      data_.insert(data_.end(),
+                   std::make_move_iterator(p + finished),
+                   std::make_move_iterator(p + finished + m));
+      finished += m;
     }
     return finished;
   }
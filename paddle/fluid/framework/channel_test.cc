@@ -0,0 +1,124 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/channel.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace framework = paddle::framework;
+
+TEST(Channel, ReadWriteBatch) {
+  auto chan = framework::MakeChannel<std::string>();
+  std::vector<std::string> input = {"a", "b", "c", "d", "e"};
+  EXPECT_EQ(chan->Write(input), 5UL);
+  std::vector<std::string> moved = {"f", "g"};
+  EXPECT_EQ(chan->Write(std::move(moved)), 2UL);
+  EXPECT_EQ(chan->Size(), 7UL);
+
+  std::vector<std::string> out(3);
+  EXPECT_EQ(chan->Read(3, &out[0]), 3UL);
+  EXPECT_EQ(out, std::vector<std::string>({"a", "b", "c"}));
+
+  chan->Close();
+  EXPECT_FALSE(chan->Put(std::string("h")));
+  EXPECT_EQ(chan->ReadAll(out), 4UL);
+  EXPECT_EQ(out, std::vector<std::string>({"d", "e", "f", "g"}));
+  std::string val;
+  EXPECT_FALSE(chan->Get(val));
+}
+
+TEST(Channel, BoundedBlocking) {
+  auto chan = framework::MakeChannel<int>(16);
+  const int kNum = 10000;
+  std::thread producer([&]() {
+    for (int i = 0; i < kNum; i += 100) {
+      std::vector<int> batch;
+      for (int j = i; j < i + 100; ++j) {
+        batch.push_back(j);
+      }
+      EXPECT_EQ(chan->Write(std::move(batch)), 100UL);
+    }
+    chan->Close();
+  });
+  std::vector<int> out;
+  std::vector<int> batch;
+  while (chan->Read(batch) != 0) {
+    EXPECT_LE(chan->Size(), 16UL);
+    out.insert(out.end(), batch.begin(), batch.end());
+  }
+  producer.join();
+  ASSERT_EQ(out.size(), static_cast<size_t>(kNum));
+  for (int i = 0; i < kNum; ++i) {
+    EXPECT_EQ(out[i], i);
+  }
+}
+
+// Half of the threads write blocks of records, the other half read them, the
+// same pattern as the data feed readers and the shuffle path. Every record
+// must be read exactly once.
+TEST(Channel, Contention) {
+  const size_t kBatch = 64;
+  const size_t kItemsPerProducer = 1 << 12;
+  for (int thread_num : {2, 8, 32}) {
+    auto chan = framework::MakeChannel<uint64_t>(256);
+    chan->SetBlockSize(kBatch);
+    int producer_num = thread_num / 2;
+    std::atomic<int> running_producers(producer_num);
+    std::vector<std::vector<uint64_t>> consumed(thread_num - producer_num);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < producer_num; ++i) {
+      threads.emplace_back([&, i]() {
+        std::vector<uint64_t> batch(kBatch);
+        for (size_t n = 0; n < kItemsPerProducer; n += kBatch) {
+          for (size_t j = 0; j < kBatch; ++j) {
+            batch[j] = i * kItemsPerProducer + n + j;
+          }
+          EXPECT_EQ(chan->Write(kBatch, batch.data()), kBatch);
+        }
+        if (--running_producers == 0) {
+          chan->Close();
+        }
+      });
+    }
+    for (size_t i = 0; i < consumed.size(); ++i) {
+      threads.emplace_back([&, i]() {
+        std::vector<uint64_t> batch;
+        while (chan->Read(batch) != 0) {
+          EXPECT_LE(batch.size(), kBatch);
+          consumed[i].insert(consumed[i].end(), batch.begin(), batch.end());
+        }
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    std::vector<int> seen(kItemsPerProducer * producer_num, 0);
+    for (auto& items : consumed) {
+      for (auto v : items) {
+        ASSERT_LT(v, seen.size());
+        ++seen[v];
+      }
+    }
+    for (size_t v = 0; v < seen.size(); ++v) {
+      ASSERT_EQ(seen[v], 1) << "item " << v << " with " << thread_num
+                            << " threads";
+    }
+    EXPECT_TRUE(chan->Empty());
+  }
+}
@@ -1132,12 +1132,11 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstanceFromPipe(Record* instance) {
     return false;
   } else {
     const char* str = reader.get();
-    std::string line = std::string(str);
-    // VLOG(3) << line;
+    // VLOG(3) << str;
     char* endptr = const_cast<char*>(str);
     int pos = 0;
     if (parse_ins_id_) {
-      int num = strtol(&str[pos], &endptr, 10);
+      int num = string::fast_strtol(&str[pos], &endptr);
       CHECK(num == 1);  // NOLINT
       pos = endptr - str + 1;
       size_t len = 0;
@@ -1149,7 +1148,7 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstanceFromPipe(Record* instance) {
       VLOG(3) << "ins_id " << instance->ins_id_;
     }
     if (parse_content_) {
-      int num = strtol(&str[pos], &endptr, 10);
+      int num = string::fast_strtol(&str[pos], &endptr);
       CHECK(num == 1);  // NOLINT
       pos = endptr - str + 1;
       size_t len = 0;
@@ -1161,7 +1160,7 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstanceFromPipe(Record* instance) {
       VLOG(3) << "content " << instance->content_;
     }
     if (parse_logkey_) {
-      int num = strtol(&str[pos], &endptr, 10);
+      int num = string::fast_strtol(&str[pos], &endptr);
       CHECK(num == 1);  // NOLINT
       pos = endptr - str + 1;
       size_t len = 0;
@@ -1183,7 +1182,7 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstanceFromPipe(Record* instance) {
     }
     for (size_t i = 0; i < use_slots_index_.size(); ++i) {
       int idx = use_slots_index_[i];
-      int num = strtol(&str[pos], &endptr, 10);
+      int num = string::fast_strtol(&str[pos], &endptr);
       PADDLE_ENFORCE_NE(
           num,
           0,
@@ -1209,14 +1208,14 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstanceFromPipe(Record* instance) {
                            str));
 
         char* uidptr = endptr;
-        uint64_t feasign = (uint64_t)strtoull(uidptr, &uidptr, 10);
+        uint64_t feasign = string::fast_strtoull(uidptr, &uidptr);
         instance->uid_ = feasign;
       }
 #endif
       if (idx != -1) {
         if (all_slots_type_[i][0] == 'f') {  // float
           for (int j = 0; j < num; ++j) {
-            float feasign = strtof(endptr, &endptr);
+            float feasign = string::fast_strtof(endptr, &endptr);
             // if float feasign is equal to zero, ignore it
             // except when slot is dense
             if (fabs(feasign) < 1e-6 && !use_slots_is_dense_[i]) {
@@ -1228,7 +1227,7 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstanceFromPipe(Record* instance) {
           }
         } else if (all_slots_type_[i][0] == 'u') {  // uint64
           for (int j = 0; j < num; ++j) {
-            uint64_t feasign = (uint64_t)strtoull(endptr, &endptr, 10);
+            uint64_t feasign = string::fast_strtoull(endptr, &endptr);
             // if uint64 feasign is equal to zero, ignore it
             // except when slot is dense
             if (feasign == 0 && !use_slots_is_dense_[i]) {
@@ -1243,7 +1242,7 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstanceFromPipe(Record* instance) {
       } else {
         for (int j = 0; j <= num; ++j) {
           // pos = line.find_first_of(' ', pos + 1);
-          while (line[pos + 1] != ' ') {
+          while (str[pos + 1] != ' ') {
             pos++;
           }
         }
@@ -1270,7 +1269,7 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstance(Record* instance) {
     int pos = 0;
     for (size_t i = 0; i < use_slots_index_.size(); ++i) {
       int idx = use_slots_index_[i];
-      int num = strtol(&str[pos], &endptr, 10);
+      int num = string::fast_strtol(&str[pos], &endptr);
       PADDLE_ENFORCE_NE(
           num,
           0,
@@ -1291,7 +1290,7 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstance(Record* instance) {
       if (idx != -1) {
         if (all_slots_type_[i][0] == 'f') {  // float
           for (int j = 0; j < num; ++j) {
-            float feasign = strtof(endptr, &endptr);
+            float feasign = string::fast_strtof(endptr, &endptr);
             if (fabs(feasign) < 1e-6) {
               continue;
             }
@@ -1301,7 +1300,7 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstance(Record* instance) {
           }
         } else if (all_slots_type_[i][0] == 'u') {  // uint64
           for (int j = 0; j < num; ++j) {
-            uint64_t feasign = (uint64_t)strtoull(endptr, &endptr, 10);
+            uint64_t feasign = string::fast_strtoull(endptr, &endptr);
             if (feasign == 0) {
               continue;
             }
@@ -2489,70 +2488,74 @@ void SlotRecordInMemoryDataFeed::PutToFeedVec(const SlotRecord* ins_vec,
   pack_->pack_instance(ins_vec, num);
   BuildSlotBatchGPU(pack_->ins_num());
 #else
+  // feasigns are written straight into the feed tensors on cpu, the tensors
+  // keep their allocation between batches, so only device places need the
+  // batch_*_feasigns_ staging buffers
+  bool is_cpu_place = platform::is_cpu_place(this->place_);
   for (int j = 0; j < use_slot_size_; ++j) {
     auto& feed = feed_vec_[j];
     if (feed == nullptr) {
       continue;
     }
 
+    auto& info = used_slots_info_[j];
     auto& slot_offset = offset_[j];
-    slot_offset.clear();
-    slot_offset.reserve(num + 1);
-    slot_offset.push_back(0);
+    slot_offset.resize(num + 1);
+    slot_offset[0] = 0;
+    size_t fea_num = 0;
+    // first pass computes the lod, an empty uint64 slot is padded with one 0
+    for (int i = 0; i < num; ++i) {
+      if (info.type[0] == 'f') {
+        ins_vec[i]->slot_float_feasigns_.get_values(info.slot_value_idx,
+                                                    &fea_num);
+      } else {
+        ins_vec[i]->slot_uint64_feasigns_.get_values(info.slot_value_idx,
+                                                     &fea_num);
+        fea_num = std::max(fea_num, static_cast<size_t>(1));
+      }
+      slot_offset[i + 1] = slot_offset[i] + fea_num;
+    }
+    int total_instance = static_cast<int>(slot_offset[num]);
 
-    int total_instance = 0;
-    auto& info = used_slots_info_[j];
-    // fill slot value with default value 0
     if (info.type[0] == 'f') {  // float
-      auto& batch_fea = batch_float_feasigns_[j];
-      batch_fea.clear();
-
-      for (int i = 0; i < num; ++i) {
-        auto r = ins_vec[i];
-        size_t fea_num = 0;
-        float* slot_values =
-            r->slot_float_feasigns_.get_values(info.slot_value_idx, &fea_num);
-        batch_fea.resize(total_instance + fea_num);
-        memcpy(
-            &batch_fea[total_instance], slot_values, sizeof(float) * fea_num);
-        total_instance += fea_num;
-        slot_offset.push_back(total_instance);
-      }
-
-      float* feasign = batch_fea.data();
       float* tensor_ptr =
           feed->mutable_data<float>({total_instance, 1}, this->place_);
-      CopyToFeedTensor(tensor_ptr, feasign, total_instance * sizeof(float));
-
-    } else if (info.type[0] == 'u') {  // uint64
-      auto& batch_fea = batch_uint64_feasigns_[j];
-      batch_fea.clear();
-
+      float* dst = tensor_ptr;
+      if (!is_cpu_place) {
+        batch_float_feasigns_[j].resize(total_instance);
+        dst = batch_float_feasigns_[j].data();
+      }
       for (int i = 0; i < num; ++i) {
-        auto r = ins_vec[i];
-        size_t fea_num = 0;
-        uint64_t* slot_values =
-            r->slot_uint64_feasigns_.get_values(info.slot_value_idx, &fea_num);
+        float* slot_values = ins_vec[i]->slot_float_feasigns_.get_values(
+            info.slot_value_idx, &fea_num);
         if (fea_num > 0) {
-          batch_fea.resize(total_instance + fea_num);
-          memcpy(&batch_fea[total_instance],
-                 slot_values,
-                 sizeof(uint64_t) * fea_num);
-          total_instance += fea_num;
+          memcpy(dst + slot_offset[i], slot_values, sizeof(float) * fea_num);
         }
-        if (fea_num == 0) {
-          batch_fea.resize(total_instance + fea_num);
-          batch_fea[total_instance] = 0;
-          total_instance += 1;
-        }
-        slot_offset.push_back(total_instance);
       }
-
+      if (!is_cpu_place) {
+        CopyToFeedTensor(tensor_ptr, dst, total_instance * sizeof(float));
+      }
+    } else if (info.type[0] == 'u') {  // uint64
       // no uint64_t type in paddlepaddle
-      uint64_t* feasign = batch_fea.data();
       int64_t* tensor_ptr =
           feed->mutable_data<int64_t>({total_instance, 1}, this->place_);
-      CopyToFeedTensor(tensor_ptr, feasign, total_instance * sizeof(int64_t));
+      uint64_t* dst = reinterpret_cast<uint64_t*>(tensor_ptr);
+      if (!is_cpu_place) {
+        batch_uint64_feasigns_[j].resize(total_instance);
+        dst = batch_uint64_feasigns_[j].data();
+      }
+      for (int i = 0; i < num; ++i) {
+        uint64_t* slot_values = ins_vec[i]->slot_uint64_feasigns_.get_values(
+            info.slot_value_idx, &fea_num);
+        if (fea_num > 0) {
+          memcpy(dst + slot_offset[i], slot_values, sizeof(uint64_t) * fea_num);
+        } else {
+          dst[slot_offset[i]] = 0;
+        }
+      }
+      if (!is_cpu_place) {
+        CopyToFeedTensor(tensor_ptr, dst, total_instance * sizeof(int64_t));
+      }
     }
 
     if (info.dense) {
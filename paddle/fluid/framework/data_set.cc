@@ -14,6 +14,11 @@
 
 #include "paddle/fluid/framework/data_set.h"
 
+#include <atomic>
+#include <future>
+#include <iterator>
+#include <random>
+
 #include "gflags/gflags.h"
 #include "google/protobuf/text_format.h"
 #if (defined PADDLE_WITH_DISTRIBUTE) && (defined PADDLE_WITH_PSCORE)
@@ -32,11 +37,16 @@
 
 #if defined _WIN32 || defined __APPLE__
 #else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #define _LINUX
 #endif
 
 USE_INT_STAT(STAT_total_feasign_num_in_mem);
 DECLARE_bool(graph_get_neighbor_id);
+DECLARE_int32(dataset_shuffle_window_size);
 
 namespace paddle {
 namespace framework {
@@ -584,6 +594,401 @@ void DatasetImpl<T>::WaitPreLoadDone() {
   VLOG(3) << "DatasetImpl<T>::WaitPreLoadDone() end";
 }
 
+#ifdef _LINUX
+namespace {
+
+// Binary dataset cache, a part_num file holding the number of parts of the
+// last save, and one file per part:
+//   DatasetCacheHeader
+//   uint64_t column_bytes[column_num]
+//   columns, each padded to 8 bytes
+// Every field of the records is stored as one array over all records of the
+// part, variable length fields as a begin array of ins_num + 1 entries plus
+// the concatenated values.
+const char kDatasetCacheMagic[8] = {'P', 'D', 'D', 'S', 'C', 'A', 'C', 'H'};
+const uint32_t kDatasetCacheVersion = 1;
+const uint32_t kRecordCacheType = 0;
+const uint32_t kSlotRecordCacheType = 1;
+
+struct DatasetCacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t record_type;
+  uint64_t ins_num;
+  uint64_t column_num;
+};
+
+inline size_t CacheAlign(size_t bytes) { return (bytes + 7) & ~size_t(7); }
+
+std::string DatasetCachePartPath(const std::string& path, int part) {
+  char name[32];
+  snprintf(name, sizeof(name), "/part-%05d", part);
+  return path + name;
+}
+
+// the number of parts of the last save, parts beyond it are left over from
+// an earlier save with more threads
+std::string DatasetCacheMetaPath(const std::string& path) {
+  return path + "/part_num";
+}
+
+void WriteDatasetCachePartNum(const std::string& path, int part_num) {
+  FILE* fp = fopen(DatasetCacheMetaPath(path).c_str(), "w");
+  PADDLE_ENFORCE_NOT_NULL(
+      fp,
+      platform::errors::Unavailable("Can not open %s to write.",
+                                    DatasetCacheMetaPath(path)));
+  fprintf(fp, "%d\n", part_num);
+  fclose(fp);
+}
+
+int ReadDatasetCachePartNum(const std::string& path) {
+  FILE* fp = fopen(DatasetCacheMetaPath(path).c_str(), "r");
+  PADDLE_ENFORCE_NOT_NULL(
+      fp,
+      platform::errors::NotFound("No dataset cache found under %s.", path));
+  int part_num = 0;
+  int ret = fscanf(fp, "%d", &part_num);
+  fclose(fp);
+  PADDLE_ENFORCE_EQ(ret == 1 && part_num > 0,
+                    true,
+                    platform::errors::InvalidArgument(
+                        "Broken dataset cache meta %s.",
+                        DatasetCacheMetaPath(path)));
+  return part_num;
+}
+
+class DatasetCacheWriter {
+ public:
+  template <typename V>
+  void AddColumn(const std::vector<V>& col) {
+    columns_.emplace_back(col.data(), col.size() * sizeof(V));
+  }
+
+  void Write(const std::string& file, uint32_t record_type, uint64_t ins_num) {
+    FILE* fp = fopen(file.c_str(), "wb");
+    PADDLE_ENFORCE_NOT_NULL(
+        fp,
+        platform::errors::Unavailable("Failed to open dataset cache file %s.",
+                                      file));
+    DatasetCacheHeader header;
+    memcpy(header.magic, kDatasetCacheMagic, sizeof(header.magic));
+    header.version = kDatasetCacheVersion;
+    header.record_type = record_type;
+    header.ins_num = ins_num;
+    header.column_num = columns_.size();
+    std::vector<uint64_t> column_bytes;
+    for (auto& col : columns_) {
+      column_bytes.push_back(col.second);
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+    ok = ok && fwrite(column_bytes.data(),
+                      sizeof(uint64_t),
+                      column_bytes.size(),
+                      fp) == column_bytes.size();
+    static const char kPadding[8] = {0};
+    for (auto& col : columns_) {
+      if (!ok) {
+        break;
+      }
+      size_t padding = CacheAlign(col.second) - col.second;
+      ok = fwrite(col.first, 1, col.second, fp) == col.second &&
+           fwrite(kPadding, 1, padding, fp) == padding;
+    }
+    ok = (fclose(fp) == 0) && ok;
+    PADDLE_ENFORCE_EQ(
+        ok,
+        true,
+        platform::errors::Unavailable("Failed to write dataset cache file %s.",
+                                      file));
+  }
+
+ private:
+  std::vector<std::pair<const void*, size_t>> columns_;
+};
+
+class DatasetCacheReader {
+ public:
+  DatasetCacheReader(const std::string& file, uint32_t record_type) {
+    int fd = open(file.c_str(), O_RDONLY);
+    PADDLE_ENFORCE_GE(
+        fd,
+        0,
+        platform::errors::NotFound("Dataset cache file %s not found.", file));
+    struct stat st;
+    fstat(fd, &st);
+    len_ = st.st_size;
+    addr_ = len_ == 0 ? MAP_FAILED
+                      : mmap(NULL, len_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    PADDLE_ENFORCE_NE(addr_,
+                      MAP_FAILED,
+                      platform::errors::Unavailable(
+                          "Failed to mmap dataset cache file %s.", file));
+    madvise(addr_, len_, MADV_SEQUENTIAL);
+    const char* base = reinterpret_cast<const char*>(addr_);
+    const DatasetCacheHeader* header =
+        reinterpret_cast<const DatasetCacheHeader*>(base);
+    PADDLE_ENFORCE_EQ(
+        len_ >= sizeof(DatasetCacheHeader) &&
+            memcmp(header->magic, kDatasetCacheMagic, sizeof(header->magic)) ==
+                0 &&
+            header->version == kDatasetCacheVersion &&
+            header->record_type == record_type,
+        true,
+        platform::errors::InvalidArgument(
+            "File %s is not a dataset cache of this dataset type.", file));
+    ins_num_ = header->ins_num;
+    size_t pos = sizeof(DatasetCacheHeader);
+    const uint64_t* column_bytes =
+        reinterpret_cast<const uint64_t*>(base + pos);
+    PADDLE_ENFORCE_LE(header->column_num,
+                      (len_ - pos) / sizeof(uint64_t),
+                      platform::errors::InvalidArgument(
+                          "Dataset cache file %s is truncated.", file));
+    pos += header->column_num * sizeof(uint64_t);
+    for (uint64_t i = 0; i < header->column_num; ++i) {
+      columns_.emplace_back(base + pos, column_bytes[i]);
+      pos += CacheAlign(column_bytes[i]);
+    }
+    PADDLE_ENFORCE_LE(pos,
+                      len_,
+                      platform::errors::InvalidArgument(
+                          "Dataset cache file %s is truncated.", file));
+  }
+  ~DatasetCacheReader() { munmap(addr_, len_); }
+
+  uint64_t ins_num() const { return ins_num_; }
+
+  template <typename V>
+  const V* Column(size_t idx, size_t* num) const {
+    PADDLE_ENFORCE_LT(idx,
+                      columns_.size(),
+                      platform::errors::InvalidArgument(
+                          "Dataset cache has no column %d.", idx));
+    *num = columns_[idx].second / sizeof(V);
+    return reinterpret_cast<const V*>(columns_[idx].first);
+  }
+
+ private:
+  void* addr_ = nullptr;
+  size_t len_ = 0;
+  uint64_t ins_num_ = 0;
+  std::vector<std::pair<const char*, size_t>> columns_;
+};
+
+struct StringColumn {
+  std::vector<uint64_t> begin;
+  std::vector<char> chars;
+  void Add(const std::string& str) {
+    if (begin.empty()) {
+      begin.push_back(0);
+    }
+    chars.insert(chars.end(), str.begin(), str.end());
+    begin.push_back(chars.size());
+  }
+};
+
+template <typename V>
+struct ValueColumn {
+  std::vector<uint64_t> begin;
+  std::vector<V> values;
+  template <typename Iter>
+  void Add(Iter first, Iter last) {
+    if (begin.empty()) {
+      begin.push_back(0);
+    }
+    values.insert(values.end(), first, last);
+    begin.push_back(values.size());
+  }
+};
+
+void WriteDatasetCache(const Record* records,
+                       size_t ins_num,
+                       const std::string& file) {
+  std::vector<uint64_t> search_id(ins_num);
+  std::vector<uint32_t> rank(ins_num), cmatch(ins_num);
+  StringColumn ins_id, content, uid;
+  ValueColumn<uint64_t> uint64_feasigns;
+  ValueColumn<float> float_feasigns;
+  ValueColumn<uint16_t> uint64_slots, float_slots;
+  std::vector<uint64_t> u64_buf;
+  std::vector<float> float_buf;
+  std::vector<uint16_t> slot_buf;
+  for (size_t i = 0; i < ins_num; ++i) {
+    const Record& rec = records[i];
+    search_id[i] = rec.search_id;
+    rank[i] = rec.rank;
+    cmatch[i] = rec.cmatch;
+    ins_id.Add(rec.ins_id_);
+    content.Add(rec.content_);
+    uid.Add(rec.uid_);
+    u64_buf.clear();
+    slot_buf.clear();
+    for (auto& fea : rec.uint64_feasigns_) {
+      u64_buf.push_back(fea.sign().uint64_feasign_);
+      slot_buf.push_back(fea.slot());
+    }
+    uint64_feasigns.Add(u64_buf.begin(), u64_buf.end());
+    uint64_slots.Add(slot_buf.begin(), slot_buf.end());
+    float_buf.clear();
+    slot_buf.clear();
+    for (auto& fea : rec.float_feasigns_) {
+      float_buf.push_back(fea.sign().float_feasign_);
+      slot_buf.push_back(fea.slot());
+    }
+    float_feasigns.Add(float_buf.begin(), float_buf.end());
+    float_slots.Add(slot_buf.begin(), slot_buf.end());
+  }
+  DatasetCacheWriter writer;
+  writer.AddColumn(search_id);
+  writer.AddColumn(rank);
+  writer.AddColumn(cmatch);
+  for (auto* col : {&ins_id, &content, &uid}) {
+    writer.AddColumn(col->begin);
+    writer.AddColumn(col->chars);
+  }
+  writer.AddColumn(uint64_feasigns.begin);
+  writer.AddColumn(uint64_feasigns.values);
+  writer.AddColumn(uint64_slots.values);
+  writer.AddColumn(float_feasigns.begin);
+  writer.AddColumn(float_feasigns.values);
+  writer.AddColumn(float_slots.values);
+  writer.Write(file, kRecordCacheType, ins_num);
+}
+
+void ReadDatasetCache(const std::string& file, std::vector<Record>* records) {
+  DatasetCacheReader reader(file, kRecordCacheType);
+  size_t ins_num = reader.ins_num();
+  size_t n = 0;
+  const uint64_t* search_id = reader.Column<uint64_t>(0, &n);
+  const uint32_t* rank = reader.Column<uint32_t>(1, &n);
+  const uint32_t* cmatch = reader.Column<uint32_t>(2, &n);
+  const uint64_t* str_begin[3];
+  const char* str_chars[3];
+  for (int k = 0; k < 3; ++k) {
+    str_begin[k] = reader.Column<uint64_t>(3 + 2 * k, &n);
+    str_chars[k] = reader.Column<char>(4 + 2 * k, &n);
+  }
+  const uint64_t* u64_begin = reader.Column<uint64_t>(9, &n);
+  const uint64_t* u64_values = reader.Column<uint64_t>(10, &n);
+  const uint16_t* u64_slots = reader.Column<uint16_t>(11, &n);
+  const uint64_t* float_begin = reader.Column<uint64_t>(12, &n);
+  const float* float_values = reader.Column<float>(13, &n);
+  const uint16_t* float_slots = reader.Column<uint16_t>(14, &n);
+
+  records->resize(ins_num);
+  for (size_t i = 0; i < ins_num; ++i) {
+    Record& rec = (*records)[i];
+    rec.search_id = search_id[i];
+    rec.rank = rank[i];
+    rec.cmatch = cmatch[i];
+    std::string* strs[3] = {&rec.ins_id_, &rec.content_, &rec.uid_};
+    for (int k = 0; k < 3; ++k) {
+      strs[k]->assign(str_chars[k] + str_begin[k][i],
+                      str_chars[k] + str_begin[k][i + 1]);
+    }
+    rec.uint64_feasigns_.resize(u64_begin[i + 1] - u64_begin[i]);
+    for (size_t j = u64_begin[i]; j < u64_begin[i + 1]; ++j) {
+      FeatureItem& item = rec.uint64_feasigns_[j - u64_begin[i]];
+      item.sign().uint64_feasign_ = u64_values[j];
+      item.slot() = u64_slots[j];
+    }
+    rec.float_feasigns_.resize(float_begin[i + 1] - float_begin[i]);
+    for (size_t j = float_begin[i]; j < float_begin[i + 1]; ++j) {
+      FeatureItem& item = rec.float_feasigns_[j - float_begin[i]];
+      item.sign().float_feasign_ = float_values[j];
+      item.slot() = float_slots[j];
+    }
+  }
+}
+
+void WriteDatasetCache(const SlotRecord* records,
+                       size_t ins_num,
+                       const std::string& file) {
+  std::vector<uint64_t> search_id(ins_num);
+  std::vector<uint32_t> rank(ins_num), cmatch(ins_num);
+  StringColumn ins_id;
+  ValueColumn<uint32_t> uint64_offsets, float_offsets;
+  ValueColumn<uint64_t> uint64_values;
+  ValueColumn<float> float_values;
+  for (size_t i = 0; i < ins_num; ++i) {
+    const SlotRecord rec = records[i];
+    search_id[i] = rec->search_id;
+    rank[i] = rec->rank;
+    cmatch[i] = rec->cmatch;
+    ins_id.Add(rec->ins_id_);
+    auto& u64 = rec->slot_uint64_feasigns_;
+    uint64_offsets.Add(u64.slot_offsets.begin(), u64.slot_offsets.end());
+    uint64_values.Add(u64.slot_values.begin(), u64.slot_values.end());
+    auto& f = rec->slot_float_feasigns_;
+    float_offsets.Add(f.slot_offsets.begin(), f.slot_offsets.end());
+    float_values.Add(f.slot_values.begin(), f.slot_values.end());
+  }
+  DatasetCacheWriter writer;
+  writer.AddColumn(search_id);
+  writer.AddColumn(rank);
+  writer.AddColumn(cmatch);
+  writer.AddColumn(ins_id.begin);
+  writer.AddColumn(ins_id.chars);
+  writer.AddColumn(uint64_offsets.begin);
+  writer.AddColumn(uint64_offsets.values);
+  writer.AddColumn(uint64_values.begin);
+  writer.AddColumn(uint64_values.values);
+  writer.AddColumn(float_offsets.begin);
+  writer.AddColumn(float_offsets.values);
+  writer.AddColumn(float_values.begin);
+  writer.AddColumn(float_values.values);
+  writer.Write(file, kSlotRecordCacheType, ins_num);
+}
+
+void ReadDatasetCache(const std::string& file,
+                      std::vector<SlotRecord>* records) {
+  DatasetCacheReader reader(file, kSlotRecordCacheType);
+  size_t ins_num = reader.ins_num();
+  size_t n = 0;
+  const uint64_t* search_id = reader.Column<uint64_t>(0, &n);
+  const uint32_t* rank = reader.Column<uint32_t>(1, &n);
+  const uint32_t* cmatch = reader.Column<uint32_t>(2, &n);
+  const uint64_t* ins_id_begin = reader.Column<uint64_t>(3, &n);
+  const char* ins_id_chars = reader.Column<char>(4, &n);
+  const uint64_t* u64_off_begin = reader.Column<uint64_t>(5, &n);
+  const uint32_t* u64_offsets = reader.Column<uint32_t>(6, &n);
+  const uint64_t* u64_val_begin = reader.Column<uint64_t>(7, &n);
+  const uint64_t* u64_values = reader.Column<uint64_t>(8, &n);
+  const uint64_t* float_off_begin = reader.Column<uint64_t>(9, &n);
+  const uint32_t* float_offsets = reader.Column<uint32_t>(10, &n);
+  const uint64_t* float_val_begin = reader.Column<uint64_t>(11, &n);
+  const float* float_values = reader.Column<float>(12, &n);
+
+  records->clear();
+  if (ins_num == 0) {
+    return;
+  }
+  SlotRecordPool().get(records, ins_num);
+  for (size_t i = 0; i < ins_num; ++i) {
+    SlotRecord rec = (*records)[i];
+    rec->search_id = search_id[i];
+    rec->rank = rank[i];
+    rec->cmatch = cmatch[i];
+    rec->ins_id_.assign(ins_id_chars + ins_id_begin[i],
+                        ins_id_chars + ins_id_begin[i + 1]);
+    auto& u64 = rec->slot_uint64_feasigns_;
+    u64.slot_offsets.assign(u64_offsets + u64_off_begin[i],
+                            u64_offsets + u64_off_begin[i + 1]);
+    u64.slot_values.assign(u64_values + u64_val_begin[i],
+                           u64_values + u64_val_begin[i + 1]);
+    auto& f = rec->slot_float_feasigns_;
+    f.slot_offsets.assign(float_offsets + float_off_begin[i],
+                          float_offsets + float_off_begin[i + 1]);
+    f.slot_values.assign(float_values + float_val_begin[i],
+                         float_values + float_val_begin[i + 1]);
+  }
+}
+
+}  // namespace
+#endif
+
 // release memory data
 template <typename T>
 void DatasetImpl<T>::ReleaseMemory() {
@@ -653,6 +1058,109 @@ void DatasetImpl<T>::ReleaseMemoryFun() {
   STAT_SUB(STAT_total_feasign_num_in_mem, total_fea_num_);
 }
 
+// dump input channel records into path/part-xxxxx, one file per thread,
+// the records stay in the input channel
+template <typename T>
+int64_t DatasetImpl<T>::SaveIntoBinaryCache(const std::string& path) {
+#ifdef _LINUX
+  VLOG(3) << "DatasetImpl<T>::SaveIntoBinaryCache() begin";
+  platform::Timer timeline;
+  timeline.Start();
+  PADDLE_ENFORCE_NOT_NULL(
+      input_channel_,
+      platform::errors::PreconditionNotMet(
+          "Call LoadIntoMemory before saving the dataset cache."));
+  localfs_mkdir(path);
+  std::vector<T> data;
+  input_channel_->Close();
+  input_channel_->ReadAll(data);
+  int part_num = std::max(thread_num_, 1);
+  size_t part_size = (data.size() + part_num - 1) / part_num;
+  // errors are raised on this thread by future::get after all parts are done
+  std::vector<std::future<void>> save_status;
+  for (int i = 0; i < part_num; ++i) {
+    size_t begin = std::min(data.size(), i * part_size);
+    size_t end = std::min(data.size(), begin + part_size);
+    save_status.push_back(
+        std::async(std::launch::async, [&data, &path, i, begin, end]() {
+          WriteDatasetCache(
+              data.data() + begin, end - begin, DatasetCachePartPath(path, i));
+        }));
+  }
+  for (auto& status : save_status) {
+    status.wait();
+  }
+  for (auto& status : save_status) {
+    status.get();
+  }
+  WriteDatasetCachePartNum(path, part_num);
+  int64_t ins_num = data.size();
+  input_channel_->Open();
+  if (!data.empty()) {
+    input_channel_->Write(std::move(data));
+  }
+  input_channel_->Close();
+  timeline.Pause();
+  VLOG(0) << "DatasetImpl<T>::SaveIntoBinaryCache() end, path=" << path
+          << ", ins num=" << ins_num
+          << ", cost time=" << timeline.ElapsedSec() << " seconds";
+  return ins_num;
+#else
+  PADDLE_THROW(platform::errors::Unimplemented(
+      "Dataset binary cache is only supported on linux."));
+#endif
+}
+
+// load the parts of the last SaveIntoBinaryCache under path into the input
+// channel, this replaces LoadIntoMemory
+template <typename T>
+int64_t DatasetImpl<T>::LoadFromBinaryCache(const std::string& path) {
+#ifdef _LINUX
+  VLOG(3) << "DatasetImpl<T>::LoadFromBinaryCache() begin";
+  platform::Timer timeline;
+  timeline.Start();
+  PADDLE_ENFORCE_NOT_NULL(
+      input_channel_,
+      platform::errors::PreconditionNotMet(
+          "Call CreateChannel before loading the dataset cache."));
+  int part_num = ReadDatasetCachePartNum(path);
+  input_channel_->Open();
+  std::atomic<int> next_part(0);
+  std::atomic<int64_t> ins_num(0);
+  // a truncated or broken part is raised on this thread by future::get
+  std::vector<std::future<void>> load_status;
+  int load_thread_num = std::min(std::max(thread_num_, 1), part_num);
+  for (int i = 0; i < load_thread_num; ++i) {
+    load_status.push_back(std::async(std::launch::async, [&]() {
+      std::vector<T> data;
+      for (int part = next_part++; part < part_num; part = next_part++) {
+        ReadDatasetCache(DatasetCachePartPath(path, part), &data);
+        ins_num += data.size();
+        if (!data.empty()) {
+          input_channel_->Write(std::move(data));
+        }
+      }
+    }));
+  }
+  for (auto& status : load_status) {
+    status.wait();
+  }
+  input_channel_->Close();
+  for (auto& status : load_status) {
+    status.get();
+  }
+  input_channel_->SetBlockSize(input_channel_->Size() / thread_num_ + 1);
+  timeline.Pause();
+  VLOG(0) << "DatasetImpl<T>::LoadFromBinaryCache() end, path=" << path
+          << ", ins num=" << ins_num.load()
+          << ", cost time=" << timeline.ElapsedSec() << " seconds";
+  return ins_num.load();
+#else
+  PADDLE_THROW(platform::errors::Unimplemented(
+      "Dataset binary cache is only supported on linux."));
+#endif
+}
+
 // do local shuffle
 template <typename T>
 void DatasetImpl<T>::LocalShuffle() {
@@ -664,22 +1172,101 @@ void DatasetImpl<T>::LocalShuffle() {
     VLOG(3) << "DatasetImpl<T>::LocalShuffle() end, no data to shuffle";
     return;
   }
-  auto fleet_ptr = framework::FleetWrapper::GetInstance();
-  input_channel_->Close();
-  std::vector<T> data;
-  input_channel_->ReadAll(data);
-  std::shuffle(data.begin(), data.end(), fleet_ptr->LocalRandomEngine());
-  input_channel_->Open();
-  input_channel_->Write(std::move(data));
-  data.clear();
-  data.shrink_to_fit();
-  input_channel_->Close();
+  ShuffleInputChannel(thread_num_);
 
   timeline.Pause();
   VLOG(3) << "DatasetImpl<T>::LocalShuffle() end, cost time="
           << timeline.ElapsedSec() << " seconds";
 }
 
+// Every thread scatters its part of the records into random buckets, one
+// bucket per thread, then shuffles one bucket and writes it back to the
+// channel while the other buckets are still shuffling. Random buckets that
+// are shuffled independently give a uniform permutation. With
+// FLAGS_dataset_shuffle_window_size > 0 the records are taken out of the
+// channel and shuffled one window at a time, so the extra memory is bounded
+// by the window instead of the whole dataset.
+template <typename T>
+void DatasetImpl<T>::ShuffleInputChannel(int thread_num) {
+  auto fleet_ptr = framework::FleetWrapper::GetInstance();
+  thread_num = std::max(thread_num, 1);
+  if (shuffle_thread_pool_ == nullptr ||
+      shuffle_thread_pool_num_ != thread_num) {
+    shuffle_thread_pool_.reset(new ::ThreadPool(thread_num));
+    shuffle_thread_pool_num_ = thread_num;
+  }
+  size_t total = input_channel_->Size();
+  size_t window = total;
+  if (FLAGS_dataset_shuffle_window_size > 0) {
+    window = std::min(
+        total, static_cast<size_t>(FLAGS_dataset_shuffle_window_size));
+  }
+  input_channel_->Open();
+  std::vector<T> data;
+  std::vector<std::vector<std::vector<T>>> buckets(
+      thread_num, std::vector<std::vector<T>>(thread_num));
+  std::vector<std::future<void>> tasks;
+  size_t done = 0;
+  while (done < total) {
+    data.resize(std::min(window, total - done));
+    size_t n = input_channel_->Read(data.size(), &data[0]);
+    if (n == 0) {
+      break;
+    }
+    data.resize(n);
+    done += n;
+    // every task of the window seeds its own engine from the window seed,
+    // its thread id and its phase through seed_seq, so the streams are not
+    // correlated as engines seeded with neighbouring integers are
+    uint64_t window_seed = fleet_ptr->LocalRandomEngine()();
+    auto make_engine = [window_seed](int t, int phase) {
+      std::seed_seq seq{static_cast<uint32_t>(window_seed),
+                        static_cast<uint32_t>(window_seed >> 32),
+                        static_cast<uint32_t>(t),
+                        static_cast<uint32_t>(phase)};
+      return std::mt19937_64(seq);
+    };
+    size_t part = (n + thread_num - 1) / thread_num;
+    for (int t = 0; t < thread_num; ++t) {
+      tasks.push_back(shuffle_thread_pool_->enqueue([&, t]() {
+        std::mt19937_64 engine = make_engine(t, 0);
+        size_t end = std::min(n, (t + 1) * part);
+        for (size_t i = t * part; i < end; ++i) {
+          buckets[t][engine() % thread_num].push_back(std::move(data[i]));
+        }
+      }));
+    }
+    for (auto& task : tasks) {
+      task.get();
+    }
+    tasks.clear();
+    data.clear();
+    for (int b = 0; b < thread_num; ++b) {
+      tasks.push_back(shuffle_thread_pool_->enqueue([&, b]() {
+        std::vector<T> bucket;
+        for (int t = 0; t < thread_num; ++t) {
+          auto& src = buckets[t][b];
+          bucket.insert(bucket.end(),
+                        std::make_move_iterator(src.begin()),
+                        std::make_move_iterator(src.end()));
+          std::vector<T>().swap(src);
+        }
+        std::mt19937_64 engine = make_engine(b, 1);
+        std::shuffle(bucket.begin(), bucket.end(), engine);
+        if (!bucket.empty()) {
+          input_channel_->Write(std::move(bucket));
+        }
+      }));
+    }
+    for (auto& task : tasks) {
+      task.get();
+    }
+    tasks.clear();
+  }
+  data.shrink_to_fit();
+  input_channel_->Close();
+}
+
 // do tdm sample
 void MultiSlotDataset::TDMSample(const std::string tree_name,
                                  const std::string tree_path,
@@ -774,16 +1361,7 @@ void MultiSlotDataset::GlobalShuffle(int thread_num) {
   }
 
   // local shuffle
-  input_channel_->Close();
-  std::vector<Record> data;
-  input_channel_->ReadAll(data);
-  std::shuffle(data.begin(), data.end(), fleet_ptr->LocalRandomEngine());
-  input_channel_->Open();
-  input_channel_->Write(std::move(data));
-  data.clear();
-  data.shrink_to_fit();
-
-  input_channel_->Close();
+  ShuffleInputChannel(thread_num_);
   input_channel_->SetBlockSize(fleet_send_batch_size_);
   VLOG(3) << "MultiSlotDataset::GlobalShuffle() input_channel_ size "
           << input_channel_->Size();
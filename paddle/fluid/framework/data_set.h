@@ -121,6 +121,12 @@ class Dataset {
   virtual void WaitPreLoadDone() = 0;
   // release all memory data
   virtual void ReleaseMemory() = 0;
+  // dump the loaded records to a binary columnar cache under a local dir,
+  // returns the number of records written
+  virtual int64_t SaveIntoBinaryCache(const std::string& path) = 0;
+  // load records from a cache written by SaveIntoBinaryCache, without
+  // reading or parsing the original files. returns the number of records
+  virtual int64_t LoadFromBinaryCache(const std::string& path) = 0;
   // local shuffle data
   virtual void LocalShuffle() = 0;
   // global shuffle data
@@ -231,6 +237,8 @@ class DatasetImpl : public Dataset {
   virtual void PreLoadIntoMemory();
   virtual void WaitPreLoadDone();
   virtual void ReleaseMemory();
+  virtual int64_t SaveIntoBinaryCache(const std::string& path);
+  virtual int64_t LoadFromBinaryCache(const std::string& path);
   virtual void LocalShuffle();
   virtual void GlobalShuffle(int thread_num = -1) {}
   virtual void SlotsShuffle(const std::set<std::string>& slots_to_replace) {}
@@ -289,6 +297,8 @@ class DatasetImpl : public Dataset {
     // TODO(yaoxuefeng) for SlotRecordDataset
     return -1;
   }
+  // shuffle the records of input_channel_ with thread_num threads
+  void ShuffleInputChannel(int thread_num);
   std::vector<std::shared_ptr<paddle::framework::DataFeed>> readers_;
   std::vector<std::shared_ptr<paddle::framework::DataFeed>> preload_readers_;
   paddle::framework::Channel<T> input_channel_;
@@ -337,6 +347,9 @@ class DatasetImpl : public Dataset {
   std::mutex global_index_mutex_;
   int64_t global_index_ = 0;
   std::vector<std::shared_ptr<ThreadPool>> consume_task_pool_;
+  // kept across windows and calls of ShuffleInputChannel
+  std::shared_ptr<ThreadPool> shuffle_thread_pool_;
+  int shuffle_thread_pool_num_{0};
   std::vector<T> input_records_;  // only for paddleboxdatafeed
   std::vector<std::string> use_slots_;
   bool enable_heterps_ = false;
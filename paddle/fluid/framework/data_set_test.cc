@@ -0,0 +1,95 @@
+//   Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/data_set.h"
+
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "gtest/gtest.h"
+
+DECLARE_int32(dataset_shuffle_window_size);
+
+namespace paddle {
+namespace framework {
+
+// shuffles record_num records and checks every record comes back once
+void CheckLocalShuffle(int record_num, int thread_num, int window_size) {
+  FLAGS_dataset_shuffle_window_size = window_size;
+  MultiSlotDataset dataset;
+  dataset.SetThreadNum(thread_num);
+  auto& channel = dataset.GetInputChannelRef();
+  channel = MakeChannel<Record>();
+  std::vector<Record> records(record_num);
+  for (int i = 0; i < record_num; ++i) {
+    records[i].ins_id_ = std::to_string(i);
+  }
+  channel->Write(std::move(records));
+  channel->Close();
+
+  dataset.LocalShuffle();
+  FLAGS_dataset_shuffle_window_size = 0;
+
+  std::vector<Record> shuffled;
+  channel->ReadAll(shuffled);
+  ASSERT_EQ(shuffled.size(), static_cast<size_t>(record_num));
+  std::vector<int> seen(record_num, 0);
+  int in_place = 0;
+  for (int i = 0; i < record_num; ++i) {
+    int id = std::stoi(shuffled[i].ins_id_);
+    ASSERT_GE(id, 0);
+    ASSERT_LT(id, record_num);
+    ++seen[id];
+    in_place += id == i;
+  }
+  for (int i = 0; i < record_num; ++i) {
+    EXPECT_EQ(seen[i], 1) << "record " << i;
+  }
+  if (record_num >= 100) {
+    EXPECT_LT(in_place, record_num / 10);
+  }
+}
+
+TEST(DatasetImpl, LocalShuffle) {
+  CheckLocalShuffle(10000, 4, 0);
+  // windows that don't divide the records
+  CheckLocalShuffle(10000, 4, 777);
+  // more threads than records
+  CheckLocalShuffle(3, 8, 0);
+  CheckLocalShuffle(1, 1, 0);
+}
+
+TEST(DatasetImpl, LocalShuffleReusesThreads) {
+  MultiSlotDataset dataset;
+  auto& channel = dataset.GetInputChannelRef();
+  channel = MakeChannel<Record>();
+  for (int thread_num : {2, 2, 3}) {
+    dataset.SetThreadNum(thread_num);
+    std::vector<Record> records(100);
+    for (int i = 0; i < 100; ++i) {
+      records[i].ins_id_ = std::to_string(i);
+    }
+    channel->Open();
+    channel->Write(std::move(records));
+    channel->Close();
+    dataset.LocalShuffle();
+    std::vector<Record> shuffled;
+    channel->ReadAll(shuffled);
+    ASSERT_EQ(shuffled.size(), 100UL);
+  }
+}
+
+}  // namespace framework
+}  // namespace paddle
@@ -821,17 +821,23 @@ DepthwiseConvBNFusePass::DepthwiseConvBNFusePass() {
 }  // namespace framework
 }  // namespace paddle
 
-REGISTER_PASS(conv_bn_fuse_pass, paddle::framework::ir::ConvBNFusePass);
+REGISTER_PASS(conv_bn_fuse_pass, paddle::framework::ir::ConvBNFusePass)
+    .AnchorOpTypes({"batch_norm"});
 REGISTER_PASS(conv_eltwiseadd_bn_fuse_pass,
-              paddle::framework::ir::ConvEltwiseAddBNFusePass);
+              paddle::framework::ir::ConvEltwiseAddBNFusePass)
+    .AnchorOpTypes({"batch_norm"});
 REGISTER_PASS(conv_transpose_bn_fuse_pass,
-              paddle::framework::ir::ConvTransposeBNFusePass);
+              paddle::framework::ir::ConvTransposeBNFusePass)
+    .AnchorOpTypes({"batch_norm"});
 REGISTER_PASS(conv_transpose_eltwiseadd_bn_fuse_pass,
-              paddle::framework::ir::ConvTransposeEltwiseAddBNFusePass);
+              paddle::framework::ir::ConvTransposeEltwiseAddBNFusePass)
+    .AnchorOpTypes({"batch_norm"});
 REGISTER_PASS(depthwise_conv_bn_fuse_pass,
-              paddle::framework::ir::DepthwiseConvBNFusePass);
+              paddle::framework::ir::DepthwiseConvBNFusePass)
+    .AnchorOpTypes({"batch_norm"});
 REGISTER_PASS(depthwise_conv_eltwiseadd_bn_fuse_pass,
-              paddle::framework::ir::DepthwiseConvEltwiseAddBNFusePass);
+              paddle::framework::ir::DepthwiseConvEltwiseAddBNFusePass)
+    .AnchorOpTypes({"batch_norm"});
 REGISTER_PASS_CAPABILITY(conv_bn_fuse_pass)
     .AddCombination(
         paddle::framework::compatible::OpVersionComparatorCombination()
@@ -14,9 +14,16 @@
 
 #include "paddle/fluid/framework/ir/cost_model.h"
 
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <fstream>
 #include <memory>
+#include <sstream>
 
 #include "paddle/fluid/framework/executor.h"
+#include "paddle/fluid/framework/ir/fuse_pass_base.h"
+#include "paddle/fluid/framework/ir/graph_helper.h"
+#include "paddle/fluid/framework/ir/pass.h"
 #include "paddle/fluid/framework/scope.h"
 #include "paddle/fluid/platform/errors.h"
 #include "paddle/fluid/platform/place.h"
@@ -42,6 +49,21 @@ double CostData::GetOpMemoryBytes(int op_id) const {
 double CostData::GetWholeTimeMs() const { return whole_time_ms_; }
 double CostData::GetWholeMemoryBytes() const { return whole_memory_bytes_; }
 
+std::map<std::string, double> CostData::GetOpTypeTimeMs(
+    const ProgramDesc& program) const {
+  std::map<std::string, double> res;
+  if (program.Size() == 0) {
+    return res;
+  }
+  const BlockDesc& global_block = program.Block(0);
+  for (auto& item : op_time_ms_) {
+    if (item.first < static_cast<int>(global_block.OpSize())) {
+      res[global_block.Op(item.first)->Type()] += item.second;
+    }
+  }
+  return res;
+}
+
 const Graph* CostData::GetGraph() const { return graph_; }
 const ProgramDesc* CostData::GetProgram() const { return program_; }
 
@@ -218,32 +240,35 @@ std::string ToLowerCopy(const std::string& in) {
   return out;
 }
 
-CostData CostModel::ProfileMeasure(
-    const ProgramDesc& main_program,
-    const ProgramDesc& startup_program,
-    const std::string& device,
-    const std::vector<std::string>& fetch_cost_list) const {
-  // Currently fetch_cost_list is useless
-  // TODO(zhhsplendid): support different fetch data
-
-  platform::ProfilerState profiler_state;
-  platform::Place place;
-
+static void ParseDevice(const std::string& device,
+                        platform::ProfilerState* profiler_state,
+                        platform::Place* place) {
   std::string device_lower_case = ToLowerCopy(device);
   if (device_lower_case == "cpu") {
-    profiler_state = platform::ProfilerState::kCPU;
-    place = platform::CPUPlace();
+    *profiler_state = platform::ProfilerState::kCPU;
+    *place = platform::CPUPlace();
   } else if (device_lower_case == "gpu") {
-    profiler_state = platform::ProfilerState::kAll;
-    place = platform::CUDAPlace();
+    *profiler_state = platform::ProfilerState::kAll;
+    *place = platform::CUDAPlace();
   } else {
     PADDLE_THROW(platform::errors::Unimplemented(
         "Not support %s in CostModel now", device));
   }
+}
 
+// Profiles one run of main_program in a new scope. With warmup, it is run
+// once before the profiler is enabled, so kernel creation is not measured.
+static CostData ProfileProgram(const ProgramDesc& main_program,
+                               const ProgramDesc& startup_program,
+                               const platform::Place& place,
+                               platform::ProfilerState profiler_state,
+                               bool warmup) {
   Executor executor(place);
   Scope scope;
   executor.Run(startup_program, &scope, /*block_id = */ 0);
+  if (warmup) {
+    executor.Run(main_program, &scope, /*block_id = */ 0);
+  }
 
   // TODO(zhhsplendid): handle the case that Profiler is already enabled
   SetTracerOption(platform::TracerOption::kAllOpDetail);
@@ -268,5 +293,213 @@ CostData CostModel::ProfileMeasure(
   return cost_data;
 }
 
+CostData CostModel::ProfileMeasure(
+    const ProgramDesc& main_program,
+    const ProgramDesc& startup_program,
+    const std::string& device,
+    const std::vector<std::string>& fetch_cost_list) const {
+  // Currently fetch_cost_list is useless
+  // TODO(zhhsplendid): support different fetch data
+
+  platform::ProfilerState profiler_state;
+  platform::Place place;
+  ParseDevice(device, &profiler_state, &place);
+  return ProfileProgram(
+      main_program, startup_program, place, profiler_state, false);
+}
+
+// The calibration measures each alternative kCalibrateRounds times,
+// interleaved with its baseline, and only acts on a median slowdown beyond
+// kCalibrateMargin, so that a noisy run does not end up in the decisions.
+static constexpr int kCalibrateRounds = 5;
+static constexpr double kCalibrateMargin = 0.05;
+
+static double Median(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  size_t mid = values.size() / 2;
+  return values.size() % 2 == 1 ? values[mid]
+                                 : (values[mid - 1] + values[mid]) / 2;
+}
+
+// Whether candidate_ms is slower than base_ms beyond the margin, by median.
+static bool IsSlower(const std::vector<double>& candidate_ms,
+                     const std::vector<double>& base_ms) {
+  return Median(candidate_ms) > Median(base_ms) * (1 + kCalibrateMargin);
+}
+
+// main_program in a new scope initialized by startup_program. When pass_name
+// is not empty, that pass is applied first with the new scope as param scope,
+// so it can fold the parameters.
+class CalibrationProgram {
+ public:
+  CalibrationProgram(const ProgramDesc& main_program,
+                     const ProgramDesc& startup_program,
+                     const platform::Place& place)
+      : executor_(place), program_(new ProgramDesc(main_program)) {
+    executor_.Run(startup_program, &scope_, /*block_id = */ 0);
+  }
+
+  // Returns false if the pass can not be applied.
+  bool ApplyPass(const std::string& pass_name) {
+    try {
+      Graph graph(*program_);
+      graph.SetNotOwned(ir::kParamScopeAttr, &scope_);
+      auto pass = ir::PassRegistry::Instance().Get(pass_name);
+      pass->Apply(&graph);
+      program_.reset(new ProgramDesc());
+      ir::GraphToProgram(graph, program_.get());
+    } catch (platform::EnforceNotMet& e) {
+      LOG(WARNING) << "Can not apply " << pass_name
+                   << " for calibration: " << e.what();
+      return false;
+    }
+    return true;
+  }
+
+  // Average time of repeat runs, after one warm up run.
+  double RunMs(int repeat) {
+    executor_.Run(*program_, &scope_, /*block_id = */ 0);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; ++i) {
+      executor_.Run(*program_, &scope_, /*block_id = */ 0);
+    }
+    std::chrono::duration<double, std::milli> cost =
+        std::chrono::steady_clock::now() - start;
+    return cost.count() / repeat;
+  }
+
+ private:
+  Executor executor_;
+  Scope scope_;
+  std::unique_ptr<ProgramDesc> program_;
+};
+
+#ifdef PADDLE_WITH_MKLDNN
+static ProgramDesc SetUseMKLDNN(const ProgramDesc& main_program, bool value) {
+  ProgramDesc program(main_program);
+  auto* block = program.MutableBlock(0);
+  for (auto* op : block->AllOps()) {
+    if (op->HasAttr("use_mkldnn")) {
+      op->SetAttr("use_mkldnn", value);
+    }
+  }
+  return program;
+}
+#endif
+
+CostDecisions CostModel::Calibrate(const ProgramDesc& main_program,
+                                   const ProgramDesc& startup_program,
+                                   const std::string& device,
+                                   const std::vector<std::string>& fuse_passes,
+                                   int repeat) const {
+  PADDLE_ENFORCE_GT(repeat,
+                    0,
+                    platform::errors::InvalidArgument(
+                        "The repeat of calibration should be larger than 0, "
+                        "but received %d.",
+                        repeat));
+  platform::ProfilerState profiler_state;
+  platform::Place place;
+  ParseDevice(device, &profiler_state, &place);
+
+  CostDecisions decisions;
+  if (main_program.Size() == 0 || main_program.Block(0).OpSize() == 0) {
+    return decisions;
+  }
+
+  for (auto& pass_name : fuse_passes) {
+    CalibrationProgram base(main_program, startup_program, place);
+    CalibrationProgram fused(main_program, startup_program, place);
+    if (!fused.ApplyPass(pass_name)) {
+      continue;
+    }
+    std::vector<double> base_ms, fused_ms;
+    for (int i = 0; i < kCalibrateRounds; ++i) {
+      base_ms.push_back(base.RunMs(repeat));
+      fused_ms.push_back(fused.RunMs(repeat));
+    }
+    VLOG(3) << "Calibrate " << pass_name << ": " << Median(base_ms)
+            << " ms -> " << Median(fused_ms) << " ms";
+    if (IsSlower(fused_ms, base_ms)) {
+      decisions.DisablePass(pass_name);
+    }
+  }
+
+#ifdef PADDLE_WITH_MKLDNN
+  if (platform::is_cpu_place(place)) {
+    auto mkldnn_program = SetUseMKLDNN(main_program, true);
+    auto native_program = SetUseMKLDNN(main_program, false);
+    std::unordered_map<std::string, std::vector<double>> mkldnn_ms, native_ms;
+    for (int i = 0; i < kCalibrateRounds; ++i) {
+      auto mkldnn_round =
+          ProfileProgram(
+              mkldnn_program, startup_program, place, profiler_state, true)
+              .GetOpTypeTimeMs(mkldnn_program);
+      auto native_round =
+          ProfileProgram(
+              native_program, startup_program, place, profiler_state, true)
+              .GetOpTypeTimeMs(native_program);
+      for (auto& item : mkldnn_round) {
+        mkldnn_ms[item.first].push_back(item.second);
+      }
+      for (auto& item : native_round) {
+        native_ms[item.first].push_back(item.second);
+      }
+    }
+    for (auto& item : mkldnn_ms) {
+      auto iter = native_ms.find(item.first);
+      if (iter != native_ms.end() &&
+          iter->second.size() == item.second.size() &&
+          IsSlower(item.second, iter->second)) {
+        VLOG(3) << "Calibrate " << item.first << ": oneDNN "
+                << Median(item.second) << " ms, native "
+                << Median(iter->second) << " ms";
+        decisions.UseNativeKernel(item.first);
+      }
+    }
+  }
+#endif
+  return decisions;
+}
+
+void CostDecisions::Save(const std::string& path) const {
+  std::ofstream fout(path);
+  PADDLE_ENFORCE_EQ(
+      fout.is_open(),
+      true,
+      platform::errors::Unavailable("Can not open %s to save the cost "
+                                    "decisions.",
+                                    path));
+  for (auto& pass_name : disabled_passes_) {
+    fout << "disable_pass " << pass_name << "\n";
+  }
+  for (auto& op_type : native_kernel_op_types_) {
+    fout << "native_kernel " << op_type << "\n";
+  }
+}
+
+bool CostDecisions::Load(const std::string& path) {
+  std::ifstream fin(path);
+  if (!fin.is_open()) {
+    return false;
+  }
+  std::string line;
+  while (std::getline(fin, line)) {
+    std::istringstream is(line);
+    std::string kind, name;
+    if (!(is >> kind >> name)) {
+      continue;
+    }
+    if (kind == "disable_pass") {
+      DisablePass(name);
+    } else if (kind == "native_kernel") {
+      UseNativeKernel(name);
+    } else {
+      LOG(WARNING) << "Unknown cost decision '" << kind << "' in " << path;
+    }
+  }
+  return true;
+}
+
 }  // namespace framework
 }  // namespace paddle
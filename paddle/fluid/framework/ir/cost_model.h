@@ -43,6 +43,9 @@ class CostData {
   double GetOpMemoryBytes(int op_id) const;
   double GetWholeTimeMs() const;
   double GetWholeMemoryBytes() const;
+  // sum of the measured op times of each op type in the global block
+  std::map<std::string, double> GetOpTypeTimeMs(
+      const ProgramDesc& program) const;
 
   const ir::Graph* GetGraph() const;
   const ProgramDesc* GetProgram() const;
@@ -70,6 +73,44 @@ class CostData {
       NOT_MEASURED};  // communication cost of the whole program or graph
 };
 
+// Decisions taken from measured costs: the fuse passes which made the
+// program slower, and the op types which run faster with the native kernels
+// than with oneDNN. They are saved as text, one decision per line, so that
+// they can be kept next to an optimized model and applied when it is loaded.
+class CostDecisions {
+ public:
+  void DisablePass(const std::string& pass_name) {
+    disabled_passes_.insert(pass_name);
+  }
+  bool IsPassDisabled(const std::string& pass_name) const {
+    return disabled_passes_.count(pass_name) > 0;
+  }
+  void UseNativeKernel(const std::string& op_type) {
+    native_kernel_op_types_.insert(op_type);
+  }
+  bool IsNativeKernel(const std::string& op_type) const {
+    return native_kernel_op_types_.count(op_type) > 0;
+  }
+
+  const std::unordered_set<std::string>& disabled_passes() const {
+    return disabled_passes_;
+  }
+  const std::unordered_set<std::string>& native_kernel_op_types() const {
+    return native_kernel_op_types_;
+  }
+  bool Empty() const {
+    return disabled_passes_.empty() && native_kernel_op_types_.empty();
+  }
+
+  void Save(const std::string& path) const;
+  // Returns false if path can not be read.
+  bool Load(const std::string& path);
+
+ private:
+  std::unordered_set<std::string> disabled_passes_;
+  std::unordered_set<std::string> native_kernel_op_types_;
+};
+
 class CostModel {
  public:
   CostModel() {}
@@ -80,6 +121,18 @@ class CostModel {
       const ProgramDesc& startup_program,
       const std::string& device,
       const std::vector<std::string>& fetch_cost_list) const;
+
+  // Runs main_program without any pass and with each of fuse_passes applied
+  // alone, in interleaved rounds of repeat runs, and disables the passes
+  // whose median time is more than 5% slower. On CPU with oneDNN, the op
+  // types are also profiled with and without use_mkldnn, and the ones more
+  // than 5% faster natively are recorded.
+  // Like ProfileMeasure, main_program must run without feeds.
+  CostDecisions Calibrate(const ProgramDesc& main_program,
+                          const ProgramDesc& startup_program,
+                          const std::string& device,
+                          const std::vector<std::string>& fuse_passes,
+                          int repeat = 10) const;
 };
 
 }  // namespace framework
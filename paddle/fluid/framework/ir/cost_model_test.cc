@@ -14,7 +14,12 @@
 
 #include "paddle/fluid/framework/ir/cost_model.h"
 
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <thread>  // NOLINT
+
 #include "gtest/gtest.h"
+#include "paddle/fluid/framework/ir/pass.h"
 #include "paddle/fluid/framework/op_registry.h"
 #include "paddle/fluid/framework/operator.h"
 #include "paddle/fluid/framework/program_desc.h"
@@ -31,6 +36,7 @@ class FakeTestOpMaker : public OpProtoAndCheckerMaker {
     AddInput("X", "").AsDuplicable();
     AddInput("Y", "").AsDuplicable();
     AddOutput("Out", "").AsDuplicable();
+    AddAttr<int>("sleep_us", "").SetDefault(0);
     AddComment("");
   }
 };
@@ -56,15 +62,51 @@ class FakeTestOp : public OperatorBase {
     while (count <= 1000) {
       ++count;
     }
+    std::this_thread::sleep_for(
+        std::chrono::microseconds(Attr<int>("sleep_us")));
+  }
+};
+
+namespace ir {
+
+// Makes every fake_test_op sleep for sleep_us.
+class TestSleepPass : public Pass {
+ public:
+  explicit TestSleepPass(int sleep_us) : sleep_us_(sleep_us) {}
+
+ protected:
+  void ApplyImpl(Graph *graph) const override {
+    for (auto *node : graph->Nodes()) {
+      if (node->IsOp() && node->Op()->Type() == "fake_test_op") {
+        node->Op()->SetAttr("sleep_us", sleep_us_);
+      }
+    }
   }
+
+ private:
+  int sleep_us_;
 };
 
+class TestSlowDownPass : public TestSleepPass {
+ public:
+  TestSlowDownPass() : TestSleepPass(2000) {}
+};
+
+class TestKeepSpeedPass : public TestSleepPass {
+ public:
+  TestKeepSpeedPass() : TestSleepPass(500) {}
+};
+
+}  // namespace ir
+
 }  // namespace framework
 }  // namespace paddle
 
 REGISTER_OPERATOR(fake_test_op,
                   paddle::framework::FakeTestOp,
                   paddle::framework::FakeTestOpMaker);
+REGISTER_PASS(test_slow_down_pass, paddle::framework::ir::TestSlowDownPass);
+REGISTER_PASS(test_keep_speed_pass, paddle::framework::ir::TestKeepSpeedPass);
 
 namespace paddle {
 namespace framework {
@@ -135,6 +177,73 @@ TEST(CostModelTest, TestProfileMeasure_Program) {
   EXPECT_GT(cost_data.GetWholeTimeMs(), op0_time_ms + op1_time_ms);
 }
 
+TEST(CostModelTest, TestProfileMeasure_OpTypeTime) {
+  CostModel cost_model;
+  ProgramDesc program = CreateTestProgram();
+  ProgramDesc empty_program;
+  CostData cost_data =
+      cost_model.ProfileMeasure(program, empty_program, "cpu", {"time"});
+  auto op_type_time_ms = cost_data.GetOpTypeTimeMs(program);
+  EXPECT_EQ(op_type_time_ms.size(), 1UL);
+  EXPECT_DOUBLE_EQ(op_type_time_ms["fake_test_op"],
+                   cost_data.GetOpTimeMs(0) + cost_data.GetOpTimeMs(1));
+}
+
+TEST(CostModelTest, TestCalibrate_Program) {
+  CostModel cost_model;
+  ProgramDesc program = CreateTestProgram();
+  ProgramDesc empty_program;
+  // a pass which can not be applied is kept
+  CostDecisions decisions = cost_model.Calibrate(
+      program, empty_program, "cpu", {"not_registered_fuse_pass"}, 2);
+  EXPECT_FALSE(decisions.IsPassDisabled("not_registered_fuse_pass"));
+  EXPECT_THROW(cost_model.Calibrate(program, empty_program, "cpu", {}, 0),
+               paddle::platform::EnforceNotMet);
+}
+
+TEST(CostModelTest, TestCalibrate_RegisteredPass) {
+  CostModel cost_model;
+  ProgramDesc program = CreateTestProgram();
+  for (auto *op : program.MutableBlock(0)->AllOps()) {
+    op->SetAttr("sleep_us", 500);
+  }
+  ProgramDesc empty_program;
+  CostDecisions decisions =
+      cost_model.Calibrate(program,
+                           empty_program,
+                           "cpu",
+                           {"test_slow_down_pass", "test_keep_speed_pass"},
+                           2);
+  EXPECT_TRUE(decisions.IsPassDisabled("test_slow_down_pass"));
+  EXPECT_FALSE(decisions.IsPassDisabled("test_keep_speed_pass"));
+
+  std::string path = "cost_decisions_calibrate_test.txt";
+  decisions.Save(path);
+  CostDecisions loaded;
+  EXPECT_TRUE(loaded.Load(path));
+  EXPECT_TRUE(loaded.IsPassDisabled("test_slow_down_pass"));
+  EXPECT_EQ(loaded.disabled_passes().size(), 1UL);
+  std::remove(path.c_str());
+}
+
+TEST(CostDecisionsTest, TestSaveLoad) {
+  CostDecisions decisions;
+  EXPECT_TRUE(decisions.Empty());
+  decisions.DisablePass("fc_fuse_pass");
+  decisions.UseNativeKernel("conv2d");
+  std::string path = "cost_decisions_test.txt";
+  decisions.Save(path);
+
+  CostDecisions loaded;
+  EXPECT_TRUE(loaded.Load(path));
+  EXPECT_TRUE(loaded.IsPassDisabled("fc_fuse_pass"));
+  EXPECT_FALSE(loaded.IsPassDisabled("conv_bn_fuse_pass"));
+  EXPECT_TRUE(loaded.IsNativeKernel("conv2d"));
+  EXPECT_EQ(loaded.native_kernel_op_types().size(), 1UL);
+  EXPECT_FALSE(loaded.Load("not_exist_cost_decisions.txt"));
+  std::remove(path.c_str());
+}
+
 TEST(CostModelTest, TestProfileMeasure_UnsupportedDevice) {
   CostModel cost_model;
   ProgramDesc program = CreateTestProgram();
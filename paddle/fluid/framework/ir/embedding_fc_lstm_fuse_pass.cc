@@ -302,7 +302,8 @@ void EmbeddingFCLSTMFusePass::ApplyImpl(ir::Graph* graph) const {
 }  // namespace paddle
 
 REGISTER_PASS(embedding_fc_lstm_fuse_pass,
-              paddle::framework::ir::EmbeddingFCLSTMFusePass);
+              paddle::framework::ir::EmbeddingFCLSTMFusePass)
+    .AnchorOpTypes({"lstm"});
 REGISTER_PASS_CAPABILITY(embedding_fc_lstm_fuse_pass)
     .AddCombination(
         paddle::framework::compatible::OpVersionComparatorCombination()
@@ -306,7 +306,8 @@ int FCFusePass::ApplyFCPattern(Graph* graph, bool with_relu) const {
 }  // namespace paddle
 
 REGISTER_PASS(fc_fuse_pass, paddle::framework::ir::FCFusePass)
-    .RequirePassAttr("use_gpu");
+    .RequirePassAttr("use_gpu")
+    .AnchorOpTypes({"mul"});
 REGISTER_PASS_CAPABILITY(fc_fuse_pass)
     .AddCombination(
         paddle::framework::compatible::OpVersionComparatorCombination()
@@ -359,8 +359,10 @@ void FCGRUFusePass::ApplyImpl(ir::Graph* graph) const {
 }  // namespace framework
 }  // namespace paddle
 
-REGISTER_PASS(mul_gru_fuse_pass, paddle::framework::ir::MulGRUFusePass);
-REGISTER_PASS(fc_gru_fuse_pass, paddle::framework::ir::FCGRUFusePass);
+REGISTER_PASS(mul_gru_fuse_pass, paddle::framework::ir::MulGRUFusePass)
+    .AnchorOpTypes({"gru"});
+REGISTER_PASS(fc_gru_fuse_pass, paddle::framework::ir::FCGRUFusePass)
+    .AnchorOpTypes({"gru"});
 REGISTER_PASS_CAPABILITY(mul_gru_fuse_pass)
     .AddCombination(
         paddle::framework::compatible::OpVersionComparatorCombination()
@@ -384,8 +384,10 @@ void FCLstmFusePass::ApplyImpl(ir::Graph* graph) const {
 }  // namespace framework
 }  // namespace paddle
 
-REGISTER_PASS(mul_lstm_fuse_pass, paddle::framework::ir::MulLstmFusePass);
-REGISTER_PASS(fc_lstm_fuse_pass, paddle::framework::ir::FCLstmFusePass);
+REGISTER_PASS(mul_lstm_fuse_pass, paddle::framework::ir::MulLstmFusePass)
+    .AnchorOpTypes({"lstm"});
+REGISTER_PASS(fc_lstm_fuse_pass, paddle::framework::ir::FCLstmFusePass)
+    .AnchorOpTypes({"lstm"});
 
 REGISTER_PASS_CAPABILITY(fc_lstm_fuse_pass)
     .AddCombination(
@@ -32,7 +32,8 @@ class SubGraph;
 
 class CodeGenerator {
  public:
-  CodeGenerator();
+  // is_cpu selects C++ code for CPUDeviceCode instead of CUDA code.
+  explicit CodeGenerator(bool is_cpu = false);
 
   std::string Generate(std::string func_name,
                        const std::vector<OperationExpression>& expressions);
@@ -58,6 +59,14 @@ class CodeGenerator {
       const std::set<int>& intermediate_ids,
       const std::unordered_map<int, std::string>& dtypes) const;
 
+  // the arguments passed from the exported CPU function to the kernel,
+  //  unpacked from void** args in the order of EmitParameters
+  std::string EmitArguments(
+      const std::set<int>& input_ids,
+      const std::set<int>& output_ids,
+      const std::set<int>& intermediate_ids,
+      const std::unordered_map<int, std::string>& dtypes) const;
+
   std::string EmitComputeBody(
       const std::vector<OperationExpression>& expressions,
       const std::set<int>& input_ids,
@@ -69,6 +78,7 @@ class CodeGenerator {
   std::unordered_map<Node*, int> EncodeVarNodes(SubGraph* subgraph);
 
  private:
+  bool is_cpu_;
   std::vector<CodeTemplate> code_templates_;
 };
 
@@ -173,6 +173,9 @@ std::string OperationExpression::GetRHS(std::unordered_set<int>* used,
       std::string number_str = rhs.substr(pos + 2, length);
       if (rhs_type_ == "__half")
         number_str = "__float2half(" + number_str + ")";
+      // keep float expressions in float instead of promoting them to double
+      else if (rhs_type_ == "float")
+        number_str = "static_cast<float>(" + number_str + ")";
       rhs.replace(pos, length + 3, number_str);
       pos = pos + number_str.length();
     }
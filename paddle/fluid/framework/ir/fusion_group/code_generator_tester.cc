@@ -27,8 +27,6 @@ namespace phi {
 class DenseTensor;
 }  // namespace phi
 
-#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
-
 namespace paddle {
 namespace framework {
 namespace ir {
@@ -171,6 +169,7 @@ void SetupRandomCPUTensor(LoDTensor* tensor) {
 
 namespace fusion_group = paddle::framework::ir::fusion_group;
 
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
 template <typename T>
 void TestMainImpl(std::string func_name,
                   std::string code_str,
@@ -253,6 +252,44 @@ void TestMainImpl(std::string func_name,
     }
   }
 }
+#endif
+
+// The CPU kernel reads and writes the CPU tensors directly.
+void TestMainImplCPU(std::string func_name,
+                     std::string code_str,
+                     std::vector<paddle::framework::LoDTensor> cpu_tensors,
+                     int n,
+                     std::vector<int> input_ids,
+                     std::vector<int> output_ids) {
+  paddle::platform::CPUPlace place;
+  paddle::platform::CPUDeviceCode device_code(place, func_name, code_str);
+  ASSERT_EQ(device_code.Compile(), true);
+
+  std::vector<float*> cpu_ptrs(cpu_tensors.size());
+  std::vector<void*> args;
+  args.push_back(&n);
+
+  for (auto id : input_ids) {
+    if (id >= 0) {
+      fusion_group::SetupRandomCPUTensor<float>(&cpu_tensors[id]);
+      cpu_ptrs[id] = cpu_tensors[id].data<float>();
+      args.push_back(&cpu_ptrs[id]);
+    }
+  }
+
+  for (auto id : output_ids) {
+    cpu_ptrs[id] = cpu_tensors[id].mutable_data<float>(cpu_tensors[id].dims(),
+                                                       place);
+    args.push_back(&cpu_ptrs[id]);
+  }
+
+  device_code.Launch(n, &args);
+}
+
+bool IsCPUDeviceCodeAvailable() {
+  paddle::platform::CPUDeviceCode::CheckAvailableStatus();
+  return paddle::platform::CPUDeviceCode::IsAvailable();
+}
 
 void TestElementwiseMain(
     std::string func_name,
@@ -260,7 +297,8 @@ void TestElementwiseMain(
     std::vector<fusion_group::OperationExpression> expressions,
     std::vector<int> input_ids,
     std::vector<int> output_ids,
-    std::string dtype) {
+    std::string dtype,
+    bool is_cpu) {
   std::unordered_set<int> ids;
   for (auto id : input_ids) {
     ids.insert(id);
@@ -278,12 +316,18 @@ void TestElementwiseMain(
   }
 
   int n = cpu_tensors[0].numel();
-  if (dtype == "__half") {
-    TestMainImpl<paddle::platform::float16>(
-        func_name, code_str, cpu_tensors, n, input_ids, output_ids);
+  if (is_cpu) {
+    TestMainImplCPU(func_name, code_str, cpu_tensors, n, input_ids, output_ids);
   } else {
-    TestMainImpl<float>(
-        func_name, code_str, cpu_tensors, n, input_ids, output_ids);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    if (dtype == "__half") {
+      TestMainImpl<paddle::platform::float16>(
+          func_name, code_str, cpu_tensors, n, input_ids, output_ids);
+    } else {
+      TestMainImpl<float>(
+          func_name, code_str, cpu_tensors, n, input_ids, output_ids);
+    }
+#endif
   }
 
   // Check the results
@@ -298,23 +342,25 @@ void TestMain(std::string func_name,
               std::vector<fusion_group::OperationExpression> expressions,
               std::vector<int> input_ids,
               std::vector<int> output_ids,
-              std::string dtype) {
+              std::string dtype,
+              bool is_cpu = false) {
   fusion_group::OperationMap::Init();
-  fusion_group::CodeGenerator code_generator;
+  fusion_group::CodeGenerator code_generator(is_cpu);
   std::string code_str = code_generator.Generate(func_name, expressions);
   VLOG(3) << code_str;
 
   LOG(INFO) << "dtype: " << dtype;
   TestElementwiseMain(
-      func_name, code_str, expressions, input_ids, output_ids, dtype);
+      func_name, code_str, expressions, input_ids, output_ids, dtype, is_cpu);
 }
 
 void TestMain(fusion_group::SubGraph* subgraph,
               std::vector<int> input_ids,
               std::vector<int> output_ids,
-              std::string dtype) {
+              std::string dtype,
+              bool is_cpu = false) {
   fusion_group::OperationMap::Init();
-  fusion_group::CodeGenerator code_generator;
+  fusion_group::CodeGenerator code_generator(is_cpu);
   std::string code_str = code_generator.Generate(subgraph);
   VLOG(3) << code_str;
 
@@ -327,60 +373,66 @@ void TestMain(fusion_group::SubGraph* subgraph,
                       expressions,
                       input_ids,
                       output_ids,
-                      dtype);
+                      dtype,
+                      is_cpu);
 }
 
-TEST(code_generator, elementwise) {
-  for (std::string dtype : {"float", "__half"}) {
-    // t2 = t0 * t1
-    // t4 = t2 + t3
-    // t6 = t4 - t5
-    // t7 = relu(t6)
-    // t8 = sigmoid(t7)
-    fusion_group::OperationExpression exp1(
-        "elementwise_mul", {0, 1}, {2}, dtype, dtype);
-    fusion_group::OperationExpression exp2(
-        "elementwise_add", {2, 3}, {4}, dtype, dtype);
-    fusion_group::OperationExpression exp3(
-        "elementwise_sub", {4, 5}, {6}, dtype, dtype);
-    fusion_group::OperationExpression exp4("relu", {6}, {7}, dtype, dtype);
-    fusion_group::OperationExpression exp5("sigmoid", {7}, {8}, dtype, dtype);
-    std::vector<fusion_group::OperationExpression> expressions = {
-        exp1, exp2, exp3, exp4, exp5};
-
-    // Expressions:
-    //  Op(elementwise_mul), inputs:{0,1}, outputs:{2}
-    //  Op(elementwise_add), inputs:{2,3}, outputs:{4}
-    //  Op(elementwise_sub), inputs:{4,5}, outputs:{6}
-    //  Op(relu), inputs:{6}, outputs:{7}
-    //  Op(sigmoid), inputs:{7}, outputs:{8}
-    std::vector<int> input_ids = {0, 1, 3, 5};
-    std::vector<int> output_ids = {2, 4, 6, 7, 8};
-    TestMain("elementwise_kernel_0", expressions, input_ids, output_ids, dtype);
-  }
+void TestElementwise(std::string dtype, bool is_cpu) {
+  // t2 = t0 * t1
+  // t4 = t2 + t3
+  // t6 = t4 - t5
+  // t7 = relu(t6)
+  // t8 = sigmoid(t7)
+  fusion_group::OperationExpression exp1(
+      "elementwise_mul", {0, 1}, {2}, dtype, dtype);
+  fusion_group::OperationExpression exp2(
+      "elementwise_add", {2, 3}, {4}, dtype, dtype);
+  fusion_group::OperationExpression exp3(
+      "elementwise_sub", {4, 5}, {6}, dtype, dtype);
+  fusion_group::OperationExpression exp4("relu", {6}, {7}, dtype, dtype);
+  fusion_group::OperationExpression exp5("sigmoid", {7}, {8}, dtype, dtype);
+  std::vector<fusion_group::OperationExpression> expressions = {
+      exp1, exp2, exp3, exp4, exp5};
+
+  // Expressions:
+  //  Op(elementwise_mul), inputs:{0,1}, outputs:{2}
+  //  Op(elementwise_add), inputs:{2,3}, outputs:{4}
+  //  Op(elementwise_sub), inputs:{4,5}, outputs:{6}
+  //  Op(relu), inputs:{6}, outputs:{7}
+  //  Op(sigmoid), inputs:{7}, outputs:{8}
+  std::vector<int> input_ids = {0, 1, 3, 5};
+  std::vector<int> output_ids = {2, 4, 6, 7, 8};
+  TestMain("elementwise_kernel_0",
+           expressions,
+           input_ids,
+           output_ids,
+           dtype,
+           is_cpu);
 }
 
-TEST(code_generator, elementwise_grad) {
-  for (std::string dtype : {"float", "__half"}) {
-    // The var order: t0, t1, t2, t3, t0', t1', t2', t3'
-    // t2 = t0 * t1
-    // t3 = relu(t2)
-    // t2' = relu_grad(t2, t3, t3')
-    // t0', t1' = elementwise_mul_grad(t0, t1, t2, t2')
-    fusion_group::OperationExpression exp1(
-        "relu_grad", {-1, 3, 7}, {6}, dtype, dtype);
-    fusion_group::OperationExpression exp2(
-        "elementwise_mul_grad", {0, 1, 2, 6}, {4, 5}, dtype, dtype);
-    std::vector<fusion_group::OperationExpression> expressions = {exp1, exp2};
-
-    // Expressions:
-    //  Op(relu_grad), inputs:{2,3,7}, outputs:{6}
-    //  Op(elementwise_mul_grad), inputs:{0,1,2,6}, outputs:{4,5}
-    std::vector<int> input_ids = {0, 1, 2, 3, 7};
-    std::vector<int> output_ids = {4, 5, 6};
-    TestMain(
-        "elementwise_grad_kernel_0", expressions, input_ids, output_ids, dtype);
-  }
+void TestElementwiseGrad(std::string dtype, bool is_cpu) {
+  // The var order: t0, t1, t2, t3, t0', t1', t2', t3'
+  // t2 = t0 * t1
+  // t3 = relu(t2)
+  // t2' = relu_grad(t2, t3, t3')
+  // t0', t1' = elementwise_mul_grad(t0, t1, t2, t2')
+  fusion_group::OperationExpression exp1(
+      "relu_grad", {-1, 3, 7}, {6}, dtype, dtype);
+  fusion_group::OperationExpression exp2(
+      "elementwise_mul_grad", {0, 1, 2, 6}, {4, 5}, dtype, dtype);
+  std::vector<fusion_group::OperationExpression> expressions = {exp1, exp2};
+
+  // Expressions:
+  //  Op(relu_grad), inputs:{2,3,7}, outputs:{6}
+  //  Op(elementwise_mul_grad), inputs:{0,1,2,6}, outputs:{4,5}
+  std::vector<int> input_ids = {0, 1, 2, 3, 7};
+  std::vector<int> output_ids = {4, 5, 6};
+  TestMain("elementwise_grad_kernel_0",
+           expressions,
+           input_ids,
+           output_ids,
+           dtype,
+           is_cpu);
 }
 
 std::unique_ptr<paddle::framework::ir::Graph> BuildGraph(bool backward,
@@ -477,41 +529,91 @@ std::unordered_set<paddle::framework::ir::Node*> DistilGradNodes(
   return grad_nodes;
 }
 
+void TestSubgraph(std::string dtype, bool is_cpu) {
+  std::unique_ptr<paddle::framework::ir::Graph> graph =
+      BuildGraph(false, dtype);
+  fusion_group::SubGraph subgraph(
+      0, "elementwise_kernel_1", true, graph->Nodes());
+
+  // Expressions generated by code_generator (they may be different):
+  //  Op(sigmoid), inputs:{0}, outputs:{4}
+  //  Op(elementwise_mul), inputs:{4,1}, outputs:{7}
+  //  Op(tanh), inputs:{2}, outputs:{5}
+  //  Op(elementwise_mul), inputs:{3,5}, outputs:{6}
+  //  Op(elementwise_add), inputs:{7,6}, outputs:{8}
+  std::vector<int> input_ids = {0, 1, 2, 3};
+  std::vector<int> output_ids = {4, 5, 6, 7, 8};
+  TestMain(&subgraph, input_ids, output_ids, dtype, is_cpu);
+}
+
+void TestSubgraphGrad(std::string dtype, bool is_cpu) {
+  std::unique_ptr<paddle::framework::ir::Graph> graph =
+      BuildGraph(true, dtype);
+  fusion_group::SubGraph subgraph(
+      0, "elementwise_grad_kernel_1", true, DistilGradNodes(graph));
+
+  // Expressions generated by code_generator (they may be different):
+  //  Op(elementwise_add_grad), inputs:{1,2,3,0}, outputs:{11,10}
+  //  Op(elementwise_mul_grad), inputs:{5,4,2,10}, outputs:{17,13}
+  //  Op(elementwise_mul_grad), inputs:{7,6,1,11}, outputs:{12,15}
+  //  Op(sigmoid_grad), inputs:{8,7,12}, outputs:{16}
+  //  Op(tanh_grad), inputs:{9,4,13}, outputs:{14}
+  std::vector<int> input_ids = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<int> output_ids = {10, 11, 12, 13, 14, 15, 16, 17};
+  TestMain(&subgraph, input_ids, output_ids, dtype, is_cpu);
+}
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+TEST(code_generator, elementwise) {
+  for (std::string dtype : {"float", "__half"}) {
+    TestElementwise(dtype, false);
+  }
+}
+
+TEST(code_generator, elementwise_grad) {
+  for (std::string dtype : {"float", "__half"}) {
+    TestElementwiseGrad(dtype, false);
+  }
+}
+
 TEST(code_generator, subgraph) {
   for (std::string dtype : {"float", "__half"}) {
-    std::unique_ptr<paddle::framework::ir::Graph> graph =
-        BuildGraph(false, dtype);
-    fusion_group::SubGraph subgraph(
-        0, "elementwise_kernel_1", true, graph->Nodes());
-
-    // Expressions generated by code_generator (they may be different):
-    //  Op(sigmoid), inputs:{0}, outputs:{4}
-    //  Op(elementwise_mul), inputs:{4,1}, outputs:{7}
-    //  Op(tanh), inputs:{2}, outputs:{5}
-    //  Op(elementwise_mul), inputs:{3,5}, outputs:{6}
-    //  Op(elementwise_add), inputs:{7,6}, outputs:{8}
-    std::vector<int> input_ids = {0, 1, 2, 3};
-    std::vector<int> output_ids = {4, 5, 6, 7, 8};
-    TestMain(&subgraph, input_ids, output_ids, dtype);
+    TestSubgraph(dtype, false);
   }
 }
 
 TEST(code_generator, subgraph_grad) {
   for (std::string dtype : {"float", "__half"}) {
-    std::unique_ptr<paddle::framework::ir::Graph> graph =
-        BuildGraph(true, dtype);
-    fusion_group::SubGraph subgraph(
-        0, "elementwise_grad_kernel_1", true, DistilGradNodes(graph));
-
-    // Expressions generated by code_generator (they may be different):
-    //  Op(elementwise_add_grad), inputs:{1,2,3,0}, outputs:{11,10}
-    //  Op(elementwise_mul_grad), inputs:{5,4,2,10}, outputs:{17,13}
-    //  Op(elementwise_mul_grad), inputs:{7,6,1,11}, outputs:{12,15}
-    //  Op(sigmoid_grad), inputs:{8,7,12}, outputs:{16}
-    //  Op(tanh_grad), inputs:{9,4,13}, outputs:{14}
-    std::vector<int> input_ids = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
-    std::vector<int> output_ids = {10, 11, 12, 13, 14, 15, 16, 17};
-    TestMain(&subgraph, input_ids, output_ids, dtype);
+    TestSubgraphGrad(dtype, false);
   }
 }
 #endif
+
+// float16 is not supported by the CPU code.
+TEST(code_generator, elementwise_cpu) {
+  if (!IsCPUDeviceCodeAvailable()) {
+    return;
+  }
+  TestElementwise("float", true);
+}
+
+TEST(code_generator, elementwise_grad_cpu) {
+  if (!IsCPUDeviceCodeAvailable()) {
+    return;
+  }
+  TestElementwiseGrad("float", true);
+}
+
+TEST(code_generator, subgraph_cpu) {
+  if (!IsCPUDeviceCodeAvailable()) {
+    return;
+  }
+  TestSubgraph("float", true);
+}
+
+TEST(code_generator, subgraph_grad_cpu) {
+  if (!IsCPUDeviceCodeAvailable()) {
+    return;
+  }
+  TestSubgraphGrad("float", true);
+}
@@ -0,0 +1,73 @@
+/* Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#pragma once
+
+namespace paddle {
+namespace framework {
+namespace ir {
+namespace fusion_group {
+
+// glibc has vector versions of the math functions in libmvec. Declaring them
+// simd lets gcc vectorize the loops calling them.
+static constexpr char predefined_cpu_functions[] = R"(
+#include <cmath>
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && \
+    defined(__GLIBC__)
+extern "C" float expf(float) noexcept __attribute__((simd("notinbranch")));
+extern "C" float logf(float) noexcept __attribute__((simd("notinbranch")));
+extern "C" double exp(double) noexcept __attribute__((simd("notinbranch")));
+extern "C" double log(double) noexcept __attribute__((simd("notinbranch")));
+#endif
+
+)";
+
+static constexpr char predefined_cpu_functions_fp32[] = R"(
+static inline float Max(float x, float y) { return x > y ? x : y; }
+static inline float Exp(float x) { return expf(x); }
+static inline float Log(float x) { return logf(x); }
+static inline float Sqrt(float x) { return sqrtf(x); }
+
+)";
+
+static constexpr char predefined_cpu_functions_fp64[] = R"(
+static inline double Max(double x, double y) { return x > y ? x : y; }
+static inline double Exp(double x) { return exp(x); }
+static inline double Log(double x) { return log(x); }
+static inline double Sqrt(double x) { return sqrt(x); }
+
+)";
+
+// The loop is kept in a function with restrict pointers so that the host
+// compiler vectorizes it, the exported function unpacks the arguments.
+static constexpr char cpu_kernel_template_1d[] = R"(
+static void $func_name_impl($parameters) {
+#pragma omp simd
+  for(int idx = 0;
+      idx < N;
+      ++idx) {
+    $compute_body
+  }
+}
+
+extern "C" void $func_name(int N, void** args) {
+  $func_name_impl(N, $arguments);
+}
+)";
+
+}  // namespace fusion_group
+}  // namespace ir
+}  // namespace framework
+}  // namespace paddle
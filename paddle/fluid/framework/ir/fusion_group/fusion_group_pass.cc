@@ -14,6 +14,8 @@ limitations under the License. */
 
 #include "paddle/fluid/framework/ir/fusion_group/fusion_group_pass.h"
 
+#include <algorithm>
+
 #include "paddle/fluid/framework/ir/fusion_group/code_generator.h"
 #include "paddle/fluid/framework/ir/fusion_group/elementwise_group_detector.h"
 #include "paddle/fluid/framework/ir/graph_pattern_detector.h"
@@ -44,16 +46,51 @@ void FusionGroupPass::ApplyImpl(ir::Graph* graph) const {
     // }
 
     fusion_group::OperationMap::Init();
-    int num_elementwise_groups = DetectFusionGroup(graph, 0);
+    // TODO(liuyiqun): supported different places
+    int num_elementwise_groups =
+        DetectFusionGroup(graph, platform::CUDAPlace(0), 0);
     AddStatis(num_elementwise_groups);
     LOG(INFO) << "Detect " << num_elementwise_groups
               << " elementwise fusion groups.";
+  } else {
+    platform::CPUPlace place;
+    platform::DeviceCodePool::Init({place});
+    if (!platform::CPUDeviceCode::IsAvailable()) {
+      LOG(WARNING) << "Disable fusion_group because the host compiler is not "
+                      "available.";
+      return;
+    }
+
+    fusion_group::OperationMap::Init();
+    int num_elementwise_groups = DetectFusionGroup(graph, place, 0);
+    AddStatis(num_elementwise_groups);
+    LOG(INFO) << "Detect " << num_elementwise_groups
+              << " elementwise fusion groups for CPU.";
   }
 }
 
-int FusionGroupPass::DetectFusionGroup(Graph* graph, int type) const {
-  // TODO(liuyiqun): supported different places
-  platform::CUDAPlace place = platform::CUDAPlace(0);
+// float16 is only supported by the CUDA code.
+static bool HasFP16Var(const std::vector<Node*>& nodes) {
+  auto is_fp16 = [](Node* n) {
+    return n->IsVar() && n->Var() &&
+           n->Var()->GetDataType() == proto::VarType::FP16;
+  };
+  for (auto* n : nodes) {
+    if (is_fp16(n)) {
+      return true;
+    }
+    if (n->IsOp() &&
+        (std::any_of(n->inputs.begin(), n->inputs.end(), is_fp16) ||
+         std::any_of(n->outputs.begin(), n->outputs.end(), is_fp16))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int FusionGroupPass::DetectFusionGroup(Graph* graph,
+                                       const platform::Place& place,
+                                       int type) const {
   int index = platform::DeviceCodePool::Init({place}).size(place);
 
   std::vector<std::vector<Node*>> subgraphs =
@@ -70,9 +107,12 @@ int FusionGroupPass::DetectFusionGroup(Graph* graph, int type) const {
         std::unordered_set<Node*>(vec.begin(), vec.end()));
     VLOG(3) << "subgraph: {\n" << DebugString(subgraph.SortedNodes()) << "}\n";
 
+    if (platform::is_cpu_place(place) && HasFP16Var(vec)) {
+      continue;
+    }
     if (subgraph.IsValid(min_subgraph_size)) {
       subgraph.SetFuncName("fused_elementwise_" + std::to_string(index++));
-      if (GenerateCode(&subgraph)) {
+      if (GenerateCode(&subgraph, place)) {
         InsertFusionGroupOp(graph, &subgraph);
         num_subgraphs++;
       }
@@ -81,15 +121,27 @@ int FusionGroupPass::DetectFusionGroup(Graph* graph, int type) const {
   return num_subgraphs;
 }
 
-bool FusionGroupPass::GenerateCode(fusion_group::SubGraph* subgraph) const {
-  fusion_group::CodeGenerator code_generator;
+bool FusionGroupPass::GenerateCode(fusion_group::SubGraph* subgraph,
+                                   const platform::Place& place) const {
+  bool is_cpu = platform::is_cpu_place(place);
+  fusion_group::CodeGenerator code_generator(is_cpu);
   std::string code_str = code_generator.Generate(subgraph);
   VLOG(4) << code_str;
 
-  // TODO(liuyiqun): supported different places
-  platform::CUDAPlace place = platform::CUDAPlace(0);
-  std::unique_ptr<platform::CUDADeviceCode> device_code(
-      new platform::CUDADeviceCode(place, subgraph->GetFuncName(), code_str));
+  std::unique_ptr<platform::DeviceCode> device_code;
+  if (is_cpu) {
+    device_code.reset(
+        new platform::CPUDeviceCode(place, subgraph->GetFuncName(), code_str));
+  } else {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    device_code.reset(
+        new platform::CUDADeviceCode(place, subgraph->GetFuncName(), code_str));
+#else
+    PADDLE_THROW(platform::errors::PreconditionNotMet(
+        "fusion_group for GPU is not supported, please re-compile with "
+        "WITH_GPU=ON or WITH_ROCM=ON."));
+#endif
+  }
   bool is_compiled = device_code->Compile();
   if (is_compiled) {
     platform::DeviceCodePool& pool = platform::DeviceCodePool::Init({place});
@@ -19,6 +19,7 @@ limitations under the License. */
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -311,6 +312,8 @@ class Graph {
     }
     nodes_.clear();
     node_set_.clear();
+    op_node_types_.clear();
+    op_type_index_.clear();
     return ret;
   }
 
@@ -328,6 +331,7 @@ class Graph {
     ret.reset(nodes_.at(node).release());
     nodes_.erase(node);
     node_set_.erase(node);
+    UnindexOpNode(node);
     return ret;
   }
 
@@ -372,9 +376,44 @@ class Graph {
                           "The node to be added already exists."));
     nodes_[node].reset(node);
     node_set_.insert(node);
+    IndexOpNode(node);
     return node;
   }
 
+  // Returns the op nodes of the given type, nullptr if there is none. The
+  // index is kept up to date by AddNode and RemoveNode, an OpDesc whose type
+  // is changed in place is only seen after RefreshOpTypeIndex.
+  const std::unordered_set<ir::Node *> *OpNodesOfType(
+      const std::string &op_type) const {
+    if (FLAGS_convert_all_blocks) {
+      if (IsMainGraph()) {
+        return GetSubGraph(0)->OpNodesOfType(op_type);
+      }
+    }
+    auto it = op_type_index_.find(op_type);
+    return it == op_type_index_.end() ? nullptr : &it->second;
+  }
+
+  // Moves the op nodes whose type was changed in place, e.g. by
+  // OpDesc::SetType, to their new type. Linear in the number of op nodes.
+  void RefreshOpTypeIndex() const {
+    if (FLAGS_convert_all_blocks) {
+      if (IsMainGraph()) {
+        GetSubGraph(0)->RefreshOpTypeIndex();
+        return;
+      }
+    }
+    for (auto &item : op_node_types_) {
+      const std::string &cur_type = item.first->Op()->Type();
+      if (cur_type == item.second) continue;
+      auto it = op_type_index_.find(item.second);
+      it->second.erase(item.first);
+      if (it->second.empty()) op_type_index_.erase(it);
+      op_type_index_[cur_type].insert(item.first);
+      item.second = cur_type;
+    }
+  }
+
   void ResolveHazard(
       const std::map<std::string, std::vector<ir::Node *>> &var_nodes);
 
@@ -448,6 +487,22 @@ class Graph {
 
   std::unique_ptr<Graph> CloneSubGraph(const size_t idx);
 
+  void IndexOpNode(ir::Node *node) const {
+    if (!node->IsOp() || node->Op() == nullptr) return;
+    const std::string &op_type = node->Op()->Type();
+    op_node_types_[node] = op_type;
+    op_type_index_[op_type].insert(node);
+  }
+
+  void UnindexOpNode(ir::Node *node) const {
+    auto it = op_node_types_.find(node);
+    if (it == op_node_types_.end()) return;
+    auto index_it = op_type_index_.find(it->second);
+    index_it->second.erase(node);
+    if (index_it->second.empty()) op_type_index_.erase(index_it);
+    op_node_types_.erase(it);
+  }
+
   // NOTE: program_ shouldn't be exposed to user.
   const ProgramDesc program_;
   // NOTE: main_graph_ doesn't hold any node. It's used as a container of
@@ -459,6 +514,11 @@ class Graph {
   std::map<std::string, std::function<void(void)>> attr_dels_;
   std::map<ir::Node *, std::unique_ptr<ir::Node>> nodes_;
   std::unordered_set<ir::Node *> node_set_;
+  // op node -> the type it is indexed under, and the reverse index. Mutable
+  // since the index is refreshed by readers holding a const Graph.
+  mutable std::unordered_map<ir::Node *, std::string> op_node_types_;
+  mutable std::unordered_map<std::string, std::unordered_set<ir::Node *>>
+      op_type_index_;
   size_t num_node_created_{0};  // help to generate a unique node id.
   // NOTE(Aurelius84): Whether is constructed with partial ProgramDesc.
   // In case of @to_static, whole trainning program is splited into two
@@ -111,12 +111,44 @@ bool GraphPatternDetector::MarkPDNodesInGraph(const ir::Graph &graph) {
   VLOG(3) << "mark pdnodes in graph";
   if (graph.Nodes().empty()) return false;
 
-  for (auto &node : GraphTraits::DFS(graph)) {
-    if (node.Name().rfind("__control_var") == 0) continue;
-    for (const auto &pdnode : pattern_.nodes()) {
-      if (pdnode->Tell(&node)) {
-        VLOG(4) << "Node " << node.Name() << " marked as " << pdnode->name();
-        pdnodes2nodes_[pdnode.get()].insert(&node);
+  auto try_mark = [&](const PDNode *pdnode, Node *node) {
+    if (node->Name().rfind("__control_var") == 0) return;
+    if (pdnode->Tell(node)) {
+      VLOG(4) << "Node " << node->Name() << " marked as " << pdnode->name();
+      pdnodes2nodes_[pdnode].insert(node);
+    }
+  };
+
+  // PDNodes pinned to some op types only look at the op nodes of these types
+  // and their neighbours, the others still need a walk over the whole graph.
+  graph.RefreshOpTypeIndex();
+  std::vector<const PDNode *> unhinted;
+  for (const auto &pdnode : pattern_.nodes()) {
+    auto hint = pdnode->op_type_hint();
+    if (hint == PDNode::OpTypeHint::kNone) {
+      unhinted.push_back(pdnode.get());
+      continue;
+    }
+    for (const auto &op_type : pdnode->op_type_hint_types()) {
+      auto *op_nodes = graph.OpNodesOfType(op_type);
+      if (op_nodes == nullptr) continue;
+      for (auto *op : *op_nodes) {
+        if (hint == PDNode::OpTypeHint::kOp) {
+          try_mark(pdnode.get(), op);
+        } else {
+          auto &vars = hint == PDNode::OpTypeHint::kOpInput ? op->inputs
+                                                            : op->outputs;
+          for (auto *var : vars) {
+            try_mark(pdnode.get(), var);
+          }
+        }
+      }
+    }
+  }
+  if (!unhinted.empty()) {
+    for (auto &node : GraphTraits::DFS(graph)) {
+      for (auto *pdnode : unhinted) {
+        try_mark(pdnode, &node);
       }
     }
   }
@@ -201,6 +233,13 @@ bool IsNodesLink(Node *a, Node *b) {
   return false;
 }
 
+const std::set<Node *, NodeIdCompare> &GraphPatternDetector::CandidatesOf(
+    const PDNode *pdnode) const {
+  static const std::set<Node *, NodeIdCompare> empty;
+  auto it = pdnodes2nodes_.find(pdnode);
+  return it == pdnodes2nodes_.end() ? empty : it->second;
+}
+
 std::vector<GraphPatternDetector::subgraph_t>
 GraphPatternDetector::DetectPatterns() {
   // Init empty subgraphs.
@@ -230,26 +269,81 @@ GraphPatternDetector::DetectPatterns() {
     auto &cur_groups = bi_records[1 - (step++ % 2)];
     cur_groups.clear();
     if (pre_groups.empty()) break;
-    // source -> target
-    for (Node *source : pdnodes2nodes_[edge.first]) {
-      for (Node *target : pdnodes2nodes_[edge.second]) {
-        VLOG(8) << "check " << source->id() << " -- " << target->id();
-        // TODO(Superjomn) add some prune strategies.
-        for (const auto &group : pre_groups) {
-          if (IsNodesLink(source, target)) {
-            HitGroup new_group = group;
-            bool flag = new_group.Match(source, edge.first) &&
-                        new_group.Match(target, edge.second);
-            if (flag) {
-              new_group.Register(source, edge.first);
-              new_group.Register(target, edge.second);
-              cur_groups.push_back(new_group);
-              // TODO(Superjomn) need to unique
-            }
+    const auto &sources = CandidatesOf(edge.first);
+    const auto &targets = CandidatesOf(edge.second);
+    // Every group only tries the (source, target) pairs that are linked and
+    // agree with the roles it already has, starting from the bound end or
+    // else from the smaller candidate set. The hits are then put in the order
+    // of the full source x target x group scan, which later steps rely on.
+    std::vector<std::pair<std::array<size_t, 3>, HitGroup>> hits;
+    auto try_hit = [&](size_t group_id, Node *source, Node *target) {
+      HitGroup new_group = pre_groups[group_id];
+      if (new_group.Match(source, edge.first) &&
+          new_group.Match(target, edge.second)) {
+        new_group.Register(source, edge.first);
+        new_group.Register(target, edge.second);
+        std::array<size_t, 3> order{static_cast<size_t>(source->id()),
+                                    static_cast<size_t>(target->id()),
+                                    group_id};
+        hits.emplace_back(order, std::move(new_group));
+      }
+    };
+    auto linked_targets = [&](Node *source) {
+      std::set<Node *, NodeIdCompare> res;
+      for (auto *target : source->outputs) {
+        if (targets.count(target)) res.insert(target);
+      }
+      return res;
+    };
+    auto linked_sources = [&](Node *target) {
+      std::set<Node *, NodeIdCompare> res;
+      for (auto *source : target->inputs) {
+        if (sources.count(source) && IsNodesLink(source, target)) {
+          res.insert(source);
+        }
+      }
+      return res;
+    };
+    for (size_t group_id = 0; group_id < pre_groups.size(); ++group_id) {
+      const auto &roles = pre_groups[group_id].roles;
+      auto source_it = roles.find(edge.first);
+      auto target_it = roles.find(edge.second);
+      if (source_it != roles.end()) {
+        Node *source = source_it->second;
+        if (!sources.count(source)) continue;
+        for (auto *target : linked_targets(source)) {
+          try_hit(group_id, source, target);
+        }
+      } else if (target_it != roles.end()) {
+        Node *target = target_it->second;
+        if (!targets.count(target)) continue;
+        for (auto *source : linked_sources(target)) {
+          try_hit(group_id, source, target);
+        }
+      } else if (sources.size() <= targets.size()) {
+        for (auto *source : sources) {
+          for (auto *target : linked_targets(source)) {
+            try_hit(group_id, source, target);
+          }
+        }
+      } else {
+        for (auto *target : targets) {
+          for (auto *source : linked_sources(target)) {
+            try_hit(group_id, source, target);
           }
         }
       }
     }
+    std::sort(hits.begin(),
+              hits.end(),
+              [](const std::pair<std::array<size_t, 3>, HitGroup> &a,
+                 const std::pair<std::array<size_t, 3>, HitGroup> &b) {
+                return a.first < b.first;
+              });
+    cur_groups.reserve(hits.size());
+    for (auto &hit : hits) {
+      cur_groups.push_back(std::move(hit.second));
+    }
     VLOG(3) << "step " << step << " get records: " << cur_groups.size();
     for (auto &group : cur_groups) {
       for (auto &item : group.roles) {
@@ -415,6 +509,7 @@ PDNode *PDNode::assert_is_op() {
 }
 
 PDNode *PDNode::assert_is_op(const std::string &op_type) {
+  SetOpTypeHint(OpTypeHint::kOp, {op_type});
   asserts_.emplace_back([op_type](Node *x) {
     return x && x->IsOp() && x->Op()->Type() == op_type;
   });
@@ -478,6 +573,7 @@ PDNode *PDNode::assert_is_op_nth_output(const std::string &op_type,
                                         const std::string &argument,
                                         int nth) {
   assert_is_var();
+  SetOpTypeHint(OpTypeHint::kOpOutput, {op_type});
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->inputs) {
       if (op->IsOp() && op->Op()->Type() == op_type &&
@@ -491,6 +587,7 @@ PDNode *PDNode::assert_is_op_nth_output(const std::string &op_type,
 
 PDNode *PDNode::assert_is_only_input_of_op(const std::string &op_type) {
   assert_is_var();
+  SetOpTypeHint(OpTypeHint::kOpInput, {op_type});
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->outputs) {
       if (op && op->IsOp() && op->Op() && op->Op()->Type() == op_type &&
@@ -505,6 +602,7 @@ PDNode *PDNode::assert_is_only_input_of_op(const std::string &op_type) {
 
 PDNode *PDNode::assert_is_only_output_of_op(const std::string &op_type) {
   assert_is_var();
+  SetOpTypeHint(OpTypeHint::kOpOutput, {op_type});
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->inputs) {
       if (op && op->IsOp() && op->Op() && op->Op()->Type() == op_type &&
@@ -519,6 +617,7 @@ PDNode *PDNode::assert_is_only_output_of_op(const std::string &op_type) {
 
 PDNode *PDNode::assert_is_op_output(const std::string &op_type) {
   assert_is_var();
+  SetOpTypeHint(OpTypeHint::kOpOutput, {op_type});
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->inputs) {
       if (op && op->IsOp() && op->Op() && op->Op()->Type() == op_type) {
@@ -539,6 +638,7 @@ PDNode *PDNode::assert_is_op_output(const std::string &op_type,
 
 PDNode *PDNode::assert_is_op_input(const std::string &op_type) {
   assert_is_var();
+  SetOpTypeHint(OpTypeHint::kOpInput, {op_type});
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->outputs) {
       if (op && op->IsOp() && op->Op() && op->Op()->Type() == op_type) {
@@ -595,6 +695,7 @@ PDNode *PDNode::assert_more(PDNode::teller_t &&teller) {
 }
 
 PDNode *PDNode::assert_is_ops(const std::unordered_set<std::string> &op_types) {
+  SetOpTypeHint(OpTypeHint::kOp, op_types);
   asserts_.emplace_back([op_types](Node *x) {
     return x && x->IsOp() && op_types.count(x->Op()->Type());
   });
@@ -623,6 +724,7 @@ PDNode *PDNode::assert_is_ops_nth_output(
     const std::string &argument,
     int nth) {
   assert_is_var();
+  SetOpTypeHint(OpTypeHint::kOpOutput, op_types);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->inputs) {
       if (op->IsOp() && op_types.count(op->Op()->Type()) &&
@@ -636,6 +738,7 @@ PDNode *PDNode::assert_is_ops_nth_output(
 PDNode *PDNode::assert_is_ops_output(
     const std::unordered_set<std::string> &op_types) {
   assert_is_var();
+  SetOpTypeHint(OpTypeHint::kOpOutput, op_types);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->inputs) {
       if (op && op->IsOp() && op->Op() && op_types.count(op->Op()->Type())) {
@@ -658,6 +761,7 @@ PDNode *PDNode::assert_is_ops_output(
 PDNode *PDNode::assert_is_ops_input(
     const std::unordered_set<std::string> &op_types) {
   assert_is_var();
+  SetOpTypeHint(OpTypeHint::kOpInput, op_types);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->outputs) {
       if (op && op->IsOp() && op->Op() && op_types.count(op->Op()->Type())) {
@@ -680,6 +784,7 @@ PDNode *PDNode::assert_is_ops_input(
 PDNode *PDNode::assert_is_only_input_of_ops(
     const std::unordered_set<std::string> &op_types) {
   assert_is_var();
+  SetOpTypeHint(OpTypeHint::kOpInput, op_types);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->outputs) {
       if (op && op->IsOp() && op->Op() && op_types.count(op->Op()->Type()) &&
@@ -695,6 +800,7 @@ PDNode *PDNode::assert_is_only_input_of_ops(
 PDNode *PDNode::assert_is_only_output_of_ops(
     const std::unordered_set<std::string> &op_types) {
   assert_is_var();
+  SetOpTypeHint(OpTypeHint::kOpOutput, op_types);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->inputs) {
       if (op && op->IsOp() && op->Op() && op_types.count(op->Op()->Type()) &&
@@ -80,6 +80,17 @@ struct PDNode {
   bool IsOp() const { return type_ == Type::kOp; }
   bool IsVar() const { return type_ == Type::kVar; }
 
+  // The op types an assert has pinned this node to, so that the detector only
+  // visits those op nodes (kOp) or their input or output vars instead of the
+  // whole graph. kNone when the node is decided by a custom teller.
+  enum class OpTypeHint { kNone, kOp, kOpInput, kOpOutput };
+  OpTypeHint op_type_hint() const {
+    return teller_ ? OpTypeHint::kNone : op_type_hint_;
+  }
+  const std::unordered_set<std::string>& op_type_hint_types() const {
+    return op_type_hint_types_;
+  }
+
   const std::string& name() const { return name_; }
   const PDPattern* pdpattern() const { return pattern_; }
 
@@ -188,6 +199,14 @@ struct PDNode {
 
   PDNode(PDNode&& other) = default;
 
+  // All the asserts must hold, so the first hint is as good as any other.
+  void SetOpTypeHint(OpTypeHint hint,
+                     const std::unordered_set<std::string>& op_types) {
+    if (op_type_hint_ != OpTypeHint::kNone) return;
+    op_type_hint_ = hint;
+    op_type_hint_types_ = op_types;
+  }
+
   friend class PDPattern;
 
   // Will removed latter.
@@ -197,6 +216,8 @@ struct PDNode {
   std::string name_;
   Type type_;
   Role role_{Role::kUnknown};
+  OpTypeHint op_type_hint_{OpTypeHint::kNone};
+  std::unordered_set<std::string> op_type_hint_types_;
 };
 
 /*
@@ -341,6 +362,10 @@ class GraphPatternDetector {
   // Detect all the pattern and output the hit records.
   std::vector<subgraph_t> DetectPatterns();
 
+  // The nodes marked as pdnode, empty if there is none.
+  const std::set<Node*, NodeIdCompare>& CandidatesOf(
+      const PDNode* pdnode) const;
+
   // Remove duplicate patterns.
   void UniquePatterns(std::vector<subgraph_t>* subgraphs);
 
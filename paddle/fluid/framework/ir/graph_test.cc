@@ -176,6 +176,34 @@ TEST(GraphTest, TestException) {
   ASSERT_TRUE(not_met_exception);
 }
 
+TEST(GraphTest, TestOpTypeIndex) {
+  ProgramDesc prog;
+  for (auto type : {"sum", "sum", "mul"}) {
+    auto *op = prog.MutableBlock(0)->AppendOp();
+    op->SetType(type);
+  }
+  ir::Graph g(prog);
+  ASSERT_EQ(g.OpNodesOfType("sum")->size(), 2UL);
+  ASSERT_EQ(g.OpNodesOfType("mul")->size(), 1UL);
+  ASSERT_EQ(g.OpNodesOfType("relu"), nullptr);
+
+  ir::Node *mul = *g.OpNodesOfType("mul")->begin();
+  g.RemoveNode(mul);
+  ASSERT_EQ(g.OpNodesOfType("mul"), nullptr);
+
+  OpDesc relu_desc;
+  relu_desc.SetType("relu");
+  g.CreateOpNode(&relu_desc);
+  ASSERT_EQ(g.OpNodesOfType("relu")->size(), 1UL);
+
+  // A type changed in place is picked up by RefreshOpTypeIndex.
+  ir::Node *sum = *g.OpNodesOfType("sum")->begin();
+  sum->Op()->SetType("relu");
+  g.RefreshOpTypeIndex();
+  ASSERT_EQ(g.OpNodesOfType("sum")->size(), 1UL);
+  ASSERT_EQ(g.OpNodesOfType("relu")->size(), 2UL);
+}
+
 TEST(GraphTest, TestAttrCopy) {
   ProgramDesc prog;
   ir::Graph src_g(prog);
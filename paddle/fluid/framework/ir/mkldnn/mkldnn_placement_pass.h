@@ -35,6 +35,13 @@ class MKLDNNPlacementPass : public PlacementPassBase {
   const std::unordered_set<std::string> GetOpTypesList() const override {
     return Get<std::unordered_set<std::string>>("mkldnn_enabled_op_types");
   }
+
+  const std::unordered_set<std::string> GetExcludedOpTypes() const override {
+    if (!Has("mkldnn_excluded_op_types")) {
+      return {};
+    }
+    return Get<std::unordered_set<std::string>>("mkldnn_excluded_op_types");
+  }
 };
 
 }  // namespace ir
@@ -319,6 +319,7 @@ bool OpCompatSensiblePass::IsCompat(
       continue;
     }
     auto& judger = *op_compat_judgers_.at(op_type);
+    std::lock_guard<std::mutex> lock(judge_mutex_);
     if (!judger.Judge(*(node_pair.second->Op()), Type())) {
       return false;
     }
@@ -15,6 +15,7 @@ limitations under the License. */
 #pragma once
 
 #include <map>
+#include <mutex>  // NOLINT
 #include <vector>
 
 #include "paddle/fluid/framework/ir/graph.h"
@@ -207,11 +208,15 @@ class OpCompatSensiblePass : public Pass {
   //! Tell the op compatibility of a single Op.
   bool IsCompat(const OpDesc& op_desc) const {
     if (!op_compat_judgers_.count(op_desc.Type())) return false;
+    std::lock_guard<std::mutex> lock(judge_mutex_);
     return op_compat_judgers_.at(op_desc.Type())->Judge(op_desc, Type());
   }
 
  private:
   std::map<std::string, std::unique_ptr<OpCompat>> op_compat_judgers_;
+  // OpCompat::Judge fills its attr checks on the first call, a pass applied
+  // to several sub graphs at the same time may judge from many threads.
+  mutable std::mutex judge_mutex_;
 };
 
 template <typename T>
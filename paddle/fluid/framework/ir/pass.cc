@@ -15,6 +15,10 @@ limitations under the License. */
 #include "paddle/fluid/framework/ir/pass.h"
 
 #include <algorithm>
+#include <future>  // NOLINT
+#include <thread>  // NOLINT
+
+#include "ThreadPool.h"
 
 #include "paddle/fluid/framework/ir/graph_helper.h"
 #include "paddle/fluid/framework/op_proto_maker.h"
@@ -83,17 +87,8 @@ Graph *Pass::Apply(Graph *graph) const {
   }
   graph->Get<PassRecorder>(kPassRecorder).insert(Type());
 
-  if (graph->IsMainGraph() && std::count(support_subgraph_passes.begin(),
-                                         support_subgraph_passes.end(),
-                                         Type())) {
-    for (size_t i = 1; i < graph->SubGraphsSize(); i++) {
-      auto *sub_graph = graph->GetSubGraph(i);
-      if (!sub_graph->Has(framework::ir::kParamScopeAttr)) {
-        sub_graph->SetNotOwned<Scope>(
-            framework::ir::kParamScopeAttr,
-            &graph->Get<Scope>(framework::ir::kParamScopeAttr));
-      }
-
+  if (ApplyToSubGraphs() && graph->IsMainGraph()) {
+    auto apply_to_sub_graph = [this](Graph *sub_graph) {
       ApplyImpl(sub_graph);
       PADDLE_ENFORCE_EQ(
           HasCircle(*sub_graph),
@@ -106,6 +101,40 @@ Graph *Pass::Apply(Graph *graph) const {
           true,
           platform::errors::InvalidArgument(
               "The VarDescs of persistable variable are not consistency."));
+    };
+    std::vector<Graph *> sub_graphs;
+    for (size_t i = 1; i < graph->SubGraphsSize(); i++) {
+      auto *sub_graph = graph->GetSubGraph(i);
+      if (!sub_graph->Has(framework::ir::kParamScopeAttr)) {
+        sub_graph->SetNotOwned<Scope>(
+            framework::ir::kParamScopeAttr,
+            &graph->Get<Scope>(framework::ir::kParamScopeAttr));
+      }
+      sub_graphs.push_back(sub_graph);
+    }
+
+    // The sub graphs share no nodes, so a pass without own state can rewrite
+    // them at the same time.
+    size_t num_threads = std::min<size_t>(
+        sub_graphs.size(), std::thread::hardware_concurrency());
+    if (SupportConcurrentSubGraphs() && num_threads > 1) {
+      VLOG(3) << "apply pass " << Type() << " to " << sub_graphs.size()
+              << " sub graphs with " << num_threads << " threads";
+      ::ThreadPool pool(num_threads);
+      std::vector<std::future<void>> futures;
+      for (auto *sub_graph : sub_graphs) {
+        futures.emplace_back(pool.enqueue(apply_to_sub_graph, sub_graph));
+      }
+      for (auto &f : futures) {
+        f.get();
+      }
+    } else {
+      for (auto *sub_graph : sub_graphs) {
+        apply_to_sub_graph(sub_graph);
+      }
+    }
+
+    for (auto *sub_graph : sub_graphs) {
       if (!sub_graph->Has(kPassRecorder)) {
         sub_graph->Set<PassRecorder>(kPassRecorder, new PassRecorder);
       }
@@ -122,6 +151,30 @@ Graph *Pass::Apply(Graph *graph) const {
   return graph;
 }
 
+bool Pass::ApplyToSubGraphs() const {
+  return std::count(support_subgraph_passes.begin(),
+                    support_subgraph_passes.end(),
+                    Type()) > 0;
+}
+
+bool Pass::HasAnchorOps(const Graph &graph) const {
+  if (anchor_op_types_.empty()) return true;
+  auto has_anchor = [this](const Graph &g) {
+    g.RefreshOpTypeIndex();
+    for (auto &op_type : anchor_op_types_) {
+      if (g.OpNodesOfType(op_type) != nullptr) return true;
+    }
+    return false;
+  };
+  if (has_anchor(graph)) return true;
+  if (graph.IsMainGraph() && ApplyToSubGraphs()) {
+    for (size_t i = 1; i < graph.SubGraphsSize(); i++) {
+      if (has_anchor(*graph.GetSubGraph(i))) return true;
+    }
+  }
+  return false;
+}
+
 static void FillNotSpecifiedOpRole(const ProgramDesc &main_program) {
   for (size_t block_idx = 0; block_idx < main_program.Size(); ++block_idx) {
     auto ops = main_program.Block(block_idx).AllOps();
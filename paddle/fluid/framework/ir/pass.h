@@ -168,6 +168,16 @@ class Pass {
 
   virtual bool SupportApplyProgramViaGraph() const { return true; }
 
+  // The op types the pass starts its matching from, it can only change a
+  // graph holding one of them. Empty if the pass doesn't declare any.
+  const std::unordered_set<std::string> &AnchorOpTypes() const {
+    return anchor_op_types_;
+  }
+
+  // False only if the pass declares anchor op types and none of them is in
+  // the graph, or in the sub graphs the pass is applied to.
+  bool HasAnchorOps(const Graph &graph) const;
+
  protected:
   virtual void ApplyImpl(Graph *graph) const {
     PADDLE_THROW(platform::errors::Unimplemented(
@@ -185,6 +195,11 @@ class Pass {
   // Pass must be placed after this Pass.
   virtual void CheckPrevPass() const {}
 
+  // Whether ApplyImpl may run on the sub graphs of a main graph at the same
+  // time. A pass that keeps state in its members or shares anything but the
+  // param scope between graphs must not return true.
+  virtual bool SupportConcurrentSubGraphs() const { return false; }
+
  private:
   template <typename PassType>
   friend struct PassRegistrar;
@@ -209,11 +224,18 @@ class Pass {
 
   void RegisterType(const std::string &type) { type_ = type; }
 
+  void RegisterAnchorOpTypes(const std::unordered_set<std::string> &op_types) {
+    anchor_op_types_.insert(op_types.begin(), op_types.end());
+  }
+
+  bool ApplyToSubGraphs() const;
+
   mutable bool applied_{false};
   std::string type_;
   std::unordered_set<std::string> required_pass_attrs_;
   std::unordered_set<std::string> default_pass_attrs_;
   std::unordered_set<std::string> required_graph_attrs_;
+  std::unordered_set<std::string> anchor_op_types_;
   std::map<std::string, paddle::any> attrs_;
   std::map<std::string, std::function<void(void)>> attr_dels_;
 };
@@ -290,6 +312,7 @@ struct PassRegistrar : public Registrar {
           pass->RegisterRequiredGraphAttrs(this->required_graph_attrs_);
           pass->RegisterDefaultPassAttrs(this->default_attr_values_);
           pass->RegisterType(pass_type);
+          pass->RegisterAnchorOpTypes(this->anchor_op_types_);
           return pass;
         });
   }
@@ -325,9 +348,18 @@ struct PassRegistrar : public Registrar {
     return *this;
   }
 
+  // The pass can not match anything in a graph without any of these op
+  // types, the pass managers skip it on such graphs.
+  PassRegistrar<PassType> &AnchorOpTypes(
+      const std::unordered_set<std::string> &op_types) {
+    anchor_op_types_.insert(op_types.begin(), op_types.end());
+    return *this;
+  }
+
  private:
   std::unordered_set<std::string> required_pass_attrs_;
   std::unordered_set<std::string> required_graph_attrs_;
+  std::unordered_set<std::string> anchor_op_types_;
   std::map<std::string, paddle::any> default_attr_values_;
   std::map<std::string, std::function<void(void)>> default_attr_dels_;
 };
@@ -271,6 +271,26 @@ TEST(PassTest, TestPassDefaultAttrCheckConvertAllBlocks) {
   FLAGS_convert_all_blocks = flag_temp;
 }
 
+TEST(PassTest, TestPassAnchorOpTypes) {
+  auto pass = PassRegistry::Instance().Get("test_pass_anchor_op");
+  ASSERT_EQ(pass->AnchorOpTypes().size(), 1UL);
+
+  ProgramDesc prog;
+  prog.MutableBlock(0)->AppendOp()->SetType("relu");
+  Graph graph(prog);
+  ASSERT_FALSE(pass->HasAnchorOps(graph));
+
+  OpDesc desc;
+  desc.SetType("batch_norm");
+  graph.CreateOpNode(&desc);
+  ASSERT_TRUE(pass->HasAnchorOps(graph));
+
+  // passes without anchors are always applied
+  ASSERT_TRUE(
+      PassRegistry::Instance().Get("test_pass_default_attr")->HasAnchorOps(
+          Graph(prog)));
+}
+
 TEST(PassTest, TestPassRegistrarDeconstructor) {
   auto pass_registrary =
       new PassRegistrar<paddle::framework::ir::TestPassWithDefault>(
@@ -290,3 +310,6 @@ REGISTER_PASS(test_pass, paddle::framework::ir::TestPass)
 REGISTER_PASS(test_pass_default_attr,
               paddle::framework::ir::TestPassWithDefault)
     .DefaultPassAttr("default_attr", new int{1});
+
+REGISTER_PASS(test_pass_anchor_op, paddle::framework::ir::TestPassWithDefault)
+    .AnchorOpTypes({"batch_norm"});
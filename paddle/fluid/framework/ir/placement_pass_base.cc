@@ -26,6 +26,7 @@ void PlacementPassBase::ApplyImpl(ir::Graph* graph) const {
   VLOG(3) << "Applies " << GetPlacementName() << " placement strategy.";
   std::string attr_name = GetAttrName();
   const auto& op_types_list = GetOpTypesList();
+  const auto& excluded_op_types = GetExcludedOpTypes();
   if (!graph->Has(attr_name)) {
     graph->Set<bool>(attr_name, new bool(true));
   }
@@ -33,7 +34,7 @@ void PlacementPassBase::ApplyImpl(ir::Graph* graph) const {
     if (n->IsOp()) {
       auto* op = n->Op();
       if ((op->HasAttr(attr_name) || op->HasProtoAttr(attr_name)) &&
-          IsSupport(op->Type())) {
+          IsSupport(op->Type()) && !excluded_op_types.count(op->Type())) {
         if (op_types_list.empty() && IsDefaultOpTypes(op->Type())) {
           op->SetAttr(attr_name, true);
         } else if (std::find(op_types_list.begin(),
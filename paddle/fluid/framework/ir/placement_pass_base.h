@@ -35,6 +35,10 @@ class PlacementPassBase : public Pass {
   virtual const std::string GetPlacementName() const = 0;
   virtual const std::string GetAttrName() const = 0;
   virtual const std::unordered_set<std::string> GetOpTypesList() const = 0;
+  // op types left unplaced even when they are in GetOpTypesList
+  virtual const std::unordered_set<std::string> GetExcludedOpTypes() const {
+    return {};
+  }
 
  private:
   bool IsSupport(const std::string& op_type) const;
@@ -449,7 +449,8 @@ void RepeatedFCReluFusePass::ApplyImpl(ir::Graph* graph) const {
 }  // namespace paddle
 
 REGISTER_PASS(repeated_fc_relu_fuse_pass,
-              paddle::framework::ir::RepeatedFCReluFusePass);
+              paddle::framework::ir::RepeatedFCReluFusePass)
+    .AnchorOpTypes({"fc"});
 REGISTER_PASS_CAPABILITY(repeated_fc_relu_fuse_pass)
     .AddCombination(
         paddle::framework::compatible::OpVersionComparatorCombination()
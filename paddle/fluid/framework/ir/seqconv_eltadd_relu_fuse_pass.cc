@@ -154,7 +154,8 @@ void SeqConvEltAddReluFusePass::ApplyImpl(ir::Graph* graph) const {
 }  // namespace paddle
 
 REGISTER_PASS(seqconv_eltadd_relu_fuse_pass,
-              paddle::framework::ir::SeqConvEltAddReluFusePass);
+              paddle::framework::ir::SeqConvEltAddReluFusePass)
+    .AnchorOpTypes({"sequence_conv"});
 REGISTER_PASS_CAPABILITY(seqconv_eltadd_relu_fuse_pass)
     .AddCombination(
         paddle::framework::compatible::OpVersionComparatorCombination()
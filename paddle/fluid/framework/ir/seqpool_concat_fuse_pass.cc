@@ -222,4 +222,5 @@ void SeqPoolConcatFusePass::ApplyImpl(ir::Graph* graph) const {
 }  // namespace paddle
 
 REGISTER_PASS(seqpool_concat_fuse_pass,
-              paddle::framework::ir::SeqPoolConcatFusePass);
+              paddle::framework::ir::SeqPoolConcatFusePass)
+    .AnchorOpTypes({"sequence_pool"});
@@ -33,6 +33,9 @@ class SimplifyWithBasicOpsPass : public OpCompatSensiblePass {
  protected:
   void ApplyImpl(Graph* graph) const override;
 
+  // Only rewrites the nodes of the graph it is given.
+  bool SupportConcurrentSubGraphs() const override { return true; }
+
  private:
   bool SimplifyDropout(Graph* graph,
                        Node* n,
@@ -30,6 +30,15 @@
 PADDLE_DEFINE_EXPORTED_bool(enable_opt_infer_gc_var,
                             false,
                             "enable opt infer gc var");
+PADDLE_DEFINE_EXPORTED_bool(
+    naive_executor_bind_var_slots,
+    false,
+    "Intern the variables of the ops into slots of the scope on the first "
+    "run and bind every op to them, so that the later runs look up no "
+    "variable name. Like kEnableCacheRuntimeContext, binding turns on the "
+    "runtime context cache of the op, which also caches the kernel context "
+    "of an op that needed no data transform and skips PrepareData on the "
+    "later runs, so the inputs must keep their place, layout and dtype.");
 
 namespace paddle {
 namespace framework {
@@ -54,6 +63,14 @@ void NaiveExecutor::Prepare(Scope *scope,
     gc_ = gc.release();
   }
 
+  // the ops bound to the former scope look the names up again, and all the
+  // ops are bound to the slots of the new scope on the next run
+  for (auto &slots : op_var_slots_) {
+    slots.op->BindRuntimeContext(nullptr, nullptr);
+  }
+  op_var_slots_.clear();
+  vars_bound_ = false;
+
   CreateOps(program_desc, block_id, with_feed_fetch_ops);
   VLOG(3) << "NaiveExecutor init with scope " << scope;
 }
@@ -64,6 +81,13 @@ void NaiveExecutor::Run() {
   platform::RegisterModelLayout(ops_, place_);
 #endif
   platform::ScopedFlushDenormal flush;
+  if (FLAGS_naive_executor_bind_var_slots) {
+    if (!vars_bound_) {
+      BindOpsToVarSlots();
+    } else if (scope_->VarSlotsVersion() != bound_slots_version_) {
+      BindRuntimeContexts();
+    }
+  }
   for (auto &op : ops_) {
     VLOG(4) << std::this_thread::get_id() << " run "
             << op->DebugStringEx(scope_) << " on scope " << scope_;
@@ -150,6 +174,66 @@ void NaiveExecutor::CreateOps(const ProgramDesc &desc,
   unused_vars_ = GetUnusedVars(global_block, ops_, skip_vars_);
 }
 
+void NaiveExecutor::BindOpsToVarSlots() {
+  auto intern = [this](const VariableNameMap &names) {
+    std::vector<std::vector<size_t>> ids;
+    ids.reserve(names.size());
+    for (auto &pair : names) {
+      ids.emplace_back();
+      for (auto &name : pair.second) {
+        ids.back().push_back(scope_->InternVar(name));
+      }
+    }
+    return ids;
+  };
+  op_var_slots_.clear();
+  for (auto &op : ops_) {
+    auto *op_with_kernel = dynamic_cast<const OperatorWithKernel *>(op.get());
+    if (op_with_kernel == nullptr) {
+      continue;
+    }
+    op_var_slots_.push_back(OpVarSlots{
+        op_with_kernel, intern(op->Inputs()), intern(op->Outputs())});
+  }
+  vars_bound_ = true;
+  BindRuntimeContexts();
+}
+
+void NaiveExecutor::BindRuntimeContexts() {
+  bound_slots_version_ = scope_->VarSlotsVersion();
+  size_t bound_num = 0;
+  for (auto &slots : op_var_slots_) {
+    bool complete = true;
+    auto resolve = [&](const VariableNameMap &names,
+                       const std::vector<std::vector<size_t>> &ids) {
+      VariableValueMap vars;
+      size_t i = 0;
+      for (auto &pair : names) {
+        auto &values = vars[pair.first];
+        values.reserve(ids[i].size());
+        for (auto id : ids[i]) {
+          values.push_back(scope_->FindVarById(id));
+          complete = complete && values.back() != nullptr;
+        }
+        ++i;
+      }
+      return vars;
+    };
+    auto inputs = resolve(slots.op->Inputs(), slots.input_ids);
+    auto outputs = resolve(slots.op->Outputs(), slots.output_ids);
+    // an op with a variable created at runtime keeps looking it up
+    if (!complete) {
+      slots.op->BindRuntimeContext(nullptr, scope_);
+      continue;
+    }
+    slots.op->BindRuntimeContext(
+        std::make_unique<RuntimeContext>(inputs, outputs), scope_);
+    ++bound_num;
+  }
+  VLOG(3) << "Bound " << bound_num << " of " << ops_.size()
+          << " ops to the var slots of scope " << scope_;
+}
+
 LoDTensor *NaiveExecutor::FindTensor(const std::string &name) {
   PADDLE_ENFORCE_NOT_NULL(scope_,
                           platform::errors::PreconditionNotMet(
@@ -170,6 +254,8 @@ void NaiveExecutor::CleanFeedFetchOps() {
     }
   }
   ops_.swap(ops);
+  vars_bound_ = false;
+  op_var_slots_.clear();
 }
 void NaiveExecutor::AddSkipVars(const std::vector<std::string> &skip_vars) {
   if (skip_vars.empty()) {
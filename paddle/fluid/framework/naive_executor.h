@@ -81,7 +81,21 @@ class NaiveExecutor {
                  int block_id,
                  bool with_feed_fetch_ops);
 
+  // Interns the variables of the ops into slots of the scope, see
+  // FLAGS_naive_executor_bind_var_slots.
+  void BindOpsToVarSlots();
+
+  // Binds every op to the variables now in its slots.
+  void BindRuntimeContexts();
+
  private:
+  struct OpVarSlots {
+    const OperatorWithKernel* op;
+    // in the order of op->Inputs() and op->Outputs()
+    std::vector<std::vector<size_t>> input_ids;
+    std::vector<std::vector<size_t>> output_ids;
+  };
+
   const platform::Place place_;
   // Catch the required resource to avoid recreate.
   std::vector<std::unique_ptr<OperatorBase>> ops_;
@@ -96,6 +110,10 @@ class NaiveExecutor {
   bool run_by_executor_ = false;
   // gc
   GarbageCollector *gc_ = nullptr;
+  // var slots
+  bool vars_bound_{false};
+  uint64_t bound_slots_version_{0};
+  std::vector<OpVarSlots> op_var_slots_;
 };
 
 }  // namespace framework
@@ -21,6 +21,8 @@
 #include "paddle/fluid/framework/op_registry.h"
 #include "paddle/fluid/framework/program_desc.h"
 
+DECLARE_bool(naive_executor_bind_var_slots);
+
 namespace paddle {
 namespace framework {
 
@@ -67,6 +69,70 @@ TEST(NaiveExecutor, Basic) {
   }
 }
 
+TEST(NaiveExecutor, BindVarSlots) {
+  FLAGS_naive_executor_bind_var_slots = true;
+
+  ProgramDesc program;
+  auto* main_block = program.MutableBlock(0);
+  for (auto name : {"a", "b", "c"}) {
+    main_block->Var(name)->SetType(proto::VarType::LOD_TENSOR);
+  }
+  auto* add = main_block->AppendOp();
+  add->SetType("elementwise_add");
+  add->SetInput("X", {"a"});
+  add->SetInput("Y", {"b"});
+  add->SetOutput("Out", {"c"});
+
+  auto place = platform::CPUPlace();
+  Scope scope;
+  NaiveExecutor exe(place);
+  exe.CreateVariables(program, 0, false, &scope);
+  exe.Prepare(&scope, program, 0, false);
+
+  auto feed = [&](float b_value) {
+    for (auto name : {"a", "b"}) {
+      auto* tensor = exe.FindTensor(name);
+      tensor->Resize({1, 4});
+      auto* data = tensor->mutable_data<float>(place);
+      for (int i = 0; i < 4; i++) {
+        data[i] = name[0] == 'a' ? i : b_value;
+      }
+    }
+  };
+  auto check = [&](float b_value) {
+    auto* c_data = exe.FindTensor("c")->data<float>();
+    for (int i = 0; i < 4; i++) {
+      EXPECT_NEAR(c_data[i], i + b_value, 1e-3);
+    }
+  };
+
+  feed(1);
+  exe.Run();
+  check(1);
+  feed(2);
+  exe.Run();
+  check(2);
+
+  // the ops are bound again to the variable that replaces the erased one
+  scope.EraseVars({"c"});
+  scope.Var("c")->GetMutable<LoDTensor>();
+  feed(3);
+  exe.Run();
+  check(3);
+
+  // a new Prepare binds the ops, the former and the appended ones, to the
+  // slots of the new scope
+  Scope new_scope;
+  exe.CreateVariables(program, 0, false, &new_scope);
+  exe.Prepare(&new_scope, program, 0, false);
+  feed(4);
+  exe.Run();
+  check(4);
+  EXPECT_EQ(scope.FindVar("c")->Get<LoDTensor>().data<float>()[0], 3);
+
+  FLAGS_naive_executor_bind_var_slots = false;
+}
+
 }  // namespace framework
 }  // namespace paddle
 
@@ -14,6 +14,7 @@
 
 #include "paddle/fluid/framework/new_executor/interpreter/dependency_builder.h"
 
+#include <algorithm>
 #include <queue>
 
 // The difference between "sequential_run" and "serial_run":
@@ -557,6 +558,52 @@ void DependencyBuilder::ShrinkDownstreamMap() {
           << StringizeDownstreamMap(op_downstream_map_);
 }
 
+std::vector<double> CriticalPathLengths(
+    const std::map<int, std::set<int>>& downstream_map,
+    const std::vector<double>& op_costs) {
+  size_t op_num = op_costs.size();
+  // Kahn's algorithm, then accumulate the path costs in reverse topological
+  // order
+  std::vector<size_t> in_degree(op_num, 0);
+  for (auto& item : downstream_map) {
+    for (int next : item.second) {
+      ++in_degree.at(next);
+    }
+  }
+  std::vector<int> topo_order;
+  topo_order.reserve(op_num);
+  for (size_t i = 0; i < op_num; ++i) {
+    if (in_degree[i] == 0) topo_order.push_back(i);
+  }
+  for (size_t k = 0; k < topo_order.size(); ++k) {
+    auto it = downstream_map.find(topo_order[k]);
+    if (it == downstream_map.end()) continue;
+    for (int next : it->second) {
+      if (--in_degree[next] == 0) topo_order.push_back(next);
+    }
+  }
+  PADDLE_ENFORCE_EQ(
+      topo_order.size(),
+      op_num,
+      platform::errors::PreconditionNotMet(
+          "The op dependencies contain a cycle, only %d of %d ops are sorted.",
+          topo_order.size(),
+          op_num));
+
+  std::vector<double> lengths(op_num, 0);
+  for (auto rit = topo_order.rbegin(); rit != topo_order.rend(); ++rit) {
+    double longest_next = 0;
+    auto it = downstream_map.find(*rit);
+    if (it != downstream_map.end()) {
+      for (int next : it->second) {
+        longest_next = std::max(longest_next, lengths[next]);
+      }
+    }
+    lengths[*rit] = op_costs[*rit] + longest_next;
+  }
+  return lengths;
+}
+
 }  // namespace interpreter
 }  // namespace framework
 }  // namespace paddle
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <map>
+#include <set>
 #include <vector>
 
 #include "paddle/fluid/framework/new_executor/new_executor_defs.h"
@@ -68,6 +69,14 @@ class DependencyBuilder {
   std::map<int, std::set<int>> op_downstream_map_;
 };
 
+// Returns for every op the cost of the most expensive path from it to the end
+// of the program, itself included, op i costing op_costs[i]. The ops on the
+// critical path have the largest values, which is what the executor uses as
+// their scheduling priority.
+std::vector<double> CriticalPathLengths(
+    const std::map<int, std::set<int>>& downstream_map,
+    const std::vector<double>& op_costs);
+
 }  // namespace interpreter
 }  // namespace framework
 }  // namespace paddle
@@ -0,0 +1,74 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/new_executor/interpreter/dependency_builder.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace paddle {
+namespace framework {
+namespace interpreter {
+
+TEST(CriticalPathLengths, Diamond) {
+  // 0 -> 1 -> 3 and 0 -> 2 -> 3
+  std::map<int, std::set<int>> downstream_map = {
+      {0, {1, 2}}, {1, {3}}, {2, {3}}};
+  std::vector<double> op_costs = {1, 2, 5, 1};
+  std::vector<double> lengths = CriticalPathLengths(downstream_map, op_costs);
+  ASSERT_EQ(lengths.size(), 4UL);
+  EXPECT_DOUBLE_EQ(lengths[3], 1);
+  EXPECT_DOUBLE_EQ(lengths[1], 3);
+  EXPECT_DOUBLE_EQ(lengths[2], 6);
+  // through the more expensive branch 2
+  EXPECT_DOUBLE_EQ(lengths[0], 7);
+}
+
+TEST(CriticalPathLengths, NoDownstream) {
+  // op 1 has an empty downstream set, op 2 is not in the map at all
+  std::map<int, std::set<int>> downstream_map = {{0, {1}}, {1, {}}};
+  std::vector<double> op_costs = {1, 2, 4};
+  std::vector<double> lengths = CriticalPathLengths(downstream_map, op_costs);
+  ASSERT_EQ(lengths.size(), 3UL);
+  EXPECT_DOUBLE_EQ(lengths[0], 3);
+  EXPECT_DOUBLE_EQ(lengths[1], 2);
+  EXPECT_DOUBLE_EQ(lengths[2], 4);
+}
+
+TEST(CriticalPathLengths, WeightedChain) {
+  // 0 -> 1 -> 2 -> 3, and a shortcut 0 -> 3 that is not the longest path
+  std::map<int, std::set<int>> downstream_map = {
+      {0, {1, 3}}, {1, {2}}, {2, {3}}};
+  std::vector<double> op_costs = {0.5, 3, 1.5, 2};
+  std::vector<double> lengths = CriticalPathLengths(downstream_map, op_costs);
+  ASSERT_EQ(lengths.size(), 4UL);
+  EXPECT_DOUBLE_EQ(lengths[3], 2);
+  EXPECT_DOUBLE_EQ(lengths[2], 3.5);
+  EXPECT_DOUBLE_EQ(lengths[1], 6.5);
+  EXPECT_DOUBLE_EQ(lengths[0], 7);
+}
+
+TEST(CriticalPathLengths, Cycle) {
+  std::map<int, std::set<int>> downstream_map = {{0, {1}}, {1, {0}}};
+  std::vector<double> op_costs = {1, 1};
+  EXPECT_THROW(CriticalPathLengths(downstream_map, op_costs),
+               platform::EnforceNotMet);
+}
+
+}  // namespace interpreter
+}  // namespace framework
+}  // namespace paddle
@@ -14,6 +14,10 @@
 
 #include "paddle/fluid/framework/new_executor/interpretercore.h"
 
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstring>
+#include <numeric>
 #include <unordered_set>
 
 #include "paddle/fluid/framework/details/nan_inf_utils.h"
@@ -40,6 +44,20 @@ PADDLE_DEFINE_EXPORTED_bool(new_executor_use_local_scope,
                             "Use local_scope in new executor(especially used "
                             "in UT), can turn off for better performance");
 
+PADDLE_DEFINE_EXPORTED_bool(
+    new_executor_critical_path_stats,
+    false,
+    "Time every instruction and log the critical path of the program against "
+    "the time each run takes. The measured costs then replace the op counts "
+    "as the scheduling priorities.");
+
+PADDLE_DEFINE_EXPORTED_bool(
+    new_executor_frozen_mode,
+    false,
+    "After the first run of the instruction list, bind the phi kernel "
+    "context of every instruction on plain LoDTensors once and skip its "
+    "InferShape while the input dims do not change.");
+
 DECLARE_bool(check_nan_inf);
 DECLARE_bool(benchmark);
 
@@ -165,6 +183,9 @@ paddle::framework::FetchList InterpreterCore::Run(
 #ifdef PADDLE_WITH_ASCEND_CL
     platform::DeviceContextPool::Instance().Get(place_)->Wait();
 #endif
+    if (FLAGS_new_executor_frozen_mode && !is_frozen_) {
+      FreezeInstructionList();
+    }
   }
   if (create_local_scope_) {
     ClearLoDTensorArrayInLocalScope();
@@ -222,6 +243,9 @@ paddle::framework::FetchList InterpreterCore::Run(
 #ifdef PADDLE_WITH_ASCEND_CL
     platform::DeviceContextPool::Instance().Get(place_)->Wait();
 #endif
+    if (FLAGS_new_executor_frozen_mode && !is_frozen_) {
+      FreezeInstructionList();
+    }
   }
 
   if (create_local_scope_) {
@@ -265,6 +289,9 @@ void InterpreterCore::reset_scope(Scope* new_scope) {
   for (size_t i = 0; i < vec_instruction_.size(); ++i) {
     BuildAndCacheInstructionCtx(&vec_instruction_[i]);
   }
+  // the frozen kernel contexts point into the variables of the old scope
+  is_frozen_ = false;
+  frozen_instructions_.clear();
 }
 
 void InterpreterCore::ShareWorkQueueFrom(std::shared_ptr<InterpreterCore> src) {
@@ -417,9 +444,9 @@ void InterpreterCore::BuildOperatorDependences() {
   // Schedule
   auto op_nums = vec_instruction_.size();
   dependecy_count_.resize(op_nums);
-  auto op2downstream = dependency_builder_.Build(vec_instruction_);
+  op_downstream_map_ = dependency_builder_.Build(vec_instruction_);
   for (size_t op = 0; op < vec_instruction_.size(); ++op) {
-    auto op_list = op2downstream[op];
+    auto op_list = op_downstream_map_[op];
     std::vector<size_t> downsteam_vector(op_list.begin(), op_list.end());
     stream_analyzer_.Schedule(downsteam_vector, &vec_instruction_, op);
 
@@ -427,6 +454,36 @@ void InterpreterCore::BuildOperatorDependences() {
       dependecy_count_[inst_id]++;
     }
   }
+  // Until the ops are timed, the longest chain of ops after an op tells how
+  // critical it is.
+  instruction_priority_ = interpreter::CriticalPathLengths(
+      op_downstream_map_, std::vector<double>(op_nums, 1.0));
+}
+
+bool InterpreterCore::HigherPriority(size_t lhs, size_t rhs) const {
+  if (instruction_priority_[lhs] != instruction_priority_[rhs]) {
+    return instruction_priority_[lhs] > instruction_priority_[rhs];
+  }
+  // program order among equals
+  return lhs < rhs;
+}
+
+void InterpreterCore::LogCriticalPath(double makespan_us) {
+  auto lengths =
+      interpreter::CriticalPathLengths(op_downstream_map_, instruction_run_us_);
+  double critical_path_us = 0;
+  for (double length : lengths) {
+    critical_path_us = std::max(critical_path_us, length);
+  }
+  double total_us = std::accumulate(
+      instruction_run_us_.begin(), instruction_run_us_.end(), 0.0);
+  LOG(INFO) << "InterpreterCore(" << this << ") ran " << vec_instruction_.size()
+            << " instructions in " << makespan_us
+            << " us, critical path: " << critical_path_us
+            << " us, sum of instructions: " << total_us
+            << " us, critical path / makespan: "
+            << (makespan_us > 0 ? critical_path_us / makespan_us : 0);
+  instruction_priority_ = std::move(lengths);
 }
 
 // At the end of each step, the holder of Tensor in LoDTensorArray is null.
@@ -666,6 +723,8 @@ void InterpreterCore::RunInstruction(const Instruction& instr_node) {
 #endif
 
   auto op_with_kernel = dynamic_cast<const framework::OperatorWithKernel*>(op);
+  FrozenInstruction* frozen =
+      is_frozen_ ? frozen_instructions_[instr_node.Id()].get() : nullptr;
   {
     // If it is OperatorBase, InferShape do nothing.
     if (op_with_kernel != nullptr) {
@@ -675,9 +734,13 @@ void InterpreterCore::RunInstruction(const Instruction& instr_node) {
           1,
           platform::EventRole::kInnerOp);
 
-      // see OperatorWithKernel::RunImpl in operator.cc for why
-      if (!(op_with_kernel->HasAttr(kAllKernelsMustComputeRuntimeShape) &&
-            op_with_kernel->Attr<bool>(kAllKernelsMustComputeRuntimeShape))) {
+      if (frozen != nullptr) {
+        InferShapeFrozen(instr_node, frozen);
+      } else if (!(op_with_kernel->HasAttr(
+                       kAllKernelsMustComputeRuntimeShape) &&
+                   op_with_kernel->Attr<bool>(
+                       kAllKernelsMustComputeRuntimeShape))) {
+        // see OperatorWithKernel::RunImpl in operator.cc for why
         op_with_kernel->Info().infer_shape_(
             instr_node.InnerInferShapeContext().get());
       }
@@ -710,7 +773,9 @@ void InterpreterCore::RunInstruction(const Instruction& instr_node) {
       instr_node.OpBase()->Run(*local_scope, place_);
     } else {
       // fit for phi
-      if (instr_node.PhiKernel() && instr_node.PhiKernel()->IsValid()) {
+      if (frozen != nullptr) {
+        (*instr_node.PhiKernel())(&frozen->kernel_context);
+      } else if (instr_node.PhiKernel() && instr_node.PhiKernel()->IsValid()) {
         VLOG(4) << "Run phi kernel: " << op->Type();
         VLOG(4) << instr_node.InnerRuntimeContext().get() << " "
                 << &instr_node.DeviceContext();
@@ -767,6 +832,148 @@ void InterpreterCore::RunInstruction(const Instruction& instr_node) {
   }
 }
 
+void InterpreterCore::FreezeInstructionList() {
+  frozen_instructions_.clear();
+  frozen_instructions_.reserve(vec_instruction_.size());
+  size_t frozen_num = 0;
+  for (auto& instr : vec_instruction_) {
+    frozen_instructions_.emplace_back(FreezeInstruction(instr));
+    if (frozen_instructions_.back() != nullptr) {
+      ++frozen_num;
+    }
+  }
+  is_frozen_ = true;
+  VLOG(3) << "Froze " << frozen_num << " of " << vec_instruction_.size()
+          << " instructions";
+}
+
+std::unique_ptr<InterpreterCore::FrozenInstruction>
+InterpreterCore::FreezeInstruction(const Instruction& instr_node) const {
+  // InferShape of these ops reads the values of their inputs.
+  static const std::unordered_set<std::string> kValueDependentShapeOps = {
+      "range",
+      "arange",
+      "linspace",
+      "logspace",
+      "bilinear_interp",
+      "bilinear_interp_v2",
+      "nearest_interp",
+      "nearest_interp_v2",
+      "trilinear_interp",
+      "trilinear_interp_v2",
+      "bicubic_interp",
+      "bicubic_interp_v2",
+      "linear_interp",
+      "linear_interp_v2"};
+
+  auto* op = instr_node.OpBase();
+  auto* op_with_kernel = dynamic_cast<const framework::OperatorWithKernel*>(op);
+  if (op_with_kernel == nullptr || instr_node.PhiKernel() == nullptr ||
+      !instr_node.PhiKernel()->IsValid() ||
+      op_with_kernel->PhiKernelSignature() == nullptr ||
+      !instr_node.InplaceBackMap().empty() ||
+      kValueDependentShapeOps.count(op->Type())) {
+    return nullptr;
+  }
+  auto& input_names = op_with_kernel->PhiKernelSignature()->input_names;
+  auto& runtime_ctx = *instr_node.InnerRuntimeContext();
+
+  auto frozen = std::make_unique<FrozenInstruction>();
+  for (auto& pair : runtime_ctx.inputs) {
+    if (pair.second.empty()) {
+      continue;
+    }
+    // inputs outside the kernel inputs hold the values of tensor attributes,
+    // which the bound context would not see change
+    if (std::none_of(input_names.begin(),
+                     input_names.end(),
+                     [&pair](const char* name) {
+                       return std::strcmp(name, pair.first.c_str()) == 0;
+                     })) {
+      return nullptr;
+    }
+    for (auto* var : pair.second) {
+      if (var == nullptr || !var->IsType<LoDTensor>() ||
+          !var->Get<LoDTensor>().lod().empty()) {
+        return nullptr;
+      }
+      frozen->inputs.push_back(&var->Get<LoDTensor>());
+    }
+  }
+  for (auto& pair : runtime_ctx.outputs) {
+    for (auto* var : pair.second) {
+      if (var == nullptr) {
+        continue;
+      }
+      if (!var->IsType<LoDTensor>()) {
+        return nullptr;
+      }
+      frozen->outputs.push_back(var->GetMutable<LoDTensor>());
+    }
+  }
+  frozen->infer_shape =
+      !(op_with_kernel->HasAttr(kAllKernelsMustComputeRuntimeShape) &&
+        op_with_kernel->Attr<bool>(kAllKernelsMustComputeRuntimeShape));
+  op_with_kernel->BuildPhiKernelContext(
+      runtime_ctx,
+      const_cast<platform::DeviceContext*>(&instr_node.DeviceContext()),
+      &frozen->kernel_context);
+  return frozen;
+}
+
+InterpreterCore::FrozenStats InterpreterCore::GetFrozenStats() const {
+  FrozenStats stats;
+  for (auto& frozen : frozen_instructions_) {
+    if (frozen != nullptr) {
+      ++stats.frozen_num;
+      stats.infer_shape_num += frozen->infer_shape_num;
+      stats.infer_shape_skipped_num += frozen->infer_shape_skipped_num;
+    }
+  }
+  return stats;
+}
+
+void InterpreterCore::InferShapeFrozen(const Instruction& instr_node,
+                                       FrozenInstruction* frozen) {
+  if (!frozen->infer_shape) {
+    return;
+  }
+  bool shape_hit = frozen->shape_cached;
+  for (size_t i = 0; shape_hit && i < frozen->inputs.size(); ++i) {
+    shape_hit = frozen->inputs[i]->dims() == frozen->input_dims[i] &&
+                frozen->inputs[i]->lod().empty();
+  }
+  if (shape_hit) {
+    for (size_t i = 0; i < frozen->outputs.size(); ++i) {
+      if (frozen->outputs[i]->dims() != frozen->output_dims[i]) {
+        frozen->outputs[i]->Resize(frozen->output_dims[i]);
+      }
+    }
+    ++frozen->infer_shape_skipped_num;
+    return;
+  }
+  ++frozen->infer_shape_num;
+
+  auto* op_with_kernel =
+      static_cast<const framework::OperatorWithKernel*>(instr_node.OpBase());
+  op_with_kernel->Info().infer_shape_(
+      instr_node.InnerInferShapeContext().get());
+
+  // Outputs sized by the kernel, or given a LoD, are inferred on every run.
+  frozen->shape_cached = true;
+  frozen->input_dims.clear();
+  for (auto* input : frozen->inputs) {
+    frozen->shape_cached = frozen->shape_cached && input->lod().empty();
+    frozen->input_dims.push_back(input->dims());
+  }
+  frozen->output_dims.clear();
+  for (auto* output : frozen->outputs) {
+    frozen->shape_cached = frozen->shape_cached && output->lod().empty() &&
+                           !phi::contain_unknown_dim(output->dims());
+    frozen->output_dims.push_back(output->dims());
+  }
+}
+
 void InterpreterCore::ExecuteInstructionList(
     const std::vector<Instruction>& vec_instr) {
   unfinished_op_numer_ = vec_instr.size();
@@ -798,18 +1005,33 @@ void InterpreterCore::ExecuteInstructionList(
 
   exception_holder_.Clear();
 
+  measure_instructions_ = FLAGS_new_executor_critical_path_stats;
+  if (measure_instructions_) {
+    instruction_run_us_.assign(vec_instr.size(), 0);
+  }
+  auto start = std::chrono::steady_clock::now();
+
+  // The queues are FIFO for the calling thread, so the most critical ops
+  // go first.
+  std::vector<size_t> first_ops;
   for (size_t i = 0; i < dependecy_count_.size(); ++i) {
     if (dependecy_count_[i] == 0) {
-      async_work_queue_->AddTask(vec_instr.at(i).KernelType(),
-                                 [this,
-                                  i,
-                                  atomic_deps = atomic_deps.get(),
-                                  atomic_var_ref = atomic_var_ref.get()] {
-                                   RunInstructionAsync(
-                                       i, atomic_deps, atomic_var_ref);
-                                 });
+      first_ops.push_back(i);
     }
   }
+  std::sort(first_ops.begin(), first_ops.end(), [this](size_t a, size_t b) {
+    return HigherPriority(a, b);
+  });
+  for (auto i : first_ops) {
+    async_work_queue_->AddTask(vec_instr.at(i).KernelType(),
+                               [this,
+                                i,
+                                atomic_deps = atomic_deps.get(),
+                                atomic_var_ref = atomic_var_ref.get()] {
+                                 RunInstructionAsync(
+                                     i, atomic_deps, atomic_var_ref);
+                               });
+  }
 
   auto event_name = main_thread_blocker_.WaitEvent();
   VLOG(1) << "main_thread_blocker_(" << &main_thread_blocker_
@@ -831,6 +1053,12 @@ void InterpreterCore::ExecuteInstructionList(
     VLOG(4) << "clear ok";
     exception_holder_.ReThrow();
   }
+
+  if (measure_instructions_) {
+    std::chrono::duration<double, std::micro> makespan =
+        std::chrono::steady_clock::now() - start;
+    LogCriticalPath(makespan.count());
+  }
 }
 
 void InterpreterCore::RunNextInstructions(
@@ -884,15 +1112,24 @@ void InterpreterCore::RunNextInstructions(
     }
     auto direct_run_ops = interpreter::merge_vector(next_instr.SyncRunIds(),
                                                     next_instr.DirectRunIds());
-    int64_t first_op = -1;
+    std::vector<size_t> ready_ops;
     for (auto next_id : direct_run_ops) {
       if (IsReady(next_id)) {
-        // only keep one op running in current thread
-        if (first_op == -1) {
-          first_op = next_id;
-          continue;
-        }
-        // move rest ops into other threads
+        ready_ops.push_back(next_id);
+      }
+    }
+    if (!ready_ops.empty()) {
+      // Only keep the most critical op running in current thread. A worker
+      // pops its own queue from the front, where the last pushed task is, so
+      // the rest go in ascending priority and the thieves take the least
+      // critical ones.
+      std::sort(ready_ops.begin(),
+                ready_ops.end(),
+                [this](size_t a, size_t b) { return HigherPriority(b, a); });
+      reserved_next_ops->push(ready_ops.back());
+      ready_ops.pop_back();
+      // move rest ops into other threads
+      for (auto next_id : ready_ops) {
         async_work_queue_->AddTask(
             vec_instruction_[next_id].KernelType(),
             [this, next_id, atomic_deps, atomic_var_ref] {
@@ -900,7 +1137,6 @@ void InterpreterCore::RunNextInstructions(
             });
       }
     }
-    if (first_op != -1) reserved_next_ops->push(first_op);
   }
 }
 
@@ -926,6 +1162,11 @@ void InterpreterCore::RunInstructionAsync(
         op->Type(), platform::TracerEventType::Operator, 1);
 
     try {
+      std::chrono::steady_clock::time_point start;
+      if (measure_instructions_) {
+        start = std::chrono::steady_clock::now();
+      }
+
       interpreter::WaitEvent(instr_node, place_);
 
       RunInstruction(instr_node);
@@ -933,6 +1174,13 @@ void InterpreterCore::RunInstructionAsync(
       CheckGC(instr_node, atomic_var_ref);
 
       interpreter::RecordEvent(instr_node, place_);
+
+      // Only the host side of a device kernel, i.e. its launch, is timed.
+      if (measure_instructions_) {
+        std::chrono::duration<double, std::micro> cost =
+            std::chrono::steady_clock::now() - start;
+        instruction_run_us_[instr_id] = cost.count();
+      }
     } catch (platform::EnforceNotMet& ex) {
       framework::InsertCallStackInfo(op->Type(), op->Attrs(), &ex);
       exception_holder_.Catch(std::make_exception_ptr(std::move(ex)));
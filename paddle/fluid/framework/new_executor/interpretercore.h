@@ -14,6 +14,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <queue>
 #include <string>
 #include <unordered_map>
@@ -32,6 +33,7 @@
 #include "paddle/fluid/framework/variable.h"
 #include "paddle/fluid/memory/allocation/spin_lock.h"
 #include "paddle/fluid/platform/device_event.h"
+#include "paddle/phi/core/kernel_context.h"
 
 namespace paddle {
 namespace framework {
@@ -66,6 +68,16 @@ class InterpreterCore {
 
   void reset_scope(Scope* new_scope);
 
+  // The number of frozen instructions, and how many times their InferShape
+  // ran or was skipped, see FLAGS_new_executor_frozen_mode.
+  struct FrozenStats {
+    size_t frozen_num{0};
+    size_t infer_shape_num{0};
+    size_t infer_shape_skipped_num{0};
+  };
+
+  FrozenStats GetFrozenStats() const;
+
  private:
   bool BuildInplaceCheckVarIsOnlyInput(size_t var_index);
 
@@ -106,8 +118,42 @@ class InterpreterCore {
 
   void BuildSkipShareLoDInfo();
 
+  // Whether instruction lhs should be dispatched before rhs.
+  bool HigherPriority(size_t lhs, size_t rhs) const;
+
+  // Logs the critical path of the timed run and adopts the measured costs
+  // as the scheduling priorities.
+  void LogCriticalPath(double makespan_us);
+
   void SetFeedVarsInplaceSkip(const std::vector<std::string>& feed_names);
 
+  // With FLAGS_new_executor_frozen_mode, an instruction whose phi kernel only
+  // reads and writes plain LoDTensors gets its kernel context bound once, and
+  // its InferShape is skipped while its inputs keep the dims of the run that
+  // last inferred its outputs.
+  struct FrozenInstruction {
+    phi::KernelContext kernel_context;
+    // false for ops with kAllKernelsMustComputeRuntimeShape
+    bool infer_shape{true};
+    bool shape_cached{false};
+    std::vector<const phi::DenseTensor*> inputs;
+    std::vector<phi::DDim> input_dims;
+    std::vector<phi::DenseTensor*> outputs;
+    std::vector<phi::DDim> output_dims;
+    size_t infer_shape_num{0};
+    size_t infer_shape_skipped_num{0};
+  };
+
+  // Called after a run of the instruction list, when all the variables of
+  // the program have their types.
+  void FreezeInstructionList();
+
+  std::unique_ptr<FrozenInstruction> FreezeInstruction(
+      const Instruction& instr_node) const;
+
+  void InferShapeFrozen(const Instruction& instr_node,
+                        FrozenInstruction* frozen);
+
   bool is_build_;
 
   platform::Place place_;
@@ -133,6 +179,15 @@ class InterpreterCore {
   std::map<size_t, std::set<size_t>> last_live_ops_;
 
   std::vector<size_t> dependecy_count_;
+  std::map<int, std::set<int>> op_downstream_map_;
+  // the cost of the most expensive path from an instruction to the end, in
+  // ops or, after a run with FLAGS_new_executor_critical_path_stats, in us
+  std::vector<double> instruction_priority_;
+  bool measure_instructions_{false};
+  std::vector<double> instruction_run_us_;
+  bool is_frozen_{false};
+  // indexed by instruction id, nullptr for the instructions run as usual
+  std::vector<std::unique_ptr<FrozenInstruction>> frozen_instructions_;
   std::atomic<size_t> unfinished_op_numer_{0};
   std::vector<std::vector<size_t>> input_var2op_info_;
 
@@ -103,6 +103,8 @@ PD_DECLARE_KERNEL(cross_entropy_with_softmax_grad, GPU, ALL_LAYOUT);
 PD_DECLARE_KERNEL(sqrt, GPU, ALL_LAYOUT);
 PD_DECLARE_KERNEL(add_n, GPU, ALL_LAYOUT);
 
+DECLARE_bool(new_executor_frozen_mode);
+
 namespace paddle {
 namespace framework {
 
@@ -274,5 +276,75 @@ TEST(InterpreterCore, workqueue_multiplexing) {
       program, {"a", "b"}, {tensor_a, tensor_b}, {"c"}, {0.0, 1.1, 2.2, 3.3});
 }
 
+TEST(InterpreterCore, frozen_mode) {
+  FLAGS_new_executor_frozen_mode = true;
+
+  ProgramDesc program;
+  BlockDesc* main_block = program.MutableBlock(0);
+  for (auto name : {"a", "b", "c", "d"}) {
+    main_block->Var(name)->SetType(proto::VarType::LOD_TENSOR);
+  }
+  OpDesc* add = main_block->AppendOp();
+  add->SetType("elementwise_add");
+  add->SetInput("X", {"a"});
+  add->SetInput("Y", {"b"});
+  add->SetOutput("Out", {"c"});
+  OpDesc* mul = main_block->AppendOp();
+  mul->SetType("elementwise_mul");
+  mul->SetInput("X", {"c"});
+  mul->SetInput("Y", {"b"});
+  mul->SetOutput("Out", {"d"});
+
+  const platform::CPUPlace place = platform::CPUPlace();
+  Scope scope;
+  std::shared_ptr<InterpreterCore> core =
+      CreateInterpreterCore(place, program, &scope, {"d"});
+
+  auto run_and_check = [&](const std::vector<int64_t>& shape) {
+    phi::DDim dims = phi::make_ddim(shape);
+    LoDTensor tensor_a, tensor_b;
+    float* a = tensor_a.mutable_data<float>(dims, place);
+    float* b = tensor_b.mutable_data<float>(dims, place);
+    for (int64_t i = 0; i < tensor_a.numel(); ++i) {
+      a[i] = i;
+      b[i] = 2;
+    }
+    FetchList fetch_list = core->Run({"a", "b"}, {tensor_a, tensor_b});
+    auto& d = PADDLE_GET_CONST(LoDTensor, fetch_list[0]);
+    ASSERT_EQ(d.dims(), dims);
+    for (int64_t i = 0; i < d.numel(); ++i) {
+      ASSERT_FLOAT_EQ(d.data<float>()[i], (i + 2) * 2);
+    }
+  };
+
+  // the instructions are frozen after the second run, then the cached
+  // shapes are used until the feeds change their dims
+  run_and_check({2, 2});
+  run_and_check({2, 2});
+  InterpreterCore::FrozenStats stats = core->GetFrozenStats();
+  // elementwise_add and elementwise_mul, not feed and fetch_v2
+  EXPECT_EQ(stats.frozen_num, 2UL);
+  EXPECT_EQ(stats.infer_shape_num, 0UL);
+  EXPECT_EQ(stats.infer_shape_skipped_num, 0UL);
+
+  run_and_check({2, 2});
+  stats = core->GetFrozenStats();
+  EXPECT_EQ(stats.infer_shape_num, 2UL);
+  EXPECT_EQ(stats.infer_shape_skipped_num, 0UL);
+  run_and_check({2, 2});
+  stats = core->GetFrozenStats();
+  EXPECT_EQ(stats.infer_shape_num, 2UL);
+  EXPECT_EQ(stats.infer_shape_skipped_num, 2UL);
+
+  run_and_check({3, 2});
+  run_and_check({3, 2});
+  run_and_check({2, 2});
+  stats = core->GetFrozenStats();
+  EXPECT_EQ(stats.infer_shape_num, 6UL);
+  EXPECT_EQ(stats.infer_shape_skipped_num, 4UL);
+
+  FLAGS_new_executor_frozen_mode = false;
+}
+
 }  // namespace framework
 }  // namespace paddle
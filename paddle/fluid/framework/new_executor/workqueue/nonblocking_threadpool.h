@@ -17,6 +17,7 @@
 #include "paddle/fluid/framework/new_executor/workqueue/event_count.h"
 #include "paddle/fluid/framework/new_executor/workqueue/run_queue.h"
 #include "paddle/fluid/framework/new_executor/workqueue/thread_environment.h"
+#include "paddle/fluid/framework/new_executor/workqueue/workqueue_utils.h"
 #include "paddle/fluid/platform/os_info.h"
 #include "paddle/fluid/platform/profiler/event_tracing.h"
 
@@ -33,11 +34,14 @@ class ThreadPoolTempl {
                   int num_threads,
                   bool allow_spinning,
                   bool always_spinning,
+                  int spin_count = -1,
+                  bool numa_aware = false,
                   Environment env = Environment())
       : env_(env),
         allow_spinning_(allow_spinning),
         always_spinning_(always_spinning),
-        global_steal_partition_(EncodePartition(0, num_threads_)),
+        spin_count_(spin_count),
+        global_steal_partition_(EncodePartition(0, num_threads)),
         blocked_(0),
         num_tasks_(0),
         done_(false),
@@ -61,6 +65,11 @@ class ThreadPoolTempl {
     }
     for (int i = 0; i < num_threads_; i++) {
       SetStealPartition(i, EncodePartition(0, num_threads_));
+    }
+    if (numa_aware) {
+      PartitionByNumaNode();
+    }
+    for (int i = 0; i < num_threads_; i++) {
       thread_data_[i].thread.reset(
           env_.CreateThread([this, i]() { WorkerLoop(i); }));
     }
@@ -232,15 +241,17 @@ class ThreadPoolTempl {
   };
 
   struct ThreadData {
-    constexpr ThreadData() : thread(), steal_partition(0), queue() {}
+    ThreadData() : thread(), steal_partition(0), queue() {}
     std::unique_ptr<Thread> thread;
     std::atomic<unsigned> steal_partition;
     Queue queue;
+    std::vector<int> cpus;  // pinned to, empty if not pinned
   };
 
   Environment env_;
   const bool allow_spinning_;
   const bool always_spinning_;
+  const int spin_count_;
   std::vector<std::vector<unsigned>> all_coprimes_;
   unsigned global_steal_partition_;
   std::atomic<unsigned> blocked_;
@@ -252,11 +263,45 @@ class ThreadPoolTempl {
   std::vector<ThreadData> thread_data_;
   std::string name_;
 
+  // Spreads the workers evenly over the NUMA nodes, consecutive workers on the
+  // same node, and limits their local steal to the workers of the node.
+  // Going through a remote node's queues only happens in the global steal,
+  // when the node has run out of work.
+  void PartitionByNumaNode() {
+    auto node_cpus = GetNumaNodeCpus();
+    if (node_cpus.empty()) {
+      VLOG(1) << name_ << " found no NUMA topology, threads are not pinned";
+      return;
+    }
+    int num_nodes = node_cpus.size();
+    std::vector<std::pair<unsigned, unsigned>> partitions(num_threads_);
+    for (int node = 0; node < num_nodes; ++node) {
+      unsigned start = static_cast<int64_t>(node) * num_threads_ / num_nodes;
+      unsigned limit =
+          static_cast<int64_t>(node + 1) * num_threads_ / num_nodes;
+      for (unsigned i = start; i < limit; ++i) {
+        partitions[i] = std::make_pair(start, limit);
+        thread_data_[i].cpus = node_cpus[node];
+      }
+    }
+    // fewer threads than nodes leave some nodes empty
+    bool all_filled = true;
+    for (auto& partition : partitions) {
+      all_filled = all_filled && partition.first < partition.second;
+    }
+    if (all_filled) {
+      SetStealPartitions(partitions);
+    }
+  }
+
   // Main worker thread loop.
   void WorkerLoop(int thread_id) {
     std::string thr_name = name_ + "_thread_" + std::to_string(thread_id);
     VLOG(1) << thr_name << " started ";
     platform::SetCurrentThreadName(thr_name);
+    if (!thread_data_[thread_id].cpus.empty()) {
+      BindCurrentThreadToCpus(thread_data_[thread_id].cpus);
+    }
     PerThread* pt = GetPerThread();
     pt->pool = this;
     pt->rand = GlobalThreadIdHash();
@@ -268,7 +313,9 @@ class ThreadPoolTempl {
     // a constant rate, so we set spin_count to 5000 / num_threads_. The
     // constant was picked based on a fair dice roll, tune it.
     const int spin_count =
-        allow_spinning_ && num_threads_ > 0 ? 5000 / num_threads_ : 0;
+        !allow_spinning_ || num_threads_ <= 0
+            ? 0
+            : (spin_count_ >= 0 ? spin_count_ : 5000 / num_threads_);
     if (num_threads_ == 1) {
       // For num_threads_ == 1 there is no point in going through the expensive
       // steal loop. Moreover, since NonEmptyQueueIndex() calls PopBack() on the
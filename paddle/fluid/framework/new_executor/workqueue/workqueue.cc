@@ -50,7 +50,9 @@ class WorkQueueImpl : public WorkQueue {
     queue_ = new NonblockingThreadPool(options_.name,
                                        options_.num_threads,
                                        options_.allow_spinning,
-                                       options_.always_spinning);
+                                       options_.always_spinning,
+                                       options_.spin_count,
+                                       options_.numa_aware);
   }
 
   virtual ~WorkQueueImpl() {
@@ -143,7 +145,9 @@ WorkQueueGroupImpl::WorkQueueGroupImpl(
         NonblockingThreadPool(options.name,
                               options.num_threads,
                               options.allow_spinning,
-                              options.always_spinning);
+                              options.always_spinning,
+                              options.spin_count,
+                              options.numa_aware);
   }
 }
 
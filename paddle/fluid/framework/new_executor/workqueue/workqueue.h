@@ -93,6 +93,13 @@ struct WorkQueueOptions {
   // Worker threads will never sleep if this flag is set.
   // Better performance vs. higher CPU utilization.
   bool always_spinning{false};
+  // Rounds a worker out of work spins looking for tasks before it parks,
+  // with allow_spinning set. Negative means 5000 / num_threads.
+  // Higher wake-up latency vs. higher CPU utilization.
+  int spin_count{-1};
+  // Pin the worker threads to the NUMA nodes, spread evenly, and let them
+  // steal from the workers of their own node before the remote ones.
+  bool numa_aware{false};
   // If you need to blocking the calling  thread to wait "queue empty", set
   // track_task = true and set events_waiter. EventsWaiter::WaitEvent will
   // block the calling thread until any of events (including "queue empty")
@@ -14,8 +14,13 @@
 
 #include "paddle/fluid/framework/new_executor/workqueue/workqueue.h"
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include <atomic>
 #include <thread>
+#include <vector>
 
 #include "glog/logging.h"
 #include "gtest/gtest.h"
@@ -37,6 +42,60 @@ TEST(WorkQueueUtils, TestEventsWaiter) {
   notifier->CancelEvent();
 }
 
+TEST(WorkQueueUtils, TestParseCpuList) {
+  using paddle::framework::ParseCpuList;
+  EXPECT_EQ(ParseCpuList("0-3,8,10-11"),
+            std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_EQ(ParseCpuList("5"), std::vector<int>({5}));
+  EXPECT_TRUE(ParseCpuList("").empty());
+}
+
+#ifdef __linux__
+TEST(WorkQueueUtils, TestBindCurrentThreadToCpus) {
+  using paddle::framework::BindCurrentThreadToCpus;
+  std::thread thread([] {
+    // no cpu the thread is allowed on, it is left unpinned
+    EXPECT_FALSE(BindCurrentThreadToCpus({CPU_SETSIZE - 1}));
+    EXPECT_FALSE(BindCurrentThreadToCpus({}));
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    int cpu = 0;
+    while (!CPU_ISSET(cpu, &allowed)) ++cpu;
+    EXPECT_TRUE(BindCurrentThreadToCpus({cpu, CPU_SETSIZE - 1}));
+    cpu_set_t bound;
+    CPU_ZERO(&bound);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(bound), &bound), 0);
+    EXPECT_EQ(CPU_COUNT(&bound), 1);
+    EXPECT_TRUE(CPU_ISSET(cpu, &bound));
+  });
+  thread.join();
+}
+#endif
+
+TEST(WorkQueue, TestNumaAwareWorkQueue) {
+  using paddle::framework::CreateMultiThreadedWorkQueue;
+  using paddle::framework::WorkQueueOptions;
+  // runs the same on a single node machine, where threads are not pinned
+  WorkQueueOptions options("NumaAwareWorkQueueForTesting",
+                           /*num_threads*/ 4,
+                           /*allow_spinning*/ true,
+                           /*track_task*/ false);
+  options.numa_aware = true;
+  options.spin_count = 10;
+  auto work_queue = CreateMultiThreadedWorkQueue(options);
+  std::atomic<unsigned> counter{0};
+  std::vector<std::future<int>> handles;
+  for (int i = 0; i < 100; ++i) {
+    handles.emplace_back(
+        work_queue->AddAwaitableTask([&counter, i]() { return ++counter, i; }));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(handles[i].get(), i);
+  }
+  EXPECT_EQ(counter.load(), 100u);
+}
+
 TEST(WorkQueue, TestSingleThreadedWorkQueue) {
   VLOG(1) << "In Test";
   using paddle::framework::CreateSingleThreadedWorkQueue;
@@ -14,8 +14,17 @@
 
 #include "paddle/fluid/framework/new_executor/workqueue/workqueue_utils.h"
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include <cstdint>
 #include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "glog/logging.h"
 
 namespace paddle {
 namespace framework {
@@ -56,5 +65,75 @@ void AlignedFree(void* mem_ptr) {
 #endif
 }
 
+std::vector<int> ParseCpuList(const std::string& cpu_list) {
+  std::vector<int> cpus;
+  std::istringstream is(cpu_list);
+  std::string range;
+  while (std::getline(is, range, ',')) {
+    if (range.empty()) continue;
+    int first = 0;
+    int last = 0;
+    auto dash = range.find('-');
+    try {
+      first = std::stoi(range.substr(0, dash));
+      last = dash == std::string::npos ? first
+                                       : std::stoi(range.substr(dash + 1));
+    } catch (const std::exception&) {
+      return {};
+    }
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+std::vector<std::vector<int>> GetNumaNodeCpus() {
+  std::vector<std::vector<int>> node_cpus;
+#ifdef __linux__
+  for (int node = 0;; ++node) {
+    std::ifstream fin("/sys/devices/system/node/node" + std::to_string(node) +
+                      "/cpulist");
+    if (!fin.is_open()) break;
+    std::string cpu_list;
+    std::getline(fin, cpu_list);
+    auto cpus = ParseCpuList(cpu_list);
+    // memory-only nodes have no cpu
+    if (!cpus.empty()) node_cpus.emplace_back(std::move(cpus));
+  }
+#endif
+  if (node_cpus.size() < 2) node_cpus.clear();
+  return node_cpus;
+}
+
+bool BindCurrentThreadToCpus(const std::vector<int>& cpus) {
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &mask);
+  }
+  // keep within the cpus the thread is allowed on, e.g. by taskset or a
+  // container cpuset
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+    CPU_AND(&mask, &mask, &allowed);
+  }
+  if (CPU_COUNT(&mask) == 0) {
+    VLOG(1) << "None of the cpus is allowed for the thread, skip binding";
+    return false;
+  }
+  int ret = pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+  if (ret != 0) {
+    VLOG(1) << "Failed to set the cpu affinity of the thread, error " << ret;
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
 }  // namespace framework
 }  // namespace paddle
@@ -21,6 +21,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "paddle/fluid/framework/new_executor/workqueue/events_waiter.h"
 #include "paddle/fluid/platform/enforce.h"
@@ -69,6 +70,18 @@ void* AlignedMalloc(size_t size, size_t alignment);
 
 void AlignedFree(void* memory_ptr);
 
+// The cpus of each NUMA node, read from sysfs. Empty if the machine has a
+// single node or its topology is unknown.
+std::vector<std::vector<int>> GetNumaNodeCpus();
+
+// Parses a sysfs cpu list such as "0-3,8,10-11".
+std::vector<int> ParseCpuList(const std::string& cpu_list);
+
+// Restricts the calling thread to the given cpus among the ones it is
+// allowed on, returns false if the affinity is not supported, none of the
+// cpus is allowed or the affinity can not be set.
+bool BindCurrentThreadToCpus(const std::vector<int>& cpus);
+
 template <typename Notifier>
 class TaskTracker {
  public:
@@ -1450,6 +1450,29 @@ void OperatorWithKernel::RunImpl(const Scope& scope,
   }
 }
 
+bool OperatorWithKernel::HasCompatiblePhiKernel() const {
+  auto& kernel_factory = phi::KernelFactory::Instance();
+  uint64_t epoch = kernel_factory.epoch();
+  if (epoch != phi_kernel_registry_epoch_) {
+    has_compatible_phi_kernel_ = kernel_factory.HasCompatiblePhiKernel(type_);
+    phi_kernel_registry_epoch_ = epoch;
+  }
+  return has_compatible_phi_kernel_;
+}
+
+void OperatorWithKernel::BindRuntimeContext(
+    std::unique_ptr<RuntimeContext> ctx, const Scope* scope) const {
+  std::lock_guard<std::mutex> lock(cache_update_mutex_);
+  runtime_ctx_ = std::move(ctx);
+  // RunImpl turns the cache on again for kEnableCacheRuntimeContext
+  enable_cache_runtime_context_ = runtime_ctx_ != nullptr;
+  pre_scope_ = runtime_ctx_ ? scope : nullptr;
+  // the kernel context cached for the former variables
+  delete impl_;
+  impl_ = nullptr;
+  need_prepare_data_ = true;
+}
+
 void OperatorWithKernel::RunImpl(const Scope& scope,
                                  const platform::Place& place,
                                  RuntimeContext* runtime_ctx) const {
@@ -1486,7 +1509,7 @@ void OperatorWithKernel::RunImpl(const Scope& scope,
   // phase
   phi::KernelKey phi_kernel_key;
   std::string phi_kernel_name;
-  if (phi::KernelFactory::Instance().HasCompatiblePhiKernel(type_)) {
+  if (HasCompatiblePhiKernel()) {
     if (kernel_signature_ == nullptr || phi_kernel_ == nullptr) {
       kernel_signature_.reset(new phi::KernelSignature(
           std::move(GetExpectedPhiKernelArgs(exe_ctx))));
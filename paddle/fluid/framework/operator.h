@@ -674,6 +674,10 @@ class OperatorWithKernel : public OperatorBase {
 
   void ChooseKernel(const ExecutionContext& ctx) const;
 
+  // KernelFactory::HasCompatiblePhiKernel(type_), looked up again only when
+  // the registered kernels change.
+  bool HasCompatiblePhiKernel() const;
+
   void BuildPhiKernelContext(const RuntimeContext& ctx,
                              platform::DeviceContext* dev_ctx,
                              phi::KernelContext* phi_kernel_context) const;
@@ -684,6 +688,13 @@ class OperatorWithKernel : public OperatorBase {
 
   phi::Kernel* PhiKernel() const { return phi_kernel_.get(); }
 
+  // Run on `scope` with the variables of `ctx` instead of looking up the
+  // names, the same as kEnableCacheRuntimeContext does with the first
+  // lookup, including the cached kernel context that skips PrepareData. A
+  // nullptr ctx makes every run look the names up again.
+  void BindRuntimeContext(std::unique_ptr<RuntimeContext> ctx,
+                          const Scope* scope) const;
+
   void ResetPhiKernel(phi::Kernel* kernel) const {
     return phi_kernel_.reset(kernel);
   }
@@ -751,6 +762,8 @@ class OperatorWithKernel : public OperatorBase {
   // new phi kernel, if there is a better design in the future,
   // we may polish the implementation here
   mutable bool run_phi_kernel_ = false;
+  mutable bool has_compatible_phi_kernel_ = false;
+  mutable uint64_t phi_kernel_registry_epoch_ = UINT64_MAX;
   mutable bool run_kp_kernel = false;
   mutable std::unique_ptr<phi::KernelSignature> kernel_signature_;
   mutable std::unique_ptr<phi::Kernel> phi_kernel_;
@@ -13,11 +13,15 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 #include "paddle/fluid/framework/operator.h"
 
+#include <chrono>  // NOLINT
+#include <iostream>
+
 #include "gtest/gtest.h"
 #include "paddle/fluid/framework/op_info.h"
 #include "paddle/fluid/framework/op_registry.h"
 #include "paddle/fluid/platform/errors.h"
 #include "paddle/fluid/platform/init.h"
+#include "paddle/phi/core/kernel_factory.h"
 
 DECLARE_bool(enable_unused_var_check);
 
@@ -268,6 +272,65 @@ TEST(OpKernel, all) {
   ASSERT_EQ(paddle::framework::cpu_kernel2_run_num, 1);
 }
 
+std::unique_ptr<paddle::framework::OperatorBase> CreateOpWithKernel() {
+  paddle::framework::proto::OpDesc op_desc;
+  op_desc.set_type("op_with_kernel");
+  BuildVar("x", {"IN1"}, op_desc.add_inputs());
+  BuildVar("y", {"OUT1"}, op_desc.add_outputs());
+
+  auto attr = op_desc.mutable_attrs()->Add();
+  attr->set_name("scale");
+  attr->set_type(paddle::framework::proto::AttrType::FLOAT);
+  attr->set_f(3.14);
+  return paddle::framework::OpRegistry::CreateOp(op_desc);
+}
+
+TEST(OpKernel, has_compatible_phi_kernel) {
+  paddle::framework::InitDevices();
+  auto op = CreateOpWithKernel();
+  auto* op_with_kernel =
+      dynamic_cast<paddle::framework::OperatorWithKernel*>(op.get());
+  ASSERT_NE(op_with_kernel, nullptr);
+  EXPECT_FALSE(op_with_kernel->HasCompatiblePhiKernel());
+
+  // the cached result follows changes of the phi kernel registry
+  auto& factory = phi::KernelFactory::Instance();
+  factory.kernels()["op_with_kernel"];
+  EXPECT_TRUE(op_with_kernel->HasCompatiblePhiKernel());
+  factory.kernels().erase("op_with_kernel");
+  EXPECT_FALSE(op_with_kernel->HasCompatiblePhiKernel());
+}
+
+// The cost of the phi kernel check that OperatorWithKernel does on every run.
+// It is a benchmark, run it with --gtest_also_run_disabled_tests.
+TEST(OpKernel, DISABLED_HasCompatiblePhiKernelCost) {
+  paddle::framework::InitDevices();
+  auto op = CreateOpWithKernel();
+  auto* op_with_kernel =
+      dynamic_cast<paddle::framework::OperatorWithKernel*>(op.get());
+  ASSERT_NE(op_with_kernel, nullptr);
+  auto& factory = phi::KernelFactory::Instance();
+  const int kRepeat = 1000000;
+  size_t checksum = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRepeat; ++i) {
+    checksum += factory.HasCompatiblePhiKernel(op->Type());
+  }
+  auto map_end = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRepeat; ++i) {
+    checksum += op_with_kernel->HasCompatiblePhiKernel();
+  }
+  auto op_end = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(checksum, 0UL);
+  std::chrono::duration<double, std::nano> map_ns = map_end - start;
+  std::chrono::duration<double, std::nano> op_ns = op_end - map_end;
+  std::cout << "phi kernel check: " << map_ns.count() / kRepeat
+            << " ns by registry, " << op_ns.count() / kRepeat
+            << " ns by the op" << std::endl;
+}
+
 REGISTER_OP_WITHOUT_GRADIENT(
     op_multi_inputs_with_kernel,
     paddle::framework::OpWithKernelTest,
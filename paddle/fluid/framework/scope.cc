@@ -166,6 +166,7 @@ void Scope::EraseVars(const std::vector<std::string>& var_names) {
     SCOPE_VARS_WRITER_LOCK
     for (auto it = vars_.begin(); it != vars_.end();) {
       if (var_set.find(it->first) != var_set.end()) {
+        UpdateVarSlot(it->first, nullptr);
         it = vars_.erase(it);
       } else {
         ++it;
@@ -196,6 +197,7 @@ Variable* Scope::VarInternal(const std::string& name) {
   if (v != nullptr) return v;
   v = new Variable();
   vars_.emplace(name, std::unique_ptr<Variable>(v));
+  UpdateVarSlot(name, v);
   VLOG(3) << "Create variable " << name;
   return v;
 }
@@ -231,8 +233,11 @@ void Scope::RenameInternal(const std::string& origin_name,
       vars_.end(),
       platform::errors::AlreadyExists(
           "The variable with name %s already exists in the scope.", new_name));
+  Variable* var = origin_it->second.get();
   vars_[new_name].reset(origin_it->second.release());
   vars_.erase(origin_it);
+  UpdateVarSlot(origin_name, nullptr);
+  UpdateVarSlot(new_name, var);
 }
 
 Variable* Scope::FindVarInternal(const std::string& name) const {
@@ -251,12 +256,56 @@ Variable* Scope::FindVarLocally(const std::string& name) const {
   return nullptr;
 }
 
+size_t Scope::InternVar(const std::string& name) {
+  size_t id = 0;
+  InternVarSlot(name, &id);
+  return id;
+}
+
+const Scope::VarSlot* Scope::InternVarSlot(const std::string& name,
+                                           size_t* id) const {
+  SCOPE_VARS_WRITER_LOCK
+  auto it = var_slot_ids_.find(name);
+  if (it != var_slot_ids_.end()) {
+    *id = it->second;
+    return var_slots_[it->second].get();
+  }
+  std::unique_ptr<VarSlot> slot(new VarSlot());
+  slot->var.store(FindVarLocally(name), std::memory_order_release);
+  // the ancestors are locked after this scope, as FindVar does
+  if (parent_ != nullptr) {
+    size_t parent_id = 0;
+    slot->parent = parent_->InternVarSlot(name, &parent_id);
+  }
+  var_slots_.push_back(std::move(slot));
+  *id = var_slots_.size() - 1;
+  var_slot_ids_.emplace(name, *id);
+  return var_slots_.back().get();
+}
+
+void Scope::UpdateVarSlot(const std::string& name, Variable* var) const {
+  if (var_slot_ids_.empty()) {
+    return;
+  }
+  auto it = var_slot_ids_.find(name);
+  if (it == var_slot_ids_.end()) {
+    return;
+  }
+  // an erased name is resolved by the slots of the ancestors again
+  auto& slot = var_slots_[it->second]->var;
+  if (slot.load(std::memory_order_relaxed) != var) {
+    slot.store(var, std::memory_order_release);
+    var_slots_version_.fetch_add(1, std::memory_order_release);
+  }
+}
+
 void Scope::EraseVarsExcept(const std::unordered_set<Variable*>& vars) {
   SCOPE_VARS_WRITER_LOCK
   for (auto iter = vars_.begin(); iter != vars_.end();) {
     if (vars.count(iter->second.get()) != 0) {
       ++iter;
     } else {
+      UpdateVarSlot(iter->first, nullptr);
       vars_.erase(iter++);
     }
   }
@@ -18,6 +18,7 @@ extern "C" {
 #include <xxhash.h>
 }
 
+#include <atomic>
 #include <list>
 #include <memory>
 #include <string>
@@ -137,6 +138,33 @@ class Scope : public ScopeBase {
 
   void SetCanReuesd(bool can_reused) { can_reused_ = can_reused; }
 
+  /// Intern a variable name into a slot id of this scope. The name is
+  /// interned into the ancestors as well, so the slot resolves to what
+  /// FindVar(name) returns through the creation, erasure and renaming of the
+  /// name in this scope or in any ancestor. Intern all the names before
+  /// calling the lock free FindVarById of this scope or of its kids.
+  size_t InternVar(const std::string& name);
+
+  /// The variable in slot `id`, by array index and without any lock.
+  Variable* FindVarById(size_t id) const {
+    for (const VarSlot* slot = var_slots_[id].get(); slot != nullptr;
+         slot = slot->parent) {
+      Variable* var = slot->var.load(std::memory_order_acquire);
+      if (var != nullptr) {
+        return var;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Bumped whenever a slot of this scope or of an ancestor changes its
+  /// variable, so that anything built from the slots knows it has to be
+  /// rebuilt.
+  uint64_t VarSlotsVersion() const {
+    uint64_t version = var_slots_version_.load(std::memory_order_acquire);
+    return parent_ == nullptr ? version : version + parent_->VarSlotsVersion();
+  }
+
  protected:
   struct KeyHasher {
     std::size_t operator()(const std::string& key) const {
@@ -148,6 +176,13 @@ class Scope : public ScopeBase {
       vars_;
 
  private:
+  struct VarSlot {
+    // the variable of the name in this scope
+    std::atomic<Variable*> var{nullptr};
+    // the slot of the name in the parent scope, nullptr in the root scope
+    const VarSlot* parent{nullptr};
+  };
+
   // Call Scope::NewScope for a sub-scope.
   explicit Scope(Scope const* parent) : parent_(parent) {}
 
@@ -170,6 +205,12 @@ class Scope : public ScopeBase {
   // Called by FindVarInternal and Var.
   Variable* FindVarLocally(const std::string& name) const;
 
+  // Called by InternVar, and by the kids for their slots of `name`.
+  const VarSlot* InternVarSlot(const std::string& name, size_t* id) const;
+
+  // Called with vars_lock_ held when `name` gets the variable `var` locally.
+  void UpdateVarSlot(const std::string& name, Variable* var) const;
+
   // Scope in `kids_` are owned by this class.
   mutable std::list<Scope*> kids_;
   const Scope* parent_{nullptr};
@@ -177,6 +218,12 @@ class Scope : public ScopeBase {
   // only for dygraph_to_static
   bool can_reused_{false};
 
+  // Interned names, see InternVar. Every slot is allocated on its own for
+  // the kids keep pointers to it.
+  mutable std::unordered_map<std::string, size_t, KeyHasher> var_slot_ids_;
+  mutable std::vector<std::unique_ptr<VarSlot>> var_slots_;
+  mutable std::atomic<uint64_t> var_slots_version_{0};
+
   DISABLE_COPY_AND_ASSIGN(Scope);
 
  private:
@@ -77,3 +77,47 @@ TEST(Scope, GetAllNames) {
 
   EXPECT_STREQ("a", str.c_str());
 }
+
+TEST(Scope, InternVar) {
+  Scope s;
+  Variable* a = s.Var("a");
+  Scope& ss = s.NewScope();
+
+  size_t id_a = ss.InternVar("a");
+  size_t id_b = ss.InternVar("b");
+  EXPECT_EQ(id_a, ss.InternVar("a"));
+  EXPECT_NE(id_a, id_b);
+  EXPECT_EQ(a, ss.FindVarById(id_a));
+  EXPECT_EQ(nullptr, ss.FindVarById(id_b));
+
+  uint64_t version = ss.VarSlotsVersion();
+  Variable* b = ss.Var("b");
+  EXPECT_EQ(b, ss.FindVarById(id_b));
+  Variable* local_a = ss.Var("a");
+  EXPECT_EQ(local_a, ss.FindVarById(id_a));
+  EXPECT_GT(ss.VarSlotsVersion(), version);
+
+  // the erased local variable falls back to the one of the parent
+  ss.EraseVars({"a"});
+  EXPECT_EQ(a, ss.FindVarById(id_a));
+
+  ss.Rename("b", "c");
+  EXPECT_EQ(nullptr, ss.FindVarById(id_b));
+  EXPECT_EQ(b, ss.FindVarById(ss.InternVar("c")));
+
+  // the slots follow the erasure and recreation in the ancestors
+  version = ss.VarSlotsVersion();
+  s.EraseVars({"a"});
+  EXPECT_EQ(nullptr, ss.FindVarById(id_a));
+  EXPECT_GT(ss.VarSlotsVersion(), version);
+  Variable* new_a = s.Var("a");
+  EXPECT_EQ(new_a, ss.FindVarById(id_a));
+  Variable* d = s.Var("d");
+  Scope& sss = ss.NewScope();
+  size_t id_d = sss.InternVar("d");
+  EXPECT_EQ(d, sss.FindVarById(id_d));
+  s.Rename("d", "e");
+  EXPECT_EQ(nullptr, sss.FindVarById(id_d));
+  Variable* local_d = ss.Var("d");
+  EXPECT_EQ(local_d, sss.FindVarById(id_d));
+}
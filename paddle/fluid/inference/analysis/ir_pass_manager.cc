@@ -14,6 +14,8 @@
 
 #include "paddle/fluid/inference/analysis/ir_pass_manager.h"
 
+#include <algorithm>
+#include <chrono>  // NOLINT
 #include <map>
 #include <memory>
 #include <string>
@@ -40,14 +42,48 @@ IRPassManager::IRPassManager(Argument *argument) {
   disable_logs_ = argument->disable_logs();
 
   ARGUMENT_CHECK_FIELD(argument, ir_analysis_passes);
+  LoadCostDecisions(argument);
   CreatePasses(argument, argument->ir_analysis_passes());
 }
 
+// The decisions file set by the user wins, and is copied to the optim cache
+// dir so the optimized model keeps it; without one, the copy is reused.
+void IRPassManager::LoadCostDecisions(Argument *argument) {
+  std::string cache_dir =
+      argument->Has("optim_cache_dir") ? argument->optim_cache_dir() : "";
+  std::string cached_file =
+      cache_dir.empty() ? "" : cache_dir + "/cost_decisions.txt";
+  std::string file = argument->Has("cost_decisions_file")
+                         ? argument->cost_decisions_file()
+                         : "";
+  if (!file.empty()) {
+    PADDLE_ENFORCE_EQ(
+        cost_decisions_.Load(file),
+        true,
+        platform::errors::NotFound("Can not read the cost decisions file %s.",
+                                   file));
+    if (!cached_file.empty() && cached_file != file) {
+      MakeDirIfNotExists(cache_dir);
+      cost_decisions_.Save(cached_file);
+    }
+  } else if (!cached_file.empty() && FileExists(cached_file)) {
+    cost_decisions_.Load(cached_file);
+  }
+}
+
 void IRPassManager::CreatePasses(Argument *argument,
                                  const std::vector<std::string> &passes) {
   std::string pre_pass;
   int pass_num = 0;
   for (const std::string &pass_name : passes) {
+    if (cost_decisions_.IsPassDisabled(pass_name)) {
+      if (!disable_logs_) {
+        PrettyLogEndl(Style::H2(),
+                      "--- Skip IR pass [%s] by cost decisions",
+                      pass_name);
+      }
+      continue;
+    }
     auto pass = framework::ir::PassRegistry::Instance().Get(pass_name);
     pass->Set("use_varseqlen", new bool(argument->tensorrt_use_varseqlen()));
     pass->Set("with_interleaved",
@@ -114,6 +150,9 @@ void IRPassManager::CreatePasses(Argument *argument,
       pass->Set("mkldnn_enabled_op_types",
                 new std::unordered_set<std::string>(
                     argument->mkldnn_enabled_op_types()));
+      pass->Set("mkldnn_excluded_op_types",
+                new std::unordered_set<std::string>(
+                    cost_decisions_.native_kernel_op_types()));
     } else if (pass_name == "cudnn_placement_pass") {
       pass->Set("cudnn_enabled_op_types",
                 new std::unordered_set<std::string>());
@@ -297,15 +336,80 @@ void IRPassManager::CreatePasses(Argument *argument,
   }
 }
 
+// The number of subgraphs a fuse pass reported by AddStatis, i.e. the
+// entries of the fuse statistics it added or changed.
+static int CountMatched(const std::unordered_map<std::string, int> &before,
+                        const Graph &graph) {
+  if (!graph.Has(framework::ir::kFuseStatisAttr)) return 0;
+  int matched = 0;
+  for (auto &item : graph.Get<std::unordered_map<std::string, int>>(
+           framework::ir::kFuseStatisAttr)) {
+    auto it = before.find(item.first);
+    if (it == before.end() || it->second != item.second) {
+      matched += item.second;
+    }
+  }
+  return matched;
+}
+
 std::unique_ptr<Graph> IRPassManager::Apply(std::unique_ptr<Graph> graph) {
   PADDLE_ENFORCE_NOT_NULL(
       graph.get(), platform::errors::InvalidArgument("Graph cannot be null."));
+  struct PassCost {
+    std::string type;
+    double ms;
+    int matched;
+  };
+  std::vector<PassCost> pass_costs;
+  double total_ms = 0;
+  size_t num_skipped = 0;
   // Apply all the passes
   for (const auto &pass : passes_) {
+    if (!pass->HasAnchorOps(*graph)) {
+      VLOG(3) << "Skip IR pass [" << pass->Type()
+              << "], the graph has none of its anchor ops";
+      ++num_skipped;
+      continue;
+    }
     if (pass->Type() != "graph_viz_pass" && !disable_logs_) {
       PrettyLogEndl(Style::H2(), "--- Running IR pass [%s]", pass->Type());
     }
+    std::unordered_map<std::string, int> statis_before;
+    if (graph->Has(framework::ir::kFuseStatisAttr)) {
+      statis_before = graph->Get<std::unordered_map<std::string, int>>(
+          framework::ir::kFuseStatisAttr);
+    }
+    auto start = std::chrono::steady_clock::now();
     graph.reset(pass->Apply(graph.release()));
+    std::chrono::duration<double, std::milli> cost =
+        std::chrono::steady_clock::now() - start;
+    int matched = CountMatched(statis_before, *graph);
+    VLOG(3) << "IR pass [" << pass->Type() << "] takes " << cost.count()
+            << " ms, matched " << matched << " subgraphs";
+    pass_costs.push_back({pass->Type(), cost.count(), matched});
+    total_ms += cost.count();
+  }
+  if (!disable_logs_ && !pass_costs.empty()) {
+    // The slowest passes first, to tell where the optimization time goes.
+    std::stable_sort(pass_costs.begin(),
+                     pass_costs.end(),
+                     [](const PassCost &a, const PassCost &b) {
+                       return a.ms > b.ms;
+                     });
+    PrettyLogEndl(Style::H2(),
+                  "--- %d IR passes take %.3f ms in total, %d skipped for "
+                  "lack of anchor ops, the slowest are:",
+                  pass_costs.size(),
+                  total_ms,
+                  num_skipped);
+    const size_t kShownPasses = 10;
+    for (size_t i = 0; i < std::min(kShownPasses, pass_costs.size()); ++i) {
+      PrettyLogEndl(Style::H2(),
+                    "      %s: %.3f ms, %d matched",
+                    pass_costs[i].type,
+                    pass_costs[i].ms,
+                    pass_costs[i].matched);
+    }
   }
   return graph;
 }
@@ -28,6 +28,7 @@
 #include <utility>
 #include <vector>
 
+#include "paddle/fluid/framework/ir/cost_model.h"
 #include "paddle/fluid/framework/ir/graph.h"
 #include "paddle/fluid/framework/ir/pass.h"
 #include "paddle/fluid/framework/program_desc.h"
@@ -50,8 +51,10 @@ class IRPassManager final {
 
  private:
   void CreatePasses(Argument *argument, const std::vector<std::string> &passes);
+  void LoadCostDecisions(Argument *argument);
 
   std::vector<std::unique_ptr<Pass>> passes_;
+  framework::CostDecisions cost_decisions_;
   bool disable_logs_{false};
 };
 
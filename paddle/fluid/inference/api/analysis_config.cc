@@ -373,6 +373,7 @@ AnalysisConfig::AnalysisConfig(const AnalysisConfig &other) {
                                   // params_file_ fields.
 
   CP_MEMBER(opt_cache_dir_);
+  CP_MEMBER(cost_decisions_file_);
   CP_MEMBER(prog_file_);
   CP_MEMBER(params_file_);
   CP_MEMBER(calibration_file_path_);
@@ -965,6 +966,7 @@ std::string AnalysisConfig::SerializeInfoCache() {
   ss << params_file_;
 
   ss << calibration_file_path_;
+  ss << cost_decisions_file_;
 
   ss << use_gpu_;
   ss << enable_gpu_mixed_;
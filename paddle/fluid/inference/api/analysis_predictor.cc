@@ -1071,6 +1071,7 @@ void AnalysisPredictor::PrepareArgument() {
   // Analyze inference_program
   argument_.SetPredictorID(predictor_id_);
   argument_.SetOptimCacheDir(config_.opt_cache_dir_);
+  argument_.SetCostDecisionsFile(config_.cost_decisions_file_);
   if (!config_.model_dir().empty()) {
     argument_.SetModelDir(config_.model_dir());
   } else {
@@ -208,6 +208,26 @@ struct PD_INFER_DECL AnalysisConfig {
     opt_cache_dir_ = opt_cache_dir;
   }
   ///
+  /// \brief Set the file of the decisions taken by a cost calibration
+  /// (framework::CostModel::Calibrate). The fuse passes it disabled are
+  /// skipped and the op types it marked native do not use oneDNN. The
+  /// decisions are also saved to the optimization cache directory if one is
+  /// set, and read back from there when no file is given.
+  ///
+  /// \param path the path of the cost decisions file.
+  ///
+  void SetCostDecisionsFile(const std::string& path) {
+    cost_decisions_file_ = path;
+  }
+  ///
+  /// \brief Get the file of the cost decisions.
+  ///
+  /// \return const std::string& The cost decisions file.
+  ///
+  const std::string& cost_decisions_file() const {
+    return cost_decisions_file_;
+  }
+  ///
   /// \brief Get the model directory path.
   ///
   /// \return const std::string& The model directory path.
@@ -1178,6 +1198,7 @@ struct PD_INFER_DECL AnalysisConfig {
   // So we release the memory when the predictor is set up.
   mutable bool is_valid_{true};
   std::string opt_cache_dir_;
+  std::string cost_decisions_file_;
   friend class paddle_infer::experimental::InternalUtils;
 
   // fleet exe related
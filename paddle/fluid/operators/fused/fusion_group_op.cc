@@ -78,6 +78,10 @@ class FusionGroupOp : public framework::OperatorWithKernel {
  protected:
   framework::OpKernelType GetExpectedKernelType(
       const framework::ExecutionContext& ctx) const override {
+    if (platform::is_cpu_place(ctx.GetPlace())) {
+      return framework::OpKernelType(framework::proto::VarType::FP32,
+                                     ctx.GetPlace());
+    }
     return framework::OpKernelType(framework::proto::VarType::FP32,
                                    platform::CUDAPlace(0));
   };
@@ -117,3 +121,6 @@ multiple operators into one. It supports several types:
 
 namespace ops = paddle::operators;
 REGISTER_OPERATOR(fusion_group, ops::FusionGroupOp, ops::FusionGroupOpMaker);
+REGISTER_OP_CPU_KERNEL(fusion_group,
+                       ops::FusionGroupKernel<phi::CPUContext, float>,
+                       ops::FusionGroupKernel<phi::CPUContext, double>);
@@ -0,0 +1,98 @@
+/* Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "paddle/fluid/operators/jit/autotune.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+#include "paddle/fluid/operators/jit/helper.h"
+
+DECLARE_bool(jit_kernel_autotune);
+DECLARE_string(jit_kernel_autotune_cache_file);
+
+namespace paddle {
+namespace operators {
+namespace jit {
+
+AutoTuneCache& AutoTuneCache::Instance() {
+  static AutoTuneCache g_autotune_cache;
+  return g_autotune_cache;
+}
+
+bool AutoTuneCache::Enabled() { return FLAGS_jit_kernel_autotune; }
+
+std::string AutoTuneCache::Key(KernelType type,
+                               size_t data_size,
+                               int64_t attr_key) {
+  std::ostringstream os;
+  os << to_string(type) << ":" << data_size << ":" << attr_key;
+  return os.str();
+}
+
+AutoTuneCache::AutoTuneCache() : path_(FLAGS_jit_kernel_autotune_cache_file) {
+  Load();
+}
+
+// one choice per line: "<key> <impl type>", a later line of the same key wins
+void AutoTuneCache::Load() {
+  if (path_.empty()) {
+    return;
+  }
+  std::ifstream fin(path_);
+  if (!fin.is_open()) {
+    VLOG(3) << "No jit autotune cache at " << path_ << ", start empty.";
+    return;
+  }
+  std::string line;
+  while (std::getline(fin, line)) {
+    std::istringstream is(line);
+    std::string key, impl;
+    if (is >> key >> impl) {
+      choices_[key] = impl;
+    }
+  }
+  VLOG(3) << "Loaded " << choices_.size() << " jit autotune choices from "
+          << path_;
+}
+
+std::string AutoTuneCache::Get(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = choices_.find(key);
+  return iter != choices_.end() ? iter->second : std::string();
+}
+
+void AutoTuneCache::Set(const std::string& key, const std::string& impl) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = choices_.find(key);
+  if (iter != choices_.end() && iter->second == impl) {
+    return;
+  }
+  choices_[key] = impl;
+  if (path_.empty()) {
+    return;
+  }
+  std::ofstream fout(path_, std::ios::app);
+  if (!fout.is_open()) {
+    LOG(WARNING) << "Can not write the jit autotune cache " << path_;
+    return;
+  }
+  fout << key << " " << impl << "\n";
+}
+
+}  // namespace jit
+}  // namespace operators
+}  // namespace paddle
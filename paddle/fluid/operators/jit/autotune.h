@@ -0,0 +1,134 @@
+/* Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <mutex>   // NOLINT
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/fluid/operators/jit/kernel_base.h"
+#include "paddle/fluid/platform/macros.h"
+
+namespace paddle {
+namespace operators {
+namespace jit {
+
+// The implementation picked by timing for every (kernel type, data type,
+// attr) seen so far, shared by all threads. With
+// FLAGS_jit_kernel_autotune_cache_file set, the choices of former runs are
+// read from that file on first use and every new choice is appended to it.
+class AutoTuneCache {
+ public:
+  static AutoTuneCache& Instance();
+  // FLAGS_jit_kernel_autotune
+  static bool Enabled();
+  static std::string Key(KernelType type, size_t data_size, int64_t attr_key);
+
+  // the ImplType of the chosen kernel, empty if the key is not tuned yet
+  std::string Get(const std::string& key);
+  void Set(const std::string& key, const std::string& impl);
+
+ private:
+  AutoTuneCache();
+  void Load();
+
+  std::mutex mutex_;
+  std::string path_;
+  std::unordered_map<std::string, std::string> choices_;
+
+  DISABLE_COPY_AND_ASSIGN(AutoTuneCache);
+};
+
+namespace autotune {
+
+// elements processed per candidate while timing, whatever the size
+constexpr int kTimedElements = 1 << 16;
+constexpr int kWarmupRepeat = 3;
+constexpr int kMinRepeat = 10;
+
+// Returns the average time in microseconds of one call of run.
+template <typename Callable>
+double TimeRuns(Callable run, int d) {
+  int repeat = std::max(kMinRepeat, kTimedElements / std::max(d, 1));
+  for (int i = 0; i < kWarmupRepeat; ++i) {
+    run();
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; ++i) {
+    run();
+  }
+  std::chrono::duration<double, std::micro> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / repeat;
+}
+
+template <typename T>
+std::vector<T> MakeInput(int d) {
+  std::vector<T> x(d);
+  for (int i = 0; i < d; ++i) {
+    x[i] = static_cast<T>((i % 17) * 0.125 - 1.0);
+  }
+  return x;
+}
+
+// Kernels are timed only when their arguments can be made up from the attr
+// alone, which holds for the element-wise kernels sized by d. The others
+// return a negative time and keep the default choice.
+template <typename Func, typename Attr>
+double TimeFunc(Func func, const Attr& attr) {
+  return -1;
+}
+
+// XYZN and AXYN kernels
+template <typename T>
+double TimeFunc(void (*func)(const T*, const T*, T*, int), const int& d) {
+  if (d <= 0) {
+    return -1;
+  }
+  auto x = MakeInput<T>(d);
+  auto y = MakeInput<T>(d);
+  std::vector<T> z(d);
+  return TimeRuns([&]() { func(x.data(), y.data(), z.data(), d); }, d);
+}
+
+// XYN and XRN kernels
+template <typename T>
+double TimeFunc(void (*func)(const T*, T*, int), const int& d) {
+  if (d <= 0) {
+    return -1;
+  }
+  auto x = MakeInput<T>(d);
+  std::vector<T> y(d);
+  return TimeRuns([&]() { func(x.data(), y.data(), d); }, d);
+}
+
+// Softmax, timed on one row
+template <typename T>
+double TimeFunc(void (*func)(const T*, T*, int, int, int), const int& d) {
+  if (d <= 0) {
+    return -1;
+  }
+  auto x = MakeInput<T>(d);
+  std::vector<T> y(d);
+  return TimeRuns([&]() { func(x.data(), y.data(), d, 1, 1); }, d);
+}
+
+}  // namespace autotune
+}  // namespace jit
+}  // namespace operators
+}  // namespace paddle
@@ -14,6 +14,7 @@
 
 #include "paddle/fluid/operators/jit/gen/act.h"
 
+#include "paddle/fluid/operators/jit/macro.h"
 #include "paddle/fluid/operators/jit/registry.h"
 #include "paddle/fluid/platform/cpu_info.h"
 
@@ -46,6 +47,25 @@ int ALIGN32_BEG g_tmp_mem[16] ALIGN32_END = {0};
 
 void VActJitCode::genCode() {
   int offset = 0;
+  if (platform::MayIUse(platform::avx512f)) {
+    for (int i = 0; i < num_ / ZMM_FLOAT_BLOCK; ++i) {
+      vmovups(zmm_src, ptr[param1 + offset]);
+      act_zmm(zmm_dst, zmm_src, type_);
+      vmovups(ptr[param2 + offset], zmm_dst);
+      offset += sizeof(float) * ZMM_FLOAT_BLOCK;
+    }
+    int rest = num_ % ZMM_FLOAT_BLOCK;
+    if (rest > 0) {
+      // the masked lanes are zero, which every activation here accepts
+      mov(eax, (1 << rest) - 1);
+      kmovw(k1, eax);
+      vmovups(zmm_src | k1 | T_z, ptr[param1 + offset]);
+      act_zmm(zmm_dst, zmm_src, type_);
+      vmovups(ptr[param2 + offset] | k1, zmm_dst);
+    }
+    ret();
+    return;
+  }
   for (int i = 0; i < num_ / YMM_FLOAT_BLOCK; ++i) {
     vmovups(ymm_src, ptr[param1 + offset]);
     act<ymm_t>(ymm_dst, ymm_src, type_);
@@ -242,6 +242,139 @@ class VActFunc : public JitCode {
     // dst.setIdx(src.getIdx());
   }
 
+  // compute EXP with zmm, the constants are broadcast from exp_float_consts
+  // and vrndscaleps gives the floor directly
+  void exp_zmm(zmm_t& dst,  // NOLINT
+               zmm_t& src,
+               int src_idx = 11,
+               int fx_idx = 12,
+               int fy_idx = 13,
+               int mask_idx = 14,
+               int tmp_idx = 15) {
+    zmm_t zmm_src = zmm_t(src_idx);
+    zmm_t zmm_fx = zmm_t(fx_idx);
+    zmm_t zmm_fy = zmm_t(fy_idx);
+    zmm_t zmm_z = zmm_t(mask_idx);
+    reg64_t reg_ptr_global = rax;
+    push(reg_ptr_global);
+    vmovaps(zmm_src, src);
+    mov(reg_ptr_global, reinterpret_cast<size_t>(exp_float_consts));
+    vminps(zmm_src, zmm_src, zword_b[reg_ptr_global + OFFSET_EXP_HIG]);
+    vmaxps(zmm_src, zmm_src, zword_b[reg_ptr_global + OFFSET_EXP_LOW]);
+    // express exp(x) as exp(g + n*log(2))
+    vmulps(zmm_fx, zmm_src, zword_b[reg_ptr_global + OFFSET_EXP_LOG2EF]);
+    vaddps(zmm_fx, zmm_fx, zword_b[reg_ptr_global + OFFSET_EXP_0P5]);
+    vrndscaleps(zmm_fx, zmm_fx, 0x01);
+    vmulps(zmm_fy, zmm_fx, zword_b[reg_ptr_global + OFFSET_EXP_C1]);
+    vmulps(zmm_z, zmm_fx, zword_b[reg_ptr_global + OFFSET_EXP_C2]);
+    vsubps(zmm_src, zmm_src, zmm_fy);
+    vsubps(zmm_src, zmm_src, zmm_z);
+    vmulps(zmm_z, zmm_src, zmm_src);
+    vmulps(dst, zmm_src, zword_b[reg_ptr_global + OFFSET_EXP_P0]);
+    for (size_t i = OFFSET_EXP_P1; i < OFFSET_EXP_P5;
+         i += (YMM_FLOAT_BLOCK * sizeof(float))) {
+      vaddps(dst, dst, zword_b[reg_ptr_global + i]);  // P1~P4
+      vmulps(dst, dst, zmm_src);
+    }
+    vaddps(dst, dst, zword_b[reg_ptr_global + OFFSET_EXP_P5]);
+    vmulps(dst, dst, zmm_z);
+    vaddps(dst, dst, zmm_src);
+    vaddps(dst, dst, zword_b[reg_ptr_global + OFFSET_EXP_ONE]);
+    // build 2^n
+    zmm_t zmm_int = zmm_fx;
+    vcvttps2dq(zmm_int, zmm_fx);
+    mov(reg_ptr_global, reinterpret_cast<size_t>(exp_int_0x7f));
+    vpaddd(zmm_int, zmm_int, zword_b[reg_ptr_global]);
+    vpslld(zmm_int, zmm_int, 23);
+    vmulps(dst, dst, zmm_int);
+    pop(reg_ptr_global);
+  }
+
+  // compute SIGMOID with zmm
+  void sigmoid_zmm(zmm_t& dst,  // NOLINT
+                   zmm_t& src,
+                   int src_idx = 11,
+                   int fx_idx = 12,
+                   int fy_idx = 13,
+                   int mask_idx = 14,
+                   int tmp_idx = 15) {
+    // y = 1 / (1 + e^-x)
+    zmm_t zmm_tmp = zmm_t(tmp_idx);
+    zmm_t zmm_src = zmm_t(src_idx);
+    reg64_t reg_ptr_global = rax;
+    push(reg_ptr_global);
+    vmovaps(zmm_src, src);
+    mov(reg_ptr_global, reinterpret_cast<size_t>(exp_float_consts));
+    vminps(zmm_src, zmm_src, zword_b[reg_ptr_global + OFFSET_SIGMOID_MAX]);
+    vmaxps(zmm_src, zmm_src, zword_b[reg_ptr_global + OFFSET_SIGMOID_MIN]);
+    vpxord(zmm_tmp, zmm_tmp, zmm_tmp);
+    vsubps(zmm_src, zmm_tmp, zmm_src);
+    exp_zmm(dst, zmm_src, src_idx, fx_idx, fy_idx, mask_idx, tmp_idx);
+    vbroadcastss(zmm_tmp, ptr[reg_ptr_global + OFFSET_EXP_ONE]);
+    vaddps(dst, dst, zmm_tmp);
+    vdivps(dst, zmm_tmp, dst);
+    pop(reg_ptr_global);
+  }
+
+  // compute TANH with zmm
+  void tanh_zmm(zmm_t& dst,  // NOLINT
+                zmm_t& src,
+                int src_idx = 11,
+                int fx_idx = 12,
+                int fy_idx = 13,
+                int mask_idx = 14,
+                int tmp_idx = 15) {
+    // y = 2 / (1 + e^(-2x)) - 1
+    zmm_t zmm_src = zmm_t(src_idx);
+    zmm_t zmm_tmp = zmm_t(tmp_idx);
+    zmm_t zmm_zero = zmm_t(mask_idx);
+    reg64_t reg_ptr_global = rax;
+    push(reg_ptr_global);
+    vmovaps(zmm_src, src);
+    mov(reg_ptr_global, reinterpret_cast<size_t>(exp_float_consts));
+    vbroadcastss(zmm_tmp, ptr[reg_ptr_global + OFFSET_EXP_TWO]);
+    vpxord(zmm_zero, zmm_zero, zmm_zero);
+    vsubps(zmm_tmp, zmm_zero, zmm_tmp);
+    vmulps(zmm_src, zmm_src, zmm_tmp);
+    exp_zmm(dst, zmm_src, src_idx, fx_idx, fy_idx, mask_idx, tmp_idx);
+    vaddps(dst, dst, zword_b[reg_ptr_global + OFFSET_EXP_ONE]);
+    vbroadcastss(zmm_tmp, ptr[reg_ptr_global + OFFSET_EXP_TWO]);
+    vdivps(dst, zmm_tmp, dst);
+    vsubps(dst, dst, zword_b[reg_ptr_global + OFFSET_EXP_ONE]);
+    pop(reg_ptr_global);
+  }
+
+  // same as act but with zmm, uses 11~15 as well
+  void act_zmm(zmm_t& dst, zmm_t& src, operand_type type) {  // NOLINT
+    switch (type) {
+      case operand_type::RELU: {
+        zmm_t zero = zmm_t(15);
+        vpxord(zero, zero, zero);
+        vmaxps(dst, src, zero);
+        break;
+      }
+      case operand_type::SQUARE:
+        vmulps(dst, src, src);
+        break;
+      case operand_type::EXP:
+        exp_zmm(dst, src, 11, 12, 13, 14, 15);
+        break;
+      case operand_type::SIGMOID:
+        sigmoid_zmm(dst, src, 11, 12, 13, 14, 15);
+        break;
+      case operand_type::TANH:
+        tanh_zmm(dst, src, 11, 12, 13, 14, 15);
+        break;
+      case operand_type::IDENTITY:
+        vmovaps(dst, src);
+        break;
+      default:
+        PADDLE_THROW(platform::errors::Unimplemented(
+            "Do not support operand type code: %d.", type));
+        break;
+    }
+  }
+
   template <typename JMM>
   void act(JMM& dst, JMM& src, operand_type type) {  // NOLINT
     // use 11~15
@@ -327,6 +460,9 @@ class VActJitCode : public VActFunc {
 
   xmm_t xmm_dst = xmm_t(1);
   ymm_t ymm_dst = ymm_t(1);
+
+  zmm_t zmm_src = zmm_t(0);
+  zmm_t zmm_dst = zmm_t(1);
 };
 
 #define DECLARE_ACT_JITCODE(name, op_type)                                    \
@@ -24,6 +24,10 @@ namespace jit {
 namespace gen {
 
 void VXXJitCode::genCode() {
+  if (platform::MayIUse(platform::avx512f)) {
+    genCodeZmm();
+    return;
+  }
   // do not need push stack, and do not need save avx512reg if do not use avx512
   int offset = 0;
   if (with_relu_) {
@@ -111,6 +115,57 @@ void VXXJitCode::genCode() {
   ret();
 }
 
+// 16 floats per step, the rest is done with one masked step instead of the
+// 4/2/1 xmm tail.
+void VXXJitCode::genCodeZmm() {
+  int offset = 0;
+  if (with_relu_) {
+    vpxord(zmm_zero, zmm_zero, zmm_zero);
+  }
+  if (scalar_index_ == 1) {
+    vbroadcastss(zmm_src1, ptr[param1]);
+  } else if (scalar_index_ == 2) {
+    vbroadcastss(zmm_src2, ptr[param2]);
+  }
+  auto compute = [&]() {
+    if (type_ == operand_type::MUL) {
+      vmulps(zmm_dst, zmm_src1, zmm_src2);
+    } else if (type_ == operand_type::ADD) {
+      vaddps(zmm_dst, zmm_src1, zmm_src2);
+    } else if (type_ == operand_type::SUB) {
+      vsubps(zmm_dst, zmm_src1, zmm_src2);
+    }
+    if (with_relu_) {
+      vmaxps(zmm_dst, zmm_zero, zmm_dst);
+    }
+  };
+  for (int i = 0; i < num_ / ZMM_FLOAT_BLOCK; ++i) {
+    if (scalar_index_ != 1) {
+      vmovups(zmm_src1, ptr[param1 + offset]);
+    }
+    if (scalar_index_ != 2) {
+      vmovups(zmm_src2, ptr[param2 + offset]);
+    }
+    compute();
+    vmovups(ptr[param3 + offset], zmm_dst);
+    offset += sizeof(float) * ZMM_FLOAT_BLOCK;
+  }
+  int rest = num_ % ZMM_FLOAT_BLOCK;
+  if (rest > 0) {
+    mov(eax, (1 << rest) - 1);
+    kmovw(k1, eax);
+    if (scalar_index_ != 1) {
+      vmovups(zmm_src1 | k1 | T_z, ptr[param1 + offset]);
+    }
+    if (scalar_index_ != 2) {
+      vmovups(zmm_src2 | k1 | T_z, ptr[param2 + offset]);
+    }
+    compute();
+    vmovups(ptr[param3 + offset] | k1, zmm_dst);
+  }
+  ret();
+}
+
 void NCHW16CMulNCJitCode::genCode() {
   // RDI is ptr x_input
   // RSI is ptr y_input
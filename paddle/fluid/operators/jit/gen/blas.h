@@ -73,6 +73,8 @@ class VXXJitCode : public JitCode {
   void genCode() override;
 
  private:
+  void genCodeZmm();
+
   int num_;
   operand_type type_;
   int scalar_index_;
@@ -90,6 +92,11 @@ class VXXJitCode : public JitCode {
   ymm_t ymm_src2 = ymm_t(1);
   ymm_t ymm_dst = ymm_t(2);
   ymm_t ymm_zero = ymm_t(3);
+
+  zmm_t zmm_src1 = zmm_t(0);
+  zmm_t zmm_src2 = zmm_t(1);
+  zmm_t zmm_dst = zmm_t(2);
+  zmm_t zmm_zero = zmm_t(3);
 };
 
 #define DECLARE_BLAS_JITCODE(name, op_type, scalar_idx, with_relu)             \
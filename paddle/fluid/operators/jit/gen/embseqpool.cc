@@ -27,8 +27,17 @@ namespace gen {
 
 void EmbSeqPoolJitCode::genCode() {
   preCode();
-  constexpr int block = YMM_FLOAT_BLOCK;
-  constexpr int max_num_regs = 8;
+  if (platform::MayIUse(platform::avx512f) && tbl_w_ % ZMM_FLOAT_BLOCK == 0) {
+    // 32 zmm registers: 16 to load and 16 to accumulate
+    genCodeWith<zmm_t>(ZMM_FLOAT_BLOCK, 16);
+  } else {
+    genCodeWith<ymm_t>(YMM_FLOAT_BLOCK, 8);
+  }
+  postCode();
+}
+
+template <typename reg_t>
+void EmbSeqPoolJitCode::genCodeWith(const int block, const int max_num_regs) {
   const int num_block = tbl_w_ / block;
   const int num_groups = num_block / max_num_regs;
   const size_t block_size = sizeof(float) * block;
@@ -67,7 +76,7 @@ void EmbSeqPoolJitCode::genCode() {
       add(reg_ptr_tbl_i, param_tbl);  // reg is ptr_i now
       size_t w_offset = 0;
       for (int reg_i = 0; reg_i < num_regs; ++reg_i) {
-        vmovups(ymm_t(reg_i + num_regs), ptr[reg_ptr_tbl_i + w_offset]);
+        vmovups(reg_t(reg_i + num_regs), ptr[reg_ptr_tbl_i + w_offset]);
         w_offset += block_size;
       }
       add(reg_ptr_idx_i, reg_idx_width_in_byte);
@@ -92,9 +101,9 @@ void EmbSeqPoolJitCode::genCode() {
         add(reg_ptr_tbl_i, param_tbl);
         size_t w_offset = 0;
         for (int reg_i = 0; reg_i < num_regs; ++reg_i) {
-          vmovups(ymm_t(reg_i), ptr[reg_ptr_tbl_i + w_offset]);
+          vmovups(reg_t(reg_i), ptr[reg_ptr_tbl_i + w_offset]);
           vaddps(
-              ymm_t(reg_i + num_regs), ymm_t(reg_i + num_regs), ymm_t(reg_i));
+              reg_t(reg_i + num_regs), reg_t(reg_i + num_regs), reg_t(reg_i));
           w_offset += block_size;
         }
         add(reg_ptr_idx_i, reg_idx_width_in_byte);
@@ -105,7 +114,7 @@ void EmbSeqPoolJitCode::genCode() {
       // avg or sqrt here, if needed
       w_offset = 0;
       for (int reg_i = 0; reg_i < num_regs; ++reg_i) {
-        vmovups(ptr[reg_ptr_dst_i + w_offset], ymm_t(reg_i + num_regs));
+        vmovups(ptr[reg_ptr_dst_i + w_offset], reg_t(reg_i + num_regs));
         w_offset += block_size;
       }
       add(reg_ptr_dst_i, tbl_width_in_byte);
@@ -117,7 +126,6 @@ void EmbSeqPoolJitCode::genCode() {
     acc_num_regs += num_regs;
     add(param_tbl, num_regs * block_size);  // do not use acc_num_regs
   }                                         // end of groups
-  postCode();
 }
 
 class EmbSeqPoolCreator : public JitCodeCreator<emb_seq_pool_attr_t> {
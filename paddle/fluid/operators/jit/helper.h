@@ -22,6 +22,8 @@
 #include <utility>  // for std::move
 #include <vector>
 
+#include "glog/logging.h"
+#include "paddle/fluid/operators/jit/autotune.h"
 #include "paddle/fluid/operators/jit/gen_base.h"
 #include "paddle/fluid/operators/jit/kernel_base.h"
 #include "paddle/fluid/operators/jit/kernel_key.h"
@@ -196,6 +198,53 @@ typename KernelTuple::func_type GetDefaultBestFunc(
   return funcs[0];
 }
 
+// Time every candidate and return the fastest one, the choice is kept in
+// AutoTuneCache so each (kernel, attr) is timed only once per process, or
+// never when it is found in the cache file.
+template <typename KernelTuple, typename PlaceType = platform::CPUPlace>
+typename KernelTuple::func_type GetAutoTunedBestFunc(
+    const typename KernelTuple::attr_type& attr) {
+  using Attr = typename KernelTuple::attr_type;
+  auto funcs = GetAllCandidateFuncsWithTypes<KernelTuple, PlaceType>(attr);
+  PADDLE_ENFORCE_GE(funcs.size(),
+                    1UL,
+                    platform::errors::InvalidArgument(
+                        "The candicate jit kernel is at least one in CPU."));
+  if (funcs.size() == 1) {
+    return funcs[0].second;
+  }
+  auto& cache = AutoTuneCache::Instance();
+  auto key = AutoTuneCache::Key(KernelTuple::kernel_type,
+                                sizeof(typename KernelTuple::data_type),
+                                JitCodeKey<Attr>(attr));
+  auto impl = cache.Get(key);
+  if (!impl.empty()) {
+    for (auto& f : funcs) {
+      if (f.first == impl) {
+        return f.second;
+      }
+    }
+  }
+
+  size_t best = 0;
+  double best_time = -1;
+  for (size_t i = 0; i < funcs.size(); ++i) {
+    double t = autotune::TimeFunc(funcs[i].second, attr);
+    if (t < 0) {
+      // can not be timed, keep the search order
+      return funcs[0].second;
+    }
+    VLOG(4) << key << " " << funcs[i].first << ": " << t << " us";
+    if (best_time < 0 || t < best_time) {
+      best = i;
+      best_time = t;
+    }
+  }
+  VLOG(3) << "Autotuned jit kernel " << key << " to " << funcs[best].first;
+  cache.Set(key, funcs[best].first);
+  return funcs[best].second;
+}
+
 extern std::map<size_t, std::shared_ptr<void>>& GetFuncCacheMap();
 
 template <typename KernelTuple, typename PlaceType>
@@ -225,7 +274,9 @@ class KernelFuncs {
       return funcs_.at(key);
     }
     // If do not have this attr in cache then get the default best
-    auto func = GetDefaultBestFunc<KernelTuple, PlaceType>(attr);
+    auto func = AutoTuneCache::Enabled()
+                    ? GetAutoTunedBestFunc<KernelTuple, PlaceType>(attr)
+                    : GetDefaultBestFunc<KernelTuple, PlaceType>(attr);
     Insert(key, func);
     return func;
   }
@@ -24,6 +24,86 @@ namespace operators {
 namespace jit {
 namespace more {
 namespace intrinsic {
+// Note: intrinsic code is not runtime build, the AVX512 path is only taken
+// when the code is built with AVX512F.
+
+#ifdef __AVX512F__
+// 16 floats per step, the rest of a row is done with one masked step.
+static void LayerNormZmm(float* x,
+                         float* out,
+                         float* mean,
+                         float* var,
+                         const float* scale,
+                         const float* bias,
+                         int height,
+                         const float epsilon,
+                         int right) {
+  constexpr int block = ZMM_FLOAT_BLOCK;
+  const int rest = right % block;
+  const int end = right - rest;
+  const __mmask16 rest_mask = static_cast<__mmask16>((1 << rest) - 1);
+  const float reverse_num = 1.0f / right;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < height; ++i) {
+    const float* x_i = x + static_cast<size_t>(i) * right;
+    float* out_i = out + static_cast<size_t>(i) * right;
+
+    /* get mean */
+    __m512 sum = _mm512_setzero_ps();
+    for (int j = 0; j < end; j += block) {
+      sum = _mm512_add_ps(sum, _mm512_loadu_ps(x_i + j));
+    }
+    if (rest != 0) {
+      sum = _mm512_add_ps(sum, _mm512_maskz_loadu_ps(rest_mask, x_i + end));
+    }
+    mean[i] = _mm512_reduce_add_ps(sum) * reverse_num;
+    __m512 mean_vec = _mm512_set1_ps(mean[i]);
+
+    /* get variance */
+    sum = _mm512_setzero_ps();
+    __m512 tmp;
+    for (int j = 0; j < end; j += block) {
+      tmp = _mm512_sub_ps(_mm512_loadu_ps(x_i + j), mean_vec);
+      sum = _mm512_fmadd_ps(tmp, tmp, sum);
+    }
+    if (rest != 0) {
+      tmp = _mm512_maskz_sub_ps(
+          rest_mask, _mm512_maskz_loadu_ps(rest_mask, x_i + end), mean_vec);
+      sum = _mm512_fmadd_ps(tmp, tmp, sum);
+    }
+    var[i] = _mm512_reduce_add_ps(sum) * reverse_num;
+    __m512 std_vec = _mm512_sqrt_ps(_mm512_set1_ps(var[i] + epsilon));
+
+    /* get x_norm and calculate output*/
+    auto norm = [&](int j, __m512 x_vec) {
+      __m512 y = _mm512_div_ps(_mm512_sub_ps(x_vec, mean_vec), std_vec);
+      if (scale) {
+        y = _mm512_mul_ps(y, _mm512_loadu_ps(scale + j));
+      }
+      if (bias) {
+        y = _mm512_add_ps(y, _mm512_loadu_ps(bias + j));
+      }
+      return y;
+    };
+    for (int j = 0; j < end; j += block) {
+      _mm512_storeu_ps(out_i + j, norm(j, _mm512_loadu_ps(x_i + j)));
+    }
+    if (rest != 0) {
+      __m512 x_vec = _mm512_maskz_loadu_ps(rest_mask, x_i + end);
+      __m512 y = _mm512_div_ps(_mm512_sub_ps(x_vec, mean_vec), std_vec);
+      if (scale) {
+        y = _mm512_mul_ps(y, _mm512_maskz_loadu_ps(rest_mask, scale + end));
+      }
+      if (bias) {
+        y = _mm512_add_ps(y, _mm512_maskz_loadu_ps(rest_mask, bias + end));
+      }
+      _mm512_mask_storeu_ps(out_i + end, rest_mask, y);
+    }
+  }
+}
+#endif
 
 void LayerNorm(float* x,
                float* out,
@@ -34,6 +114,12 @@ void LayerNorm(float* x,
                int height,
                const float epsilon,
                int right) {
+#ifdef __AVX512F__
+  if (platform::MayIUse(platform::avx512f)) {
+    LayerNormZmm(x, out, mean, var, scale, bias, height, epsilon, right);
+    return;
+  }
+#endif
   int block = YMM_FLOAT_BLOCK;
   const int rest = right % block;
   const int end = right - rest;
@@ -1383,6 +1383,29 @@ TEST(JITKernel_helper, GetAllCandidateFuncs) {
   }
 }
 
+TEST(JITKernel_helper, GetAutoTunedBestFunc) {
+  for (int d : {7, 256}) {
+    std::vector<float> x(d), tgt(d), y(d);
+    RandomVec<float>(d, x.data());
+    auto ref = jit::GetReferFunc<jit::VSigmoidTuple<float>>();
+    ref(x.data(), tgt.data(), d);
+    auto best = jit::GetAutoTunedBestFunc<jit::VSigmoidTuple<float>>(d);
+    best(x.data(), y.data(), d);
+    ExpectEQ<float>(y.data(), tgt.data(), d);
+
+    auto key = jit::AutoTuneCache::Key(jit::kVSigmoid, sizeof(float), d);
+    auto impl = jit::AutoTuneCache::Instance().Get(key);
+    auto funcs =
+        jit::GetAllCandidateFuncsWithTypes<jit::VSigmoidTuple<float>>(d);
+    if (funcs.size() > 1) {
+      EXPECT_FALSE(impl.empty());
+      // the second time the choice comes from the cache
+      EXPECT_TRUE(jit::GetAutoTunedBestFunc<jit::VSigmoidTuple<float>>(d) ==
+                  best);
+    }
+  }
+}
+
 TEST(JITKernel_helper, pack_weights) {
   const int N = 8 * 60, K = 2;
   float src[K][N], yref[K][N], y[K * N];
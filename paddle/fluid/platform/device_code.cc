@@ -14,15 +14,21 @@ limitations under the License. */
 
 #include "paddle/fluid/platform/device_code.h"
 
+#include <dlfcn.h>
+#include <stdlib.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <fstream>
 #include <set>
 #include <utility>
 
 #include "paddle/fluid/platform/enforce.h"
 
 DECLARE_string(cuda_dir);
+DECLARE_string(fusion_group_cpu_compiler);
+DECLARE_string(fusion_group_cpu_compile_options);
 
 namespace paddle {
 namespace platform {
@@ -69,26 +75,133 @@ DeviceCodePool::DeviceCodePool(const std::vector<platform::Place>& places) {
                     errors::InvalidArgument(
                         "Expected the number of places >= 1. But received %d.",
                         places.size()));
+  AddPlaces(places);
+}
+
+void DeviceCodePool::AddPlaces(const std::vector<platform::Place>& places) {
   // Remove the duplicated places
   std::set<Place> set;
   for (auto& p : places) {
-    set.insert(p);
+    if (device_codes_.find(p) == device_codes_.end()) {
+      set.insert(p);
+    }
   }
   for (auto& p : set) {
     if (is_gpu_place(p)) {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
       device_codes_.emplace(p, DeviceCodeMap());
+      CUDADeviceCode::CheckAvailableStatus();
 #else
       PADDLE_THROW(platform::errors::PreconditionNotMet(
           "CUDAPlace or HIPPlace is not supported, please re-compile with "
           "WITH_GPU=ON or WITH_ROCM=ON."));
 #endif
+    } else if (is_cpu_place(p)) {
+      device_codes_.emplace(p, DeviceCodeMap());
+      CPUDeviceCode::CheckAvailableStatus();
     }
   }
+}
 
-#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
-  CUDADeviceCode::CheckAvailableStatus();
-#endif
+bool CPUDeviceCode::available_ = false;
+void CPUDeviceCode::CheckAvailableStatus() {
+  static bool checked = false;
+  if (checked) {
+    return;
+  }
+  checked = true;
+  std::string cmd = FLAGS_fusion_group_cpu_compiler + " --version > /dev/null";
+  available_ = system(cmd.c_str()) == 0;
+  if (!available_) {
+    LOG_FIRST_N(WARNING, 1)
+        << "Compiler " << FLAGS_fusion_group_cpu_compiler
+        << " is needed for JIT compiling of CPU code, please specify it by "
+           "export FLAGS_fusion_group_cpu_compiler=xxx.";
+  }
+}
+
+CPUDeviceCode::CPUDeviceCode(const Place& place,
+                             const std::string& name,
+                             const std::string& kernel) {
+  if (!is_cpu_place(place)) {
+    PADDLE_THROW(platform::errors::PermissionDenied(
+        "CPUDeviceCode can only launch on CPU place."));
+  }
+
+  place_ = place;
+  name_ = name;
+  kernel_ = kernel;
+}
+
+CPUDeviceCode::~CPUDeviceCode() {
+  if (handle_ != nullptr) {
+    dlclose(handle_);
+  }
+}
+
+bool CPUDeviceCode::Compile(bool include_path) {
+  is_compiled_ = false;
+  char dir_template[] = "/tmp/paddle_device_code_XXXXXX";
+  char* dir = mkdtemp(dir_template);
+  if (dir == nullptr) {
+    LOG(WARNING) << "Fail to create a temporary directory for < " << name_
+                 << " >.";
+    return false;
+  }
+  std::string src_path = std::string(dir) + "/" + name_ + ".cc";
+  std::string lib_path = std::string(dir) + "/" + name_ + ".so";
+  std::string log_path = std::string(dir) + "/" + name_ + ".log";
+  {
+    std::ofstream src(src_path);
+    src << kernel_;
+  }
+
+  // the options may name libraries, so they follow the source
+  std::string cmd = FLAGS_fusion_group_cpu_compiler + " -shared -fPIC -o " +
+                    lib_path + " " + src_path + " " +
+                    FLAGS_fusion_group_cpu_compile_options + " > " + log_path +
+                    " 2>&1";
+  bool compiled = system(cmd.c_str()) == 0;
+  if (compiled) {
+    handle_ = dlopen(lib_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  } else {
+    std::ifstream log_file(log_path);
+    std::string log((std::istreambuf_iterator<char>(log_file)),
+                    std::istreambuf_iterator<char>());
+    LOG(WARNING) << "JIT compiling of CPU code failed:"
+                 << "\n  Kernel name: " << name_ << "\n  Kernel body:\n"
+                 << kernel_ << "\n  Compiling log: " << log;
+  }
+  // The library stays mapped after its file is removed.
+  unlink(src_path.c_str());
+  unlink(lib_path.c_str());
+  unlink(log_path.c_str());
+  rmdir(dir);
+
+  if (!compiled) {
+    return false;
+  }
+  if (handle_ == nullptr) {
+    LOG(WARNING) << "Fail to load < " << name_ << " >: " << dlerror();
+    return false;
+  }
+  function_ = reinterpret_cast<KernelFunc>(dlsym(handle_, name_.c_str()));
+  if (function_ == nullptr) {
+    LOG(WARNING) << "Fail to find < " << name_ << " >: " << dlerror();
+    return false;
+  }
+  is_compiled_ = true;
+  return true;
+}
+
+void CPUDeviceCode::Launch(const size_t n, std::vector<void*>* args) const {
+  PADDLE_ENFORCE_EQ(
+      is_compiled_,
+      true,
+      errors::PreconditionNotMet(
+          "Please compile the code before launching the kernel."));
+  // args[0] is the address of n, the same as the CUDA kernels get
+  function_(static_cast<int>(n), args->data() + 1);
 }
 
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
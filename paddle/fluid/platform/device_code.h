@@ -89,6 +89,33 @@ class CUDADeviceCode : public DeviceCode {
 };
 #endif
 
+// Runtime compiled code for CPU. The kernel is C++ source, built into a
+// shared library by the host compiler (FLAGS_fusion_group_cpu_compiler) and
+// loaded with dlopen. The kernel function must be declared as
+//   extern "C" void name(int n, void** args);
+// where args[i] points to the i-th argument, the same as for CUDA kernels.
+class CPUDeviceCode : public DeviceCode {
+ public:
+  explicit CPUDeviceCode(const Place& place,
+                         const std::string& name,
+                         const std::string& kernel);
+  ~CPUDeviceCode();
+  bool Compile(bool include_path = false) override;
+  void Launch(const size_t n, std::vector<void*>* args) const override;
+
+  static void CheckAvailableStatus();
+  static bool IsAvailable() { return available_; }
+
+ private:
+  using KernelFunc = void (*)(int, void**);
+
+  static bool available_;
+
+  bool is_compiled_{false};
+  void* handle_{nullptr};
+  KernelFunc function_{nullptr};
+};
+
 class DeviceCodePool {
  public:
   using DeviceCodeMap =
@@ -107,6 +134,8 @@ class DeviceCodePool {
   static DeviceCodePool& Init(const std::vector<platform::Place>& places) {
     if (pool == nullptr) {
       pool = new DeviceCodePool(places);
+    } else {
+      pool->AddPlaces(places);
     }
     return *pool;
   }
@@ -125,6 +154,8 @@ class DeviceCodePool {
   }
 
  private:
+  void AddPlaces(const std::vector<platform::Place>& places);
+
   static DeviceCodePool* pool;
   std::map<Place, DeviceCodeMap> device_codes_;
   DISABLE_COPY_AND_ASSIGN(DeviceCodePool);
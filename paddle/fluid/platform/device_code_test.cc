@@ -125,3 +125,49 @@ TEST(DeviceCodePool, cuda) {
   LOG(INFO) << "get ptr: " << code_get;
 }
 #endif
+
+constexpr auto saxpy_cpu_code = R"(
+extern "C" void saxpy_cpu_kernel(int n, void** args) {
+  float a = *static_cast<float*>(args[0]);
+  const float* x = *static_cast<float**>(args[1]);
+  const float* y = *static_cast<float**>(args[2]);
+  float* z = *static_cast<float**>(args[3]);
+  for (int i = 0; i < n; ++i) {
+    z[i] = a * x[i] + y[i];
+  }
+}
+)";
+
+TEST(DeviceCode, cpu) {
+  paddle::platform::CPUPlace place;
+  paddle::platform::DeviceCodePool& pool =
+      paddle::platform::DeviceCodePool::Init({place});
+  if (!paddle::platform::CPUDeviceCode::IsAvailable()) {
+    return;
+  }
+
+  std::unique_ptr<paddle::platform::DeviceCode> code(
+      new paddle::platform::CPUDeviceCode(
+          place, "saxpy_cpu_kernel", saxpy_cpu_code));
+  EXPECT_EQ(code->Compile(), true);
+
+  size_t n = 1000;
+  float scale = 2;
+  std::vector<float> x(n), y(n, 0.5), z(n);
+  for (size_t i = 0; i < n; ++i) {
+    x[i] = static_cast<float>(i);
+  }
+  float* x_data = x.data();
+  float* y_data = y.data();
+  float* z_data = z.data();
+  std::vector<void*> args = {&n, &scale, &x_data, &y_data, &z_data};
+  code->Launch(n, &args);
+  for (size_t i = 0; i < n; i++) {
+    EXPECT_EQ(z[i], static_cast<float>(i) * scale + 0.5);
+  }
+
+  size_t num_device_codes_before = pool.size(place);
+  pool.Set(std::move(code));
+  EXPECT_EQ(pool.size(place), num_device_codes_before + 1);
+  EXPECT_NE(pool.Get(place, "saxpy_cpu_kernel"), nullptr);
+}
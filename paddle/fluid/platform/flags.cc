@@ -339,6 +339,20 @@ PADDLE_DEFINE_EXPORTED_bool(
     true,
     "gradient sent to the server is the sum of the gradients "
     "calculated by each thread if optimizer is sgd");
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_communicator_merge_sparse_grad
+ * Since Version: 2.4.0
+ * Value Range: bool, default=true
+ * Example:
+ * Note: Merge the gradients of duplicate feasigns in one batch before
+ *       pushing them to the sparse table, so that each key is sent once
+ *       per push and the server applies one update for it.
+ */
+PADDLE_DEFINE_EXPORTED_bool(
+    communicator_merge_sparse_grad,
+    true,
+    "merge gradients of duplicate keys before push sparse in communicator");
 /**
  * Distributed related FLAG
  * Name: FLAGS_communicator_send_queue_size
@@ -809,6 +823,21 @@ PADDLE_DEFINE_EXPORTED_bool(graph_load_in_parallel,
                             "It controls whether load graph node and edge with "
                             "mutli threads parallely.");
 
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_graph_load_by_range
+ * Since Version: 2.4.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: Split graph node and edge files into byte ranges that are parsed by
+ *       multi threads, then insert the parsed data shard by shard.
+ *       Only used when FLAGS_graph_load_in_parallel is not set.
+ */
+PADDLE_DEFINE_EXPORTED_bool(graph_load_by_range,
+                            false,
+                            "It controls whether split graph files into byte "
+                            "ranges and parse them with multi threads.");
+
 /**
  * Distributed related FLAG
  * Name: FLAGS_graph_get_neighbor_id
@@ -932,6 +961,10 @@ DEFINE_bool(enable_slotrecord_reset_shrink,
 DEFINE_bool(enable_ins_parser_file,
             false,
             "enable parser ins file, default false");
+DEFINE_int32(dataset_shuffle_window_size,
+             0,
+             "shuffle dataset records in windows of this size to bound the "
+             "extra memory, default 0 shuffles all records at once");
 PADDLE_DEFINE_EXPORTED_bool(
     gpugraph_enable_hbm_table_collision_stat,
     false,
@@ -971,6 +1004,89 @@ PADDLE_DEFINE_EXPORTED_bool(gpugraph_load_node_list_into_hbm,
 PADDLE_DEFINE_EXPORTED_bool(nccl_blocking_wait, false, "nccl blocking wait");
 #endif
 
+/**
+ * Fusion group related FLAG
+ * Name: FLAGS_fusion_group_cpu_compiler
+ * Since Version: 2.4.0
+ * Value Range: string, default=c++
+ * Example: FLAGS_fusion_group_cpu_compiler=/usr/bin/g++
+ * Note: The host compiler used to build the CPU kernels of fusion_group.
+ */
+#if !defined(_WIN32) && !defined(__APPLE__)
+PADDLE_DEFINE_EXPORTED_string(
+    fusion_group_cpu_compiler,
+    "c++",
+    "The host compiler used to build the CPU kernels of fusion_group.");
+
+/**
+ * Fusion group related FLAG
+ * Name: FLAGS_fusion_group_cpu_compile_options
+ * Since Version: 2.4.0
+ * Value Range: string, default=-O3 -march=native -fno-math-errno -fopenmp-simd
+ *              (and -lmvec on x86_64)
+ * Example:
+ * Note: Options passed to FLAGS_fusion_group_cpu_compiler. The kernels are
+ *       built on the machine they run on, so they target its instruction set.
+ *       libmvec provides the vectorized exp and log the kernels call.
+ */
+#ifdef __x86_64__
+#define FUSION_GROUP_CPU_LIBS " -lmvec"
+#else
+#define FUSION_GROUP_CPU_LIBS ""
+#endif
+PADDLE_DEFINE_EXPORTED_string(
+    fusion_group_cpu_compile_options,
+    "-O3 -march=native -fno-math-errno -fopenmp-simd" FUSION_GROUP_CPU_LIBS,
+    "Options passed to the compiler of the CPU kernels of fusion_group.");
+#undef FUSION_GROUP_CPU_LIBS
+#endif
+
+/**
+ * ProcessGroupGloo related FLAG
+ * Name: gloo_allreduce_ring_min_bytes
+ * Since Version: 2.4.0
+ * Value Range: int64, default=262144
+ * Example:
+ * Note: Allreduce of fewer bytes uses the bcube (recursive halving-doubling)
+ * algorithm of gloo if the group size is a power of two, larger allreduce
+ * uses the ring algorithm.
+ */
+#ifdef PADDLE_WITH_GLOO
+PADDLE_DEFINE_EXPORTED_int64(gloo_allreduce_ring_min_bytes,
+                             256 * 1024,
+                             "Allreduce of fewer bytes uses the bcube "
+                             "algorithm of gloo instead of ring.");
+#endif
+
+/**
+ * Operators/jit related FLAG
+ * Name: FLAGS_jit_kernel_autotune
+ * Since Version: 2.4.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_jit_kernel_autotune=true
+ * Note: If True, the first time a jit kernel is asked for with a new attr,
+ * every usable implementation (jitcode, more, refer) is timed and the fastest
+ * one is kept, instead of the first one in the fixed search order.
+ */
+PADDLE_DEFINE_EXPORTED_bool(jit_kernel_autotune,
+                            false,
+                            "Pick the jit kernel implementation by timing "
+                            "the candidates instead of the search order.");
+
+/**
+ * Operators/jit related FLAG
+ * Name: FLAGS_jit_kernel_autotune_cache_file
+ * Since Version: 2.4.0
+ * Value Range: string, default=empty
+ * Example: FLAGS_jit_kernel_autotune_cache_file=/tmp/jit_autotune.txt
+ * Note: File the choices of FLAGS_jit_kernel_autotune are read from at start
+ * and appended to, so later runs skip the timing. Empty keeps them in memory.
+ */
+PADDLE_DEFINE_EXPORTED_string(jit_kernel_autotune_cache_file,
+                              "",
+                              "File to load and save the jit kernel "
+                              "autotune choices.");
+
 /**
  * Autotune related FLAG
  * Name: FLAGS_use_autotune
@@ -21,6 +21,7 @@
 
 namespace py = pybind11;
 using paddle::framework::CostData;
+using paddle::framework::CostDecisions;
 using paddle::framework::CostModel;
 using paddle::framework::ProgramDesc;
 
@@ -53,7 +54,36 @@ void BindCostModel(py::module* m) {
                                         *startup_program_desc,
                                         device,
                                         fetch_cost_list);
-           });
+           })
+      .def("calibrate",
+           [](CostModel& self,
+              py::object py_main_program,
+              py::object py_startup_program,
+              const std::string& device,
+              const std::vector<std::string>& fuse_passes,
+              int repeat) {
+             ProgramDesc* main_program_desc =
+                 py_main_program.attr("desc").cast<ProgramDesc*>();
+             ProgramDesc* startup_program_desc =
+                 py_startup_program.attr("desc").cast<ProgramDesc*>();
+             return self.Calibrate(*main_program_desc,
+                                   *startup_program_desc,
+                                   device,
+                                   fuse_passes,
+                                   repeat);
+           },
+           py::arg("main_program"),
+           py::arg("startup_program"),
+           py::arg("device"),
+           py::arg("fuse_passes"),
+           py::arg("repeat") = 10);
+
+  py::class_<CostDecisions>(*m, "CostDecisions")
+      .def(py::init<>())
+      .def("disabled_passes", &CostDecisions::disabled_passes)
+      .def("native_kernel_op_types", &CostDecisions::native_kernel_op_types)
+      .def("save", &CostDecisions::Save)
+      .def("load", &CostDecisions::Load);
 }
 
 }  // namespace pybind
@@ -63,7 +63,58 @@ void BindTCPStore(py::module *m) {
                py::call_guard<py::gil_scoped_release>())
           .def("wait",
                &distributed::Store::wait,
-               py::call_guard<py::gil_scoped_release>());
+               py::call_guard<py::gil_scoped_release>())
+          .def(
+              "multi_set",
+              [](distributed::Store &self,
+                 const std::vector<std::string> &keys,
+                 const std::vector<std::string> &values) {
+                std::vector<std::vector<uint8_t>> data;
+                for (auto &value : values) {
+                  data.emplace_back(value.begin(), value.end());
+                }
+                self.multi_set(keys, data);
+              },
+              py::arg("keys"),
+              py::arg("values"),
+              py::call_guard<py::gil_scoped_release>())
+          .def(
+              "multi_get",
+              [](distributed::Store &self,
+                 const std::vector<std::string> &keys) -> py::list {
+                std::vector<std::vector<uint8_t>> data;
+                {
+                  py::gil_scoped_release release;
+                  data = self.multi_get(keys);
+                }
+                py::list values;
+                for (auto &value : data) {
+                  values.append(py::bytes(
+                      reinterpret_cast<char *>(value.data()), value.size()));
+                }
+                return values;
+              },
+              py::arg("keys"))
+          .def(
+              "compare_set",
+              [](distributed::Store &self,
+                 const std::string &key,
+                 const std::string &expected,
+                 const std::string &desired) -> py::bytes {
+                std::vector<uint8_t> data;
+                {
+                  py::gil_scoped_release release;
+                  data = self.compare_set(
+                      key,
+                      std::vector<uint8_t>(expected.begin(), expected.end()),
+                      std::vector<uint8_t>(desired.begin(), desired.end()));
+                }
+                return py::bytes(reinterpret_cast<char *>(data.data()),
+                                 data.size());
+              },
+              py::arg("key"),
+              py::arg("expected"),
+              py::arg("desired"));
 
   py::class_<TCPStore, std::shared_ptr<TCPStore>>(*m, "TCPStore", Store)
       .def(py::init([](std::string hostname,
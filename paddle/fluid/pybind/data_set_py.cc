@@ -281,6 +281,12 @@ void BindDataset(py::module *m) {
       .def("release_memory",
            &framework::Dataset::ReleaseMemory,
            py::call_guard<py::gil_scoped_release>())
+      .def("save_into_binary_cache",
+           &framework::Dataset::SaveIntoBinaryCache,
+           py::call_guard<py::gil_scoped_release>())
+      .def("load_from_binary_cache",
+           &framework::Dataset::LoadFromBinaryCache,
+           py::call_guard<py::gil_scoped_release>())
       .def("local_shuffle",
            &framework::Dataset::LocalShuffle,
            py::call_guard<py::gil_scoped_release>())
@@ -188,6 +188,48 @@ KernelResult KernelFactory::SelectKernelOrThrowError(
   return {kernel_iter->second, false};
 }
 
+KernelResult KernelDispatchCache::SelectKernelOrThrowError(
+    const KernelKey& kernel_key, bool use_gpudnn) {
+  if (Hit(kernel_key, use_gpudnn)) {
+    return {*kernel_, false};
+  }
+  auto& factory = KernelFactory::Instance();
+  uint64_t epoch = factory.epoch();
+  auto result =
+      factory.SelectKernelOrThrowError(kernel_name_, kernel_key, use_gpudnn);
+  // a fallback depends on FLAGS_enable_api_kernel_fallback, select it again
+  // on every call
+  if (result.has_fallback_cpu) {
+    kernel_ = nullptr;
+    return result;
+  }
+  kernel_key_ = kernel_key;
+  use_gpudnn_ = use_gpudnn;
+  epoch_ = epoch;
+  kernel_ = &result.kernel;
+  return result;
+}
+
+const Kernel& KernelDispatchCache::SelectKernel(const KernelKey& kernel_key) {
+  // SelectKernel never looks for a GPUDNN kernel, unlike
+  // SelectKernelOrThrowError with use_gpudnn
+  if (Hit(kernel_key, false)) {
+    return *kernel_;
+  }
+  auto& factory = KernelFactory::Instance();
+  uint64_t epoch = factory.epoch();
+  const Kernel& kernel = factory.SelectKernel(kernel_name_, kernel_key);
+  if (!kernel.IsValid()) {
+    kernel_ = nullptr;
+    return kernel;
+  }
+  kernel_key_ = kernel_key;
+  use_gpudnn_ = false;
+  epoch_ = epoch;
+  kernel_ = &kernel;
+  return kernel;
+}
+
 const KernelArgsDef& KernelFactory::GetFirstKernelArgsDef(
     const std::string& kernel_name) const {
   auto iter = kernels_.find(kernel_name);
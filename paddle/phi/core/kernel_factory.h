@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <ostream>
 #include <string>
 #include <unordered_map>
@@ -270,7 +271,14 @@ class KernelFactory {
  public:
   static KernelFactory& Instance();
 
-  KernelNameMap& kernels() { return kernels_; }
+  // Handing out the map for writing invalidates the KernelDispatchCaches.
+  KernelNameMap& kernels() {
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+    return kernels_;
+  }
+
+  // Changes whenever the registered kernels may have changed.
+  uint64_t epoch() const { return epoch_.load(std::memory_order_acquire); }
 
   bool HasCompatiblePhiKernel(const std::string& op_type) const;
 
@@ -293,6 +301,37 @@ class KernelFactory {
   KernelFactory() = default;
 
   KernelNameMap kernels_;
+  std::atomic<uint64_t> epoch_{0};
+};
+
+/**
+ * Note: The kernel a call site selected last, so that a call with the same
+ *       key skips the name and key lookups in KernelFactory. It is not
+ *       thread safe, keep one per call site and thread, e.g. as a function
+ *       local `static thread_local`.
+ */
+class KernelDispatchCache {
+ public:
+  explicit KernelDispatchCache(const std::string& kernel_name)
+      : kernel_name_(kernel_name) {}
+
+  KernelResult SelectKernelOrThrowError(const KernelKey& kernel_key,
+                                        bool use_gpudnn = false);
+
+  const Kernel& SelectKernel(const KernelKey& kernel_key);
+
+ private:
+  bool Hit(const KernelKey& kernel_key, bool use_gpudnn) const {
+    return kernel_ != nullptr && kernel_key == kernel_key_ &&
+           use_gpudnn == use_gpudnn_ &&
+           epoch_ == KernelFactory::Instance().epoch();
+  }
+
+  std::string kernel_name_;
+  KernelKey kernel_key_;
+  bool use_gpudnn_{false};
+  uint64_t epoch_{0};
+  const Kernel* kernel_{nullptr};
 };
 
 inline std::ostream& operator<<(std::ostream& os, const KernelKey& kernel_key) {
@@ -20,6 +20,7 @@ limitations under the License. */
 #include "paddle/phi/core/dense_tensor.h"
 #include "paddle/phi/core/kernel_factory.h"
 #include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/tests/core/timer.h"
 
 PD_DECLARE_KERNEL(scale, CPU, ALL_LAYOUT);
 
@@ -133,6 +134,63 @@ TEST(AttributeType, OStream) {
   oss.str("");
 }
 
+TEST(KernelDispatchCache, SelectKernel) {
+  auto& factory = phi::KernelFactory::Instance();
+  phi::KernelKey key(
+      phi::Backend::CPU, phi::DataLayout::NCHW, phi::DataType::FLOAT32);
+  phi::KernelKey fp16_key(
+      phi::Backend::CPU, phi::DataLayout::NCHW, phi::DataType::FLOAT16);
+  phi::KernelDispatchCache cache("test");
+
+  const auto& kernel = cache.SelectKernelOrThrowError(key).kernel;
+  EXPECT_EQ(&kernel, &factory.SelectKernel("test", key));
+  EXPECT_EQ(&cache.SelectKernelOrThrowError(key).kernel, &kernel);
+  EXPECT_EQ(&cache.SelectKernel(fp16_key),
+            &factory.SelectKernel("test", fp16_key));
+  EXPECT_EQ(&cache.SelectKernel(key), &kernel);
+
+  // handing out the map for writing drops the cached kernel
+  uint64_t epoch = factory.epoch();
+  factory.kernels();
+  EXPECT_NE(factory.epoch(), epoch);
+  EXPECT_EQ(&cache.SelectKernelOrThrowError(key).kernel, &kernel);
+
+  phi::KernelDispatchCache missing_cache("test");
+  phi::KernelKey gpu_key(
+      phi::Backend::GPU, phi::DataLayout::NCHW, phi::DataType::INT8);
+  EXPECT_FALSE(missing_cache.SelectKernel(gpu_key).IsValid());
+}
+
+// The cost of selecting the kernel of a tiny op, which the eager API does on
+// every call. It is a benchmark, run it with --gtest_also_run_disabled_tests.
+TEST(KernelDispatchCache, DISABLED_DispatchCost) {
+  auto& factory = phi::KernelFactory::Instance();
+  phi::KernelKey key(
+      phi::Backend::CPU, phi::DataLayout::NCHW, phi::DataType::FLOAT32);
+  const int kRepeat = 1000000;
+  Timer timer;
+  size_t checksum = 0;
+
+  timer.tic();
+  for (int i = 0; i < kRepeat; ++i) {
+    auto result = factory.SelectKernelOrThrowError("test", key);
+    checksum += result.kernel.IsValid();
+  }
+  double map_ms = timer.toc();
+
+  timer.tic();
+  for (int i = 0; i < kRepeat; ++i) {
+    static thread_local phi::KernelDispatchCache cache("test");
+    auto result = cache.SelectKernelOrThrowError(key);
+    checksum += result.kernel.IsValid();
+  }
+  double cache_ms = timer.toc();
+
+  EXPECT_EQ(checksum, 2UL * kRepeat);
+  std::cout << "eager dispatch: " << map_ms * 1e6 / kRepeat << " ns by map, "
+            << cache_ms * 1e6 / kRepeat << " ns by cache" << std::endl;
+}
+
 }  // namespace tests
 }  // namespace phi
 
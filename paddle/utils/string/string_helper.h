@@ -19,6 +19,8 @@
 #include <stdio.h>
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <sstream>
 #include <string>
@@ -110,6 +112,119 @@ inline float* str_to_float(const char* str) {
   return (float*)const_cast<char*>(str);
 }
 
+inline bool is_space_char(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline bool is_digit_char(char c) {
+  return static_cast<unsigned char>(c - '0') < 10;
+}
+
+// Same as strtoull(str, endptr, 10) for plain decimal input, but without
+// locale lookups, other bases and overflow checks. Used by the data feeds to
+// parse feasigns.
+inline uint64_t fast_strtoull(const char* str, char** endptr) {
+  const char* p = str;
+  while (is_space_char(*p)) {
+    ++p;
+  }
+  if (*p == '+') {
+    ++p;
+  }
+  if (!is_digit_char(*p)) {
+    *endptr = const_cast<char*>(str);
+    return 0;
+  }
+  uint64_t x = 0;
+  while (is_digit_char(*p)) {
+    x = x * 10 + (*p - '0');
+    ++p;
+  }
+  *endptr = const_cast<char*>(p);
+  return x;
+}
+
+// Same as strtol(str, endptr, 10), see fast_strtoull.
+inline int64_t fast_strtol(const char* str, char** endptr) {
+  const char* p = str;
+  while (is_space_char(*p)) {
+    ++p;
+  }
+  bool neg = (*p == '-');
+  if (*p == '-' || *p == '+') {
+    ++p;
+  }
+  uint64_t x = fast_strtoull(p, endptr);
+  if (*endptr == p) {
+    *endptr = const_cast<char*>(str);
+    return 0;
+  }
+  return neg ? -static_cast<int64_t>(x) : static_cast<int64_t>(x);
+}
+
+// Same as strtof(str, endptr). Plain decimal numbers with at most 15
+// significant digits and a decimal exponent within [-22, 22] are converted
+// with one double multiply or divide, both exact in that range, so the result
+// matches strtof except for rare double rounding at float halfway points.
+// Everything else (inf, nan, hex floats, long mantissas) goes to strtof.
+inline float fast_strtof(const char* str, char** endptr) {
+  static const double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                  1e18, 1e19, 1e20, 1e21, 1e22};
+  const char* p = str;
+  while (is_space_char(*p)) {
+    ++p;
+  }
+  bool neg = (*p == '-');
+  if (*p == '-' || *p == '+') {
+    ++p;
+  }
+  uint64_t mantissa = 0;
+  int sig_digits = 0;
+  int num_digits = 0;
+  int exp10 = 0;
+  for (; is_digit_char(*p); ++p, ++num_digits) {
+    mantissa = mantissa * 10 + (*p - '0');
+    sig_digits += (mantissa != 0);
+  }
+  if (*p == '.') {
+    for (++p; is_digit_char(*p); ++p, ++num_digits) {
+      mantissa = mantissa * 10 + (*p - '0');
+      sig_digits += (mantissa != 0);
+      --exp10;
+    }
+  }
+  if (num_digits == 0 || sig_digits > 15 || *p == 'x' || *p == 'X') {
+    return std::strtof(str, endptr);
+  }
+  if (*p == 'e' || *p == 'E') {
+    const char* q = p + 1;
+    bool exp_neg = (*q == '-');
+    if (*q == '-' || *q == '+') {
+      ++q;
+    }
+    if (!is_digit_char(*q)) {
+      return std::strtof(str, endptr);
+    }
+    int e = 0;
+    for (; is_digit_char(*q); ++q) {
+      if (e < 10000) {
+        e = e * 10 + (*q - '0');
+      }
+    }
+    exp10 += exp_neg ? -e : e;
+    p = q;
+  }
+  if (exp10 < -22 || exp10 > 22) {
+    return std::strtof(str, endptr);
+  }
+  double v = static_cast<double>(mantissa);
+  v = exp10 < 0 ? v / kPow10[-exp10] : v * kPow10[exp10];
+  *endptr = const_cast<char*>(p);
+  return static_cast<float>(neg ? -v : v);
+}
+
 // checks whether the test string is a suffix of the input string.
 bool ends_with(std::string const& input, std::string const& test);
 
@@ -14,6 +14,11 @@
 
 #include "paddle/utils/string/string_helper.h"
 
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
 #include <string>
 
 #include "gtest/gtest.h"
@@ -63,3 +68,115 @@ TEST(StringHelper, JoinStringsWithConversion) {
       paddle::string::join_strings(v, ",", [](int x) { return x * x; });
   EXPECT_EQ(result, "4,9");
 }
+
+TEST(StringHelper, FastStrtoull) {
+  const char* input = " 12 +7 18446744073709551615 x";
+  char* end = const_cast<char*>(input);
+  EXPECT_EQ(paddle::string::fast_strtoull(end, &end), 12UL);
+  EXPECT_EQ(paddle::string::fast_strtoull(end, &end), 7UL);
+  EXPECT_EQ(paddle::string::fast_strtoull(end, &end), 18446744073709551615UL);
+  char* last = end;
+  EXPECT_EQ(paddle::string::fast_strtoull(end, &end), 0UL);
+  EXPECT_EQ(end, last);
+
+  const char* nums = "3 -2 x";
+  end = const_cast<char*>(nums);
+  EXPECT_EQ(paddle::string::fast_strtol(end, &end), 3);
+  EXPECT_EQ(paddle::string::fast_strtol(end, &end), -2);
+  last = end;
+  EXPECT_EQ(paddle::string::fast_strtol(end, &end), 0);
+  EXPECT_EQ(end, last);
+}
+
+TEST(StringHelper, FastStrtof) {
+  const char* inputs[] = {"0",       "-0.5",     "1.25",      " 3.",
+                          ".75",     "1e3",      "2.5E-3",    "-7e+2",
+                          "0.1",     "123456.7", "1e30",      "1e-30",
+                          "inf",     "-nan",     "3.4e38",    "1.5e",
+                          "0x1p3",   "0.000001", "12345678901234567890",
+                          "abc",     "1.0f",     "+8"};
+  for (const char* input : inputs) {
+    char* fast_end = nullptr;
+    char* libc_end = nullptr;
+    float fast = paddle::string::fast_strtof(input, &fast_end);
+    float libc = std::strtof(input, &libc_end);
+    EXPECT_EQ(fast_end, libc_end) << input;
+    if (std::isnan(libc)) {
+      EXPECT_TRUE(std::isnan(fast)) << input;
+    } else {
+      EXPECT_EQ(fast, libc) << input;
+    }
+  }
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1000.0, 1000.0);
+  char buf[64];
+  for (int i = 0; i < 10000; ++i) {
+    snprintf(buf, sizeof(buf), "%.6g", dist(rng));
+    char* end = nullptr;
+    EXPECT_EQ(paddle::string::fast_strtof(buf, &end), std::strtof(buf, nullptr))
+        << buf;
+  }
+}
+
+// Parses a synthetic MultiSlot buffer ("num v1 v2 ... num v1 ...") with the
+// libc functions and the fast ones, and reports the throughput of both. It is
+// a benchmark, run it with --gtest_also_run_disabled_tests.
+TEST(StringHelper, DISABLED_FastParseThroughput) {
+  const int kInsNum = 20000;
+  const int kSlotNum = 30;
+  std::mt19937_64 rng(0);
+  std::string data;
+  for (int i = 0; i < kInsNum; ++i) {
+    data += "1 ";
+    data += std::to_string(static_cast<float>(rng() % 1000) / 1000);
+    for (int j = 0; j < kSlotNum; ++j) {
+      int num = 1 + rng() % 5;
+      data += " " + std::to_string(num);
+      for (int k = 0; k < num; ++k) {
+        data += " " + std::to_string(rng());
+      }
+    }
+    data += "\n";
+  }
+
+  auto parse = [&](bool fast, uint64_t* checksum) {
+    const char* str = data.c_str();
+    char* end = const_cast<char*>(str);
+    uint64_t sum = 0;
+    float fsum = 0;
+    for (int i = 0; i < kInsNum; ++i) {
+      for (int j = 0; j <= kSlotNum; ++j) {
+        int num = fast ? paddle::string::fast_strtol(end, &end)
+                       : strtol(end, &end, 10);
+        for (int k = 0; k < num; ++k) {
+          if (j == 0) {
+            fsum += fast ? paddle::string::fast_strtof(end, &end)
+                         : strtof(end, &end);
+          } else {
+            sum += fast ? paddle::string::fast_strtoull(end, &end)
+                        : strtoull(end, &end, 10);
+          }
+        }
+      }
+    }
+    EXPECT_EQ(static_cast<size_t>(end - str), data.size() - 1);
+    *checksum = sum + static_cast<uint64_t>(fsum);
+  };
+
+  uint64_t libc_sum = 0, fast_sum = 0;
+  double seconds[2];
+  for (int fast = 0; fast < 2; ++fast) {
+    auto start = std::chrono::steady_clock::now();
+    parse(fast, fast ? &fast_sum : &libc_sum);
+    seconds[fast] = std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+  }
+  EXPECT_EQ(libc_sum, fast_sum);
+  for (int fast = 0; fast < 2; ++fast) {
+    std::cout << (fast ? "fast" : "libc") << " parser: "
+              << data.size() / seconds[fast] / 1e6 << " MB/s, "
+              << kInsNum / seconds[fast] << " instances/s" << std::endl;
+  }
+}
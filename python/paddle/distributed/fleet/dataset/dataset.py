@@ -1071,6 +1071,85 @@ class InMemoryDataset(DatasetBase):
         """
         self.dataset.release_memory()
 
+    def save_into_binary_cache(self, path):
+        """
+        :api_attr: Static Graph
+
+        Dump the records loaded by load_into_memory to a binary columnar cache
+        under the local directory path, one file per thread. A later job can
+        call load_from_binary_cache instead of load_into_memory to skip
+        reading and parsing the original files.
+
+        Args:
+            path(str): local directory of the cache
+
+        Returns:
+            The number of records written.
+
+        Examples:
+            .. code-block:: python
+
+                import paddle
+                paddle.enable_static()
+
+                dataset = paddle.distributed.InMemoryDataset()
+                slots = ["slot1", "slot2", "slot3", "slot4"]
+                slots_vars = []
+                for slot in slots:
+                    var = paddle.static.data(
+                        name=slot, shape=[None, 1], dtype="int64", lod_level=1)
+                    slots_vars.append(var)
+                dataset.init(
+                    batch_size=1,
+                    thread_num=2,
+                    input_type=1,
+                    pipe_command="cat",
+                    use_var=slots_vars)
+                filelist = ["a.txt", "b.txt"]
+                dataset.set_filelist(filelist)
+                dataset.load_into_memory()
+                dataset.save_into_binary_cache("./dataset_cache")
+        """
+        return self.dataset.save_into_binary_cache(path)
+
+    def load_from_binary_cache(self, path):
+        """
+        :api_attr: Static Graph
+
+        Load records from a cache written by save_into_binary_cache. The
+        cache files are mmapped and copied into records without parsing. The
+        dataset must be initialized with the same slots as the saving one.
+
+        Args:
+            path(str): local directory of the cache
+
+        Returns:
+            The number of records loaded.
+
+        Examples:
+            .. code-block:: python
+
+                import paddle
+                paddle.enable_static()
+
+                dataset = paddle.distributed.InMemoryDataset()
+                slots = ["slot1", "slot2", "slot3", "slot4"]
+                slots_vars = []
+                for slot in slots:
+                    var = paddle.static.data(
+                        name=slot, shape=[None, 1], dtype="int64", lod_level=1)
+                    slots_vars.append(var)
+                dataset.init(
+                    batch_size=1,
+                    thread_num=2,
+                    input_type=1,
+                    pipe_command="cat",
+                    use_var=slots_vars)
+                dataset.load_from_binary_cache("./dataset_cache")
+        """
+        self._prepare_to_run()
+        return self.dataset.load_from_binary_cache(path)
+
     def get_memory_data_size(self, fleet=None):
         """
         :api_attr: Static Graph
@@ -93,6 +93,26 @@ class TestProcessGroupFp32(unittest.TestCase):
 
             print("test allreduce max api ok")
 
+            # test async allreduce, several tasks in flight, a small one
+            # for halving-doubling and a large one for the ring
+            shapes = [self.shape, (1024, 1024)]
+            tensors, results = [], []
+            for shape in shapes:
+                x = np.random.random(shape).astype(self.dtype)
+                y = np.random.random(shape).astype(self.dtype)
+                tensors.append(paddle.to_tensor(x if rank == 0 else y))
+                results.append(x + y)
+            tasks = [
+                pg.allreduce(t, core.ReduceOp.SUM, sync_op=False)
+                for t in tensors
+            ]
+            for task in tasks:
+                task.wait()
+            for t, result in zip(tensors, results):
+                np.testing.assert_allclose(t.numpy(), result, rtol=1e-6)
+
+            print("test async allreduce api ok")
+
             # test broadcast
             # rank 0
             x = np.random.random(self.shape).astype(self.dtype)
@@ -290,6 +290,65 @@ class TestDataset(unittest.TestCase):
 
         temp_dir.cleanup()
 
+    def test_in_memory_dataset_binary_cache(self):
+        """
+        Testcase for InMemoryDataset saved to and loaded from binary cache.
+        """
+        temp_dir = tempfile.TemporaryDirectory()
+        filename = os.path.join(temp_dir.name,
+                                "test_in_memory_dataset_cache_a.txt")
+        cache_dir = os.path.join(temp_dir.name, "dataset_cache")
+        with open(filename, "w") as f:
+            data = "1 1 2 3 3 4 5 5 5 5 1 1\n"
+            data += "1 2 2 3 4 4 6 6 6 6 1 2\n"
+            data += "1 3 2 3 5 4 7 7 7 7 1 3\n"
+            f.write(data)
+
+        slots = ["slot1", "slot2", "slot3", "slot4"]
+        slots_vars = []
+        for slot in slots:
+            var = fluid.layers.data(name=slot,
+                                    shape=[1],
+                                    dtype="int64",
+                                    lod_level=1)
+            slots_vars.append(var)
+
+        dataset = paddle.distributed.InMemoryDataset()
+        dataset.init(batch_size=32,
+                     thread_num=2,
+                     pipe_command="cat",
+                     use_var=slots_vars)
+        dataset.set_filelist([filename])
+        dataset.load_into_memory()
+        self.assertEqual(dataset.save_into_binary_cache(cache_dir), 3)
+        self.assertEqual(dataset.get_memory_data_size(), 3)
+        dataset.release_memory()
+
+        dataset2 = paddle.distributed.InMemoryDataset()
+        dataset2.init(batch_size=32,
+                      thread_num=2,
+                      pipe_command="cat",
+                      use_var=slots_vars)
+        self.assertEqual(dataset2.load_from_binary_cache(cache_dir), 3)
+        self.assertEqual(dataset2.get_memory_data_size(), 3)
+        exe = fluid.Executor(fluid.CPUPlace())
+        exe.run(fluid.default_startup_program())
+        exe.train_from_dataset(fluid.default_main_program(), dataset2)
+        dataset2.release_memory()
+
+        # a truncated part is reported as an error
+        part = os.path.join(cache_dir, "part-00000")
+        with open(part, "rb+") as f:
+            f.truncate(40)
+        dataset3 = paddle.distributed.InMemoryDataset()
+        dataset3.init(batch_size=32,
+                      thread_num=2,
+                      pipe_command="cat",
+                      use_var=slots_vars)
+        with self.assertRaises(Exception):
+            dataset3.load_from_binary_cache(cache_dir)
+        temp_dir.cleanup()
+
     def test_in_memory_dataset_masterpatch(self):
         """
         Testcase for InMemoryDataset from create to run.